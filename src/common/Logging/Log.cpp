@@ -330,6 +330,49 @@ void Log::outCharDump(char const* str, uint32 accountId, uint64 guid, char const
     write(std::move(msg));
 }
 
+void Log::outFormatted(std::string const& filter, char const* str, va_list ap)
+{
+    char buffer[2048];
+    int len = vsnprintf(buffer, sizeof(buffer), str, ap);
+    if (len < 0)
+        return;
+
+    outMessage(filter, LOG_LEVEL_INFO, std::string(buffer, std::min<size_t>(len, sizeof(buffer) - 1)));
+}
+
+void Log::outDiff(char const* str, ...)
+{
+    if (!str || !ShouldLog("diff", LOG_LEVEL_INFO))
+        return;
+
+    va_list ap;
+    va_start(ap, str);
+    outFormatted("diff", str, ap);
+    va_end(ap);
+}
+
+void Log::outMapInfo(char const* str, ...)
+{
+    if (!str || !ShouldLog("mapinfo", LOG_LEVEL_INFO))
+        return;
+
+    va_list ap;
+    va_start(ap, str);
+    outFormatted("mapinfo", str, ap);
+    va_end(ap);
+}
+
+void Log::outFreeze(char const* str, ...)
+{
+    if (!str || !ShouldLog("freeze", LOG_LEVEL_INFO))
+        return;
+
+    va_list ap;
+    va_start(ap, str);
+    outFormatted("freeze", str, ap);
+    va_end(ap);
+}
+
 void Log::SetRealmId(uint32 id)
 {
     for (auto it = appenders.begin(); it != appenders.end(); ++it)
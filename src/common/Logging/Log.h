@@ -25,6 +25,7 @@
 #include "StringFormat.h"
 #include <memory>
 #include <unordered_map>
+#include <cstdarg>
 #include <vector>
 
 class Appender;
@@ -90,11 +91,11 @@ class TC_COMMON_API Log
         void outArena(uint8 jointype, const char * str, ...) {} // ATTR_PRINTF(3, 4);
         void OutPveEncounter(char const* str, ...) {}
         void outSpamm(const char * str, ...) {}              ATTR_PRINTF(2, 3);
-        void outDiff(const char * str, ...) {}               ATTR_PRINTF(2, 3);
+        void outDiff(const char * str, ...)                  ATTR_PRINTF(2, 3);
         void outWarden(const char * str, ...) {}              ATTR_PRINTF(2, 3);
         void outCommand(uint32 account, const char * str, ...) {} ATTR_PRINTF(3, 4);
-        void outMapInfo(const char * str, ...) {}               ATTR_PRINTF(2, 3);
-        void outFreeze(const char * str, ...) {}               ATTR_PRINTF(2, 3);
+        void outMapInfo(const char * str, ...)                  ATTR_PRINTF(2, 3);
+        void outFreeze(const char * str, ...)                  ATTR_PRINTF(2, 3);
         void outAnticheat(const char * str, ...) {}               ATTR_PRINTF(2, 3);
         void outArenaSeason(const char * str, ...) {}               ATTR_PRINTF(2, 3);
         void outTryCatch(const char * str, ...) {}               ATTR_PRINTF(2, 3);
@@ -125,6 +126,7 @@ class TC_COMMON_API Log
         void RegisterAppender(uint8 index, AppenderCreatorFn appenderCreateFn);
         void outMessage(std::string const& filter, LogLevel const level, std::string&& message);
         void outCommand(std::string&& message, std::string&& param1);
+        void outFormatted(std::string const& filter, char const* str, va_list ap);
 
         std::unordered_map<uint8, AppenderCreatorFn> appenderFactory;
         std::unordered_map<uint8, std::unique_ptr<Appender>> appenders;
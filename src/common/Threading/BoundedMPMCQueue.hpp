@@ -0,0 +1,109 @@
+#ifndef TRINITY_SHARED_BOUNDED_MPMC_QUEUE_HPP
+#define TRINITY_SHARED_BOUNDED_MPMC_QUEUE_HPP
+
+#include <atomic>
+#include <memory>
+
+#include <cstddef>
+
+namespace Trinity {
+
+// Lock-free bounded multi-producer multi-consumer ring (D. Vyukov).
+// Every cell carries a sequence number telling producers and consumers whose turn it is,
+// so push and pop are a single CAS on the position counter and never allocate.
+template <typename T>
+class BoundedMPMCQueue
+{
+    struct Cell
+    {
+        std::atomic<std::size_t> sequence;
+        T data;
+    };
+
+public:
+    // capacity is rounded up to a power of two
+    explicit BoundedMPMCQueue(std::size_t capacity)
+        : enqueuePos_(0), dequeuePos_(0)
+    {
+        std::size_t size = 2;
+        while (size < capacity)
+            size <<= 1;
+
+        mask_ = size - 1;
+        cells_.reset(new Cell[size]);
+        for (std::size_t i = 0; i < size; ++i)
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    BoundedMPMCQueue(BoundedMPMCQueue const&) = delete;
+    BoundedMPMCQueue& operator=(BoundedMPMCQueue const&) = delete;
+
+    // data is moved from only on success
+    bool try_push(T& data)
+    {
+        Cell* cell;
+        std::size_t pos = enqueuePos_.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            cell = &cells_[pos & mask_];
+            std::size_t seq = cell->sequence.load(std::memory_order_acquire);
+            std::ptrdiff_t diff = std::ptrdiff_t(seq) - std::ptrdiff_t(pos);
+            if (diff == 0)
+            {
+                if (enqueuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            }
+            else if (diff < 0)
+                return false;                               // full
+            else
+                pos = enqueuePos_.load(std::memory_order_relaxed);
+        }
+
+        cell->data = std::move(data);
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool try_pop(T& data)
+    {
+        Cell* cell;
+        std::size_t pos = dequeuePos_.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            cell = &cells_[pos & mask_];
+            std::size_t seq = cell->sequence.load(std::memory_order_acquire);
+            std::ptrdiff_t diff = std::ptrdiff_t(seq) - std::ptrdiff_t(pos + 1);
+            if (diff == 0)
+            {
+                if (dequeuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            }
+            else if (diff < 0)
+                return false;                               // empty
+            else
+                pos = dequeuePos_.load(std::memory_order_relaxed);
+        }
+
+        data = std::move(cell->data);
+        cell->sequence.store(pos + mask_ + 1, std::memory_order_release);
+        return true;
+    }
+
+    std::size_t capacity() const
+    {
+        return mask_ + 1;
+    }
+
+private:
+    std::unique_ptr<Cell[]> cells_;
+
+    std::size_t mask_;
+
+    alignas(64) std::atomic<std::size_t> enqueuePos_;
+
+    alignas(64) std::atomic<std::size_t> dequeuePos_;
+};
+
+} // namespace Trinity
+
+#endif // TRINITY_SHARED_BOUNDED_MPMC_QUEUE_HPP
@@ -0,0 +1,152 @@
+#ifndef TRINITY_SHARED_INPLACE_TASK_HPP
+#define TRINITY_SHARED_INPLACE_TASK_HPP
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace Trinity {
+
+// Move-only void() callable with inline storage.
+// Callables up to Capacity bytes are stored in place, bigger ones fall back to the heap.
+template <std::size_t Capacity>
+class InplaceTask
+{
+    enum class Operation
+    {
+        Move,
+        Destroy
+    };
+
+    typedef void (*InvokeType)(void*);
+    typedef void (*ManageType)(Operation, void*, void*);
+
+    template <typename F>
+    struct Inline
+    {
+        static void invoke(void* storage)
+        {
+            (*static_cast<F*>(storage))();
+        }
+
+        static void manage(Operation op, void* storage, void* from)
+        {
+            if (op == Operation::Move)
+                new (storage) F(std::move(*static_cast<F*>(from)));
+
+            static_cast<F*>(op == Operation::Move ? from : storage)->~F();
+        }
+    };
+
+    template <typename F>
+    struct Boxed
+    {
+        static void invoke(void* storage)
+        {
+            (**static_cast<F**>(storage))();
+        }
+
+        static void manage(Operation op, void* storage, void* from)
+        {
+            if (op == Operation::Move)
+                *static_cast<F**>(storage) = *static_cast<F**>(from);
+            else
+                delete *static_cast<F**>(storage);
+        }
+    };
+
+    template <typename F>
+    using fits_inline = std::integral_constant<bool, sizeof(F) <= Capacity &&
+        alignof(F) <= alignof(std::max_align_t) && std::is_nothrow_move_constructible<F>::value>;
+
+public:
+    InplaceTask() noexcept
+        : invoke_(nullptr), manage_(nullptr)
+    { }
+
+    template <typename F, typename = typename std::enable_if<!std::is_same<typename std::decay<F>::type, InplaceTask>::value>::type>
+    InplaceTask(F&& func)
+    {
+        typedef typename std::decay<F>::type FunctorType;
+
+        if constexpr (fits_inline<FunctorType>::value)
+        {
+            new (&storage_) FunctorType(std::forward<F>(func));
+            invoke_ = &Inline<FunctorType>::invoke;
+            manage_ = &Inline<FunctorType>::manage;
+        }
+        else
+        {
+            *reinterpret_cast<FunctorType**>(&storage_) = new FunctorType(std::forward<F>(func));
+            invoke_ = &Boxed<FunctorType>::invoke;
+            manage_ = &Boxed<FunctorType>::manage;
+        }
+    }
+
+    InplaceTask(InplaceTask&& other) noexcept
+        : invoke_(nullptr), manage_(nullptr)
+    {
+        moveFrom(other);
+    }
+
+    InplaceTask& operator=(InplaceTask&& other) noexcept
+    {
+        if (this != &other)
+        {
+            reset();
+            moveFrom(other);
+        }
+        return *this;
+    }
+
+    InplaceTask(InplaceTask const&) = delete;
+    InplaceTask& operator=(InplaceTask const&) = delete;
+
+    ~InplaceTask()
+    {
+        reset();
+    }
+
+    explicit operator bool() const
+    {
+        return invoke_ != nullptr;
+    }
+
+    void operator()()
+    {
+        invoke_(&storage_);
+    }
+
+    void reset()
+    {
+        if (manage_)
+            manage_(Operation::Destroy, &storage_, nullptr);
+
+        invoke_ = nullptr;
+        manage_ = nullptr;
+    }
+
+private:
+    void moveFrom(InplaceTask& other)
+    {
+        if (!other.manage_)
+            return;
+
+        other.manage_(Operation::Move, &storage_, &other.storage_);
+        invoke_ = other.invoke_;
+        manage_ = other.manage_;
+        other.invoke_ = nullptr;
+        other.manage_ = nullptr;
+    }
+
+    typename std::aligned_storage<Capacity, alignof(std::max_align_t)>::type storage_;
+
+    InvokeType invoke_;
+
+    ManageType manage_;
+};
+
+} // namespace Trinity
+
+#endif // TRINITY_SHARED_INPLACE_TASK_HPP
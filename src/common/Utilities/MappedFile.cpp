@@ -0,0 +1,66 @@
+/*
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MappedFile.h"
+#include <boost/interprocess/exceptions.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+MappedFile::MappedFile() = default;
+
+MappedFile::~MappedFile() = default;
+
+bool MappedFile::Open(std::string const& fileName, uint64 offset /*= 0*/, std::size_t size /*= 0*/)
+{
+    Close();
+
+    try
+    {
+        boost::interprocess::file_mapping file(fileName.c_str(), boost::interprocess::read_only);
+        _region.reset(new boost::interprocess::mapped_region(file, boost::interprocess::copy_on_write, offset, size));
+    }
+    catch (boost::interprocess::interprocess_exception const&)
+    {
+        _region.reset();
+        return false;
+    }
+
+    return true;
+}
+
+void MappedFile::Close()
+{
+    _region.reset();
+}
+
+uint8* MappedFile::GetData() const
+{
+    return _region ? static_cast<uint8*>(_region->get_address()) : nullptr;
+}
+
+std::size_t MappedFile::GetSize() const
+{
+    return _region ? _region->get_size() : 0;
+}
+
+bool MappedFile::Contains(void const* ptr) const
+{
+    if (!_region || !ptr)
+        return false;
+
+    uint8 const* begin = GetData();
+    uint8 const* p = static_cast<uint8 const*>(ptr);
+    return p >= begin && p < begin + GetSize();
+}
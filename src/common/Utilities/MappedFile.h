@@ -0,0 +1,59 @@
+/*
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_MAPPED_FILE_H
+#define TRINITY_MAPPED_FILE_H
+
+#include "Define.h"
+#include <memory>
+#include <string>
+
+namespace boost
+{
+    namespace interprocess
+    {
+        class mapped_region;
+    }
+}
+
+/*
+ * Read only data file mapped into memory.
+ *
+ * The mapping is private (copy on write): pages that are only read stay shared with the OS page cache
+ * and with every other process mapping the same file, pages written to become private copies.
+ */
+class TC_COMMON_API MappedFile
+{
+public:
+    MappedFile();
+    ~MappedFile();
+
+    MappedFile(MappedFile const&) = delete;
+    MappedFile& operator=(MappedFile const&) = delete;
+
+    // Maps size bytes starting at offset, size 0 maps up to the end of the file
+    bool Open(std::string const& fileName, uint64 offset = 0, std::size_t size = 0);
+    void Close();
+
+    bool IsOpen() const { return _region != nullptr; }
+    uint8* GetData() const;
+    std::size_t GetSize() const;
+    bool Contains(void const* ptr) const;
+
+private:
+    std::unique_ptr<boost::interprocess::mapped_region> _region;
+};
+
+#endif
@@ -27,6 +27,11 @@ MessageBuffer::MessageBuffer(std::size_t initialSize): _wpos(0), _rpos(0), _stor
     _storage.resize(initialSize);
 }
 
+MessageBuffer::MessageBuffer(std::vector<uint8>&& storage): _wpos(0), _rpos(0), _storage(std::move(storage))
+{
+    _storage.clear();
+}
+
 MessageBuffer::MessageBuffer(MessageBuffer const& right): _wpos(right._wpos), _rpos(right._rpos), _storage(right._storage)
 {
 }
@@ -86,6 +91,11 @@ MessageBuffer::size_type MessageBuffer::GetBufferSize() const
     return _storage.size();
 }
 
+MessageBuffer::size_type MessageBuffer::GetCapacity() const
+{
+    return _storage.capacity();
+}
+
 void MessageBuffer::Normalize()
 {
     if (_rpos)
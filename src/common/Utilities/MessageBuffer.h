@@ -28,6 +28,8 @@ class MessageBuffer
 public:
     MessageBuffer();
     explicit MessageBuffer(std::size_t initialSize);
+    // Takes over storage of a recycled buffer, its capacity is kept and nothing is active
+    explicit MessageBuffer(std::vector<uint8>&& storage);
     MessageBuffer(MessageBuffer const& right);
     MessageBuffer(MessageBuffer&& right) noexcept;
 
@@ -44,6 +46,7 @@ public:
     size_type GetActiveSize() const;
     size_type GetRemainingSpace() const;
     size_type GetBufferSize() const;
+    size_type GetCapacity() const;
 
     // Discards inactive data
     void Normalize();
@@ -23,6 +23,7 @@
 #include <G3D/Table.h>
 #include <G3D/Array.h>
 #include <G3D/Set.h>
+#include <memory>
 
 typedef std::lock_guard<std::recursive_mutex> RecursiveGuard;
 
@@ -60,12 +61,36 @@ class BIHWrap
 
     typedef G3D::Array<const T*> ObjArray;
 
+public:
+    /// Immutable balanced copy of the wrapper; never rebuilt after creation, so any number of threads may query it
+    struct Snapshot
+    {
+        BIH tree;
+        std::vector<const T*> objects;
+
+        template<typename RayCallback>
+        void intersectRay(const G3D::Ray& ray, RayCallback& intersectCallback, float& maxDist) const
+        {
+            MDLCallback<RayCallback> temp_cb(intersectCallback, objects.data(), uint32(objects.size()));
+            tree.intersectRay(ray, temp_cb, maxDist, true);
+        }
+
+        template<typename IsectCallback>
+        void intersectPoint(const G3D::Vector3& point, IsectCallback& intersectCallback) const
+        {
+            MDLCallback<IsectCallback> callback(intersectCallback, objects.data(), uint32(objects.size()));
+            tree.intersectPoint(point, callback);
+        }
+    };
+
+private:
     BIH m_tree;
     ObjArray m_objects;
     G3D::Table<const T*, uint32> m_obj2Idx;
     G3D::Set<const T*> m_objects_to_push;
     int unbalanced_times;
     std::recursive_mutex balance_lock;
+    std::shared_ptr<Snapshot const> m_snapshot;
 
 public:
     BIHWrap() : unbalanced_times(0) { }
@@ -73,12 +98,14 @@ public:
     void insert(const T& obj)
     {
         ++unbalanced_times;
+        m_snapshot.reset();
         m_objects_to_push.insert(&obj);
     }
 
     void remove(const T& obj)
     {
         ++unbalanced_times;
+        m_snapshot.reset();
         uint32 Idx = 0;
         const T * temp;
         if (m_obj2Idx.getRemove(&obj, temp, Idx))
@@ -102,6 +129,21 @@ public:
         m_tree.build(m_objects, BoundsFunc::getBounds2);
     }
 
+    /// Balances and returns an immutable copy of the current contents, nullptr when empty.
+    /// The copy is cached and shared until the next insert or remove.
+    std::shared_ptr<Snapshot const> snapshot()
+    {
+        balance();
+        if (!m_snapshot && m_objects.size())
+        {
+            std::shared_ptr<Snapshot> snapshot = std::make_shared<Snapshot>();
+            snapshot->tree = m_tree;
+            snapshot->objects.assign(m_objects.getCArray(), m_objects.getCArray() + m_objects.size());
+            m_snapshot = std::move(snapshot);
+        }
+        return m_snapshot;
+    }
+
     template<typename RayCallback>
     void intersectRay(const G3D::Ray& ray, RayCallback& intersectCallback, float& maxDist)
     {
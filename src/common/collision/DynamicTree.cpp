@@ -23,19 +23,13 @@
 #include "MapTree.h"
 #include "ModelInstance.h"
 #include "RegularGrid.h"
-#include "Timer.h"
 #include <G3D/AABox.h>
 #include <G3D/Ray.h>
 #include <G3D/Vector3.h>
+#include <atomic>
 
 using VMAP::ModelInstance;
 
-namespace {
-
-int CHECK_TREE_PERIOD = 200;
-
-} // namespace
-
 template<> struct HashTrait< GameObjectModel>{
     static size_t hashCode(const GameObjectModel& g) { return (size_t)(void*)&g; }
 };
@@ -55,6 +49,30 @@ static bool operator == (const GameObjectModel& mdl, const GameObjectModel& mdl2
 }
 */
 
+typedef BIHWrap<GameObjectModel>::Snapshot CellSnapshot;
+
+// Grid node of a published snapshot; unchanged cells share their CellSnapshot with the previous publish
+struct DynTreeSnapshotNode
+{
+    std::shared_ptr<CellSnapshot const> cell;
+
+    template<typename RayCallback>
+    void intersectRay(const G3D::Ray& ray, RayCallback& intersectCallback, float& maxDist) const
+    {
+        cell->intersectRay(ray, intersectCallback, maxDist);
+    }
+
+    template<typename IsectCallback>
+    void intersectPoint(const G3D::Vector3& point, IsectCallback& intersectCallback) const
+    {
+        cell->intersectPoint(point, intersectCallback);
+    }
+};
+
+struct DynTreeSnapshot : public RegularGrid2D<GameObjectModel, DynTreeSnapshotNode>
+{
+};
+
 typedef RegularGrid2D<GameObjectModel, BIHWrap<GameObjectModel> > ParentTree;
 
 struct DynTreeImpl : public ParentTree/*, public Intersectable*/
@@ -62,11 +80,7 @@ struct DynTreeImpl : public ParentTree/*, public Intersectable*/
     typedef GameObjectModel Model;
     typedef ParentTree base;
 
-    DynTreeImpl() :
-        rebalance_timer(CHECK_TREE_PERIOD),
-        unbalanced_times(0)
-    {
-    }
+    DynTreeImpl() : unbalanced_times(0) { }
 
     void insert(const Model& mdl)
     {
@@ -80,63 +94,91 @@ struct DynTreeImpl : public ParentTree/*, public Intersectable*/
         ++unbalanced_times;
     }
 
-    void balance()
+    // Balances every cell and collects the results into a new read-only grid
+    DynTreeSnapshot* makeSnapshot()
     {
-        base::balance();
-        unbalanced_times = 0;
-    }
+        DynTreeSnapshot* snapshot = new DynTreeSnapshot();
+        for (int x = 0; x < CELL_NUMBER; ++x)
+            for (int y = 0; y < CELL_NUMBER; ++y)
+                if (BIHWrap<Model>* node = nodes[x][y])
+                    if (std::shared_ptr<CellSnapshot const> cell = node->snapshot())
+                        snapshot->nodes[x][y] = new DynTreeSnapshotNode{ std::move(cell) };
 
-    void update(uint32 difftime)
-    {
-        if (empty())
-            return;
-
-        rebalance_timer.Update(difftime);
-        if (rebalance_timer.Passed())
-        {
-            rebalance_timer.Reset(CHECK_TREE_PERIOD);
-            if (unbalanced_times > 0)
-                balance();
-        }
+        unbalanced_times = 0;
+        return snapshot;
     }
 
-    TimeTrackerSmall rebalance_timer;
     int unbalanced_times;
 };
 
-DynamicMapTree::DynamicMapTree() : impl(new DynTreeImpl()) { }
+DynamicMapTree::DynamicMapTree() : impl(new DynTreeImpl()), _snapshot(std::make_shared<DynTreeSnapshot>()) { }
 
 DynamicMapTree::~DynamicMapTree()
 {
+    for (GameObjectModel const* mdl : _retired)
+        delete mdl;
     delete impl;
 }
 
 void DynamicMapTree::insert(const GameObjectModel& mdl)
 {
-    RecursiveGuard guard(dynamic_lock);
+    std::lock_guard<std::mutex> guard(_writeLock);
     impl->insert(mdl);
 }
 
 void DynamicMapTree::remove(const GameObjectModel& mdl)
 {
-    RecursiveGuard guard(dynamic_lock);
+    std::lock_guard<std::mutex> guard(_writeLock);
     impl->remove(mdl);
 }
 
 bool DynamicMapTree::contains(const GameObjectModel& mdl) const
 {
+    std::lock_guard<std::mutex> guard(_writeLock);
     return impl->contains(mdl);
 }
 
-void DynamicMapTree::balance()
+void DynamicMapTree::retire(GameObjectModel const* mdl)
 {
-    RecursiveGuard guard(dynamic_lock);
-    impl->balance();
+    std::lock_guard<std::mutex> guard(_writeLock);
+    _retired.push_back(mdl);
 }
 
-void DynamicMapTree::update(uint32 t_diff)
+void DynamicMapTree::publish()
 {
-    impl->update(t_diff);
+    std::atomic_store(&_snapshot, std::shared_ptr<DynTreeSnapshot>(impl->makeSnapshot()));
+}
+
+bool DynamicMapTree::balance()
+{
+    std::lock_guard<std::mutex> guard(_writeLock);
+    if (!impl->unbalanced_times)
+        return false;
+
+    publish();
+    return true;
+}
+
+// Called at the start of a map tick, while no query of this map is running. Models retired since the
+// last tick can be released once the new snapshot went out: later queries no longer see them
+bool DynamicMapTree::update(uint32 /*diff*/)
+{
+    bool published = false;
+    std::vector<GameObjectModel const*> retired;
+    {
+        std::lock_guard<std::mutex> guard(_writeLock);
+        if (impl->unbalanced_times > 0)
+        {
+            publish();
+            published = true;
+        }
+        retired.swap(_retired);
+    }
+
+    for (GameObjectModel const* mdl : retired)
+        delete mdl;
+
+    return published;
 }
 
 struct DynamicTreeIntersectionCallback
@@ -206,8 +248,8 @@ bool DynamicMapTree::getIntersectionTime(std::set<uint32> const& phases, bool ot
 {
     float distance = maxDist;
     DynamicTreeIntersectionCallback callback(phases, otherUsePlayerPhasingRules);
-    RecursiveGuard guard(dynamic_lock);
-    impl->intersectRay(ray, callback, distance, endPos);
+    std::shared_ptr<DynTreeSnapshot> snapshot = std::atomic_load(&_snapshot);
+    snapshot->intersectRay(ray, callback, distance, endPos);
     if (callback.didHit())
     {
         if (dCallback)
@@ -266,8 +308,8 @@ bool DynamicMapTree::isInLineOfSight(G3D::Vector3 const& startPos, G3D::Vector3
 
     G3D::Ray r(startPos, (endPos - startPos) / maxDist);
     DynamicTreeisInLineOfSightCallback callback(phases, otherUsePlayerPhasingRules);
-    RecursiveGuard guard(dynamic_lock);
-    impl->intersectRay(r, callback, maxDist, endPos);
+    std::shared_ptr<DynTreeSnapshot> snapshot = std::atomic_load(&_snapshot);
+    snapshot->intersectRay(r, callback, maxDist, endPos);
 
     if (callback.didHit())
         if (dCallback)
@@ -281,8 +323,8 @@ float DynamicMapTree::getHeight(float x, float y, float z, float maxSearchDist,
     G3D::Vector3 v(x, y, z + 0.5f);
     G3D::Ray r(v, G3D::Vector3(0, 0, -1));
     DynamicTreeIntersectionCallback callback(phases, otherUsePlayerPhasingRules);
-    RecursiveGuard guard(dynamic_lock);
-    impl->intersectZAllignedRay(r, callback, maxSearchDist);
+    std::shared_ptr<DynTreeSnapshot> snapshot = std::atomic_load(&_snapshot);
+    snapshot->intersectZAllignedRay(r, callback, maxSearchDist);
 
     if (callback.didHit())
     {
@@ -298,8 +340,8 @@ bool DynamicMapTree::getAreaInfo(float x, float y, float& z, std::set<uint32> co
 {
     G3D::Vector3 v(x, y, z + 0.5f);
     DynamicTreeAreaInfoCallback intersectionCallBack(phases, otherUsePlayerPhasingRules);
-    RecursiveGuard guard(dynamic_lock);
-    impl->intersectPoint(v, intersectionCallBack);
+    std::shared_ptr<DynTreeSnapshot> snapshot = std::atomic_load(&_snapshot);
+    snapshot->intersectPoint(v, intersectionCallBack);
     if (intersectionCallBack.GetAreaInfo().result)
     {
         flags = intersectionCallBack.GetAreaInfo().flags;
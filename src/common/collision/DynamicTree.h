@@ -21,8 +21,10 @@
 #define _DYNTREE_H
 
 #include "Define.h"
-#include <set>
+#include <memory>
 #include <mutex>
+#include <set>
+#include <vector>
 
 namespace G3D
 {
@@ -32,6 +34,7 @@ namespace G3D
 
 class GameObjectModel;
 struct DynTreeImpl;
+struct DynTreeSnapshot;
 class GameObject;
 
 struct DynamicTreeCallback
@@ -41,9 +44,25 @@ struct DynamicTreeCallback
 
 typedef std::lock_guard<std::recursive_mutex> RecursiveGuard;
 
+/*
+ * Collision tree for gameobject models of one map.
+ *
+ * insert/remove/balance modify a writer copy under _writeLock. Queries never lock: they read the
+ * immutable snapshot last published by balance() or update(), so changes become visible to them on
+ * the next map tick (or the next explicit balance, e.g. after a grid load).
+ * Because a published snapshot may still reference a model after it was removed, every model that
+ * leaves the tree while the map is alive must be handed to retire() instead of being deleted. Its
+ * collision must be disabled first so that queries walking an older snapshot skip it without
+ * touching its owner, which may already be deleted.
+ */
 class DynamicMapTree
 {
     DynTreeImpl *impl;
+    std::shared_ptr<DynTreeSnapshot> _snapshot;     // accessed through std::atomic_load/std::atomic_store
+    std::vector<GameObjectModel const*> _retired;
+    mutable std::mutex _writeLock;
+
+    void publish();
 
 public:
 
@@ -60,10 +79,11 @@ public:
     void insert(const GameObjectModel&);
     void remove(const GameObjectModel&);
     bool contains(const GameObjectModel&) const;
+    void retire(GameObjectModel const* mdl);
 
-    void balance();
-    void update(uint32 diff);
-    mutable std::recursive_mutex dynamic_lock;
+    // both return true when a new snapshot was published
+    bool balance();
+    bool update(uint32 diff);
 };
 
 #endif // _DYNTREE_H
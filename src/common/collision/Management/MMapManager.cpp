@@ -154,6 +154,14 @@ namespace MMAP
 
         // load this tile :: mmaps/MMMMXXYY.mmtile
         std::string fileName = Trinity::StringFormat(TILE_FILE_NAME_FORMAT, basePath.c_str(), mapId, x, y);
+        if (memoryMappedTiles)
+        {
+            // a file that can't be mapped is still read the usual way
+            std::unique_ptr<MappedFile> mapping(new MappedFile());
+            if (mapping->Open(fileName))
+                return loadMappedTile(mmap, std::move(mapping), mapId, x, y);
+        }
+
         FILE* file = fopen(fileName.c_str(), "rb");
         // if (!file)
         // {
@@ -236,6 +244,55 @@ namespace MMAP
         }
     }
 
+    // Detour links the tile in place, so the mapping is copy on write: only the pages it patches stop being shared
+    bool MMapManager::loadMappedTile(MMapData* mmap, std::unique_ptr<MappedFile> mapping, uint32 mapId, int32 x, int32 y)
+    {
+        MmapTileHeader fileHeader;
+        if (mapping->GetSize() < sizeof(MmapTileHeader))
+        {
+            TC_LOG_DEBUG("maps", "MMAP:loadMap: Bad header in mmap %04u%02i%02i.mmtile", mapId, x, y);
+            return false;
+        }
+
+        memcpy(&fileHeader, mapping->GetData(), sizeof(MmapTileHeader));
+        if (fileHeader.mmapMagic != MMAP_MAGIC)
+        {
+            TC_LOG_DEBUG("maps", "MMAP:loadMap: Bad header in mmap %04u%02i%02i.mmtile", mapId, x, y);
+            return false;
+        }
+
+        if (fileHeader.mmapVersion != MMAP_VERSION)
+        {
+            TC_LOG_DEBUG("maps", "MMAP:loadMap: %04u%02i%02i.mmtile was built with generator v%i, expected v%i",
+                mapId, x, y, fileHeader.mmapVersion, MMAP_VERSION);
+            return false;
+        }
+
+        if (!fileHeader.size || fileHeader.size > mapping->GetSize() - sizeof(MmapTileHeader))
+        {
+            TC_LOG_DEBUG("maps", "MMAP:loadMap: %04u%02i%02i.mmtile has corrupted data size", mapId, x, y);
+            return false;
+        }
+
+        unsigned char* data = mapping->GetData() + sizeof(MmapTileHeader);
+        dtMeshHeader* header = (dtMeshHeader*)data;
+        dtTileRef tileRef = 0;
+
+        // no DT_TILE_FREE_DATA, the data belongs to the mapping which lives until the tile is removed
+        if (dtStatusFailed(mmap->navMesh->addTile(data, fileHeader.size, 0, 0, &tileRef)))
+        {
+            TC_LOG_DEBUG("maps", "MMAP:loadMap: Could not load %04u%02i%02i.mmtile into navmesh", mapId, x, y);
+            return false;
+        }
+
+        uint32 packedGridPos = packTileID(x, y);
+        mmap->loadedTileRefs.insert(std::pair<uint32, dtTileRef>(packedGridPos, tileRef));
+        mmap->mappedTiles[packedGridPos] = std::move(mapping);
+        ++loadedTiles;
+        TC_LOG_DEBUG("maps", "MMAP:loadMap: Loaded mapped mmtile %04i[%02i, %02i] into %04i[%02i, %02i]", mapId, x, y, mapId, header->x, header->y);
+        return true;
+    }
+
     bool MMapManager::loadMapInstance(std::string const& basePath, uint32 mapId, uint64 instanceId)
     {
         if (!loadMapInstanceImpl(basePath, mapId, instanceId))
@@ -321,6 +378,7 @@ namespace MMAP
         else
         {
             mmap->loadedTileRefs.erase(tileRefItr);
+            mmap->mappedTiles.erase(packedGridPos);
             --loadedTiles;
             TC_LOG_DEBUG("maps", "MMAP:unloadMap: Unloaded mmtile %04i[%02i, %02i] from %03i", mapId, x, y, mapId);
             return true;
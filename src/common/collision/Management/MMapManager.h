@@ -22,6 +22,9 @@
 #include "Define.h"
 #include "DetourNavMesh.h"
 #include "DetourNavMeshQuery.h"
+#include "MappedFile.h"
+#include <atomic>
+#include <memory>
 #include <string>
 #include <map>
 #include <unordered_map>
@@ -56,6 +59,7 @@ namespace MMAP
 
         dtNavMesh* navMesh;
         MMapTileSet loadedTileRefs;        // maps [map grid coords] to [dtTile]
+        std::map<uint32, std::unique_ptr<MappedFile>> mappedTiles; // tiles added straight from their mapped file
         uint32 _mapId;
     };
 
@@ -67,7 +71,7 @@ namespace MMAP
     class MMapManager
     {
         public:
-            MMapManager() : loadedTiles(0), thread_safe_environment(true) {}
+            MMapManager() : loadedTiles(0), thread_safe_environment(true), memoryMappedTiles(false) {}
             ~MMapManager();
 
             void InitializeThreadUnsafe(std::unordered_map<uint32, std::vector<uint32>> const& mapData);
@@ -83,11 +87,14 @@ namespace MMAP
             dtNavMeshQuery const* GetModelNavMeshQuery(uint32 displayId, uint64 instanceId);
             dtNavMesh const* GetNavMesh(uint32 mapId);
 
+            void SetMemoryMappedTiles(bool enable) { memoryMappedTiles = enable; }
+
             uint32 getLoadedTilesCount() const { return loadedTiles; }
             uint32 getLoadedMapsCount() const { return uint32(loadedMMaps.size()); }
         private:
             bool loadMapData(std::string const& basePath, uint32 mapId);
             bool loadMapImpl(std::string const& basePath, uint32 mapId, int32 x, int32 y);
+            bool loadMappedTile(MMapData* mmap, std::unique_ptr<MappedFile> mapping, uint32 mapId, int32 x, int32 y);
             bool loadMapInstanceImpl(std::string const& basePath, uint32 mapId, uint64 instanceId);
             bool unloadMapImpl(uint32 mapId, int32 x, int32 y);
             bool unloadMapImpl(uint32 mapId);
@@ -97,6 +104,7 @@ namespace MMAP
             MMapDataSet loadedMMaps;
             uint32 loadedTiles;
             bool thread_safe_environment;
+            std::atomic<bool> memoryMappedTiles;
             MMapDataSet loadedModels;
 
             std::unordered_map<uint32, std::vector<uint32>> childMapData;
@@ -0,0 +1,175 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "DatabaseWorkQueue.h"
+#include "SQLOperation.h"
+#include <algorithm>
+
+namespace
+{
+    std::chrono::milliseconds const BulkMaxWait(1000);
+}
+
+DatabaseWorkQueue::DatabaseWorkQueue() : _statistics(), _writeSequence(0), _shutdown(false)
+{
+}
+
+DatabaseWorkQueue::~DatabaseWorkQueue()
+{
+    Cancel();
+}
+
+void DatabaseWorkQueue::Push(SQLOperation* op, SQLOperationLane lane, uint64 writeBarrier /*= 0*/)
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    if (_shutdown)
+    {
+        delete op;
+        return;
+    }
+
+    if (lane == SQL_LANE_WRITE)
+    {
+        op->m_writeSequence = ++_writeSequence;
+        _pendingWrites.insert(op->m_writeSequence);
+    }
+
+    _lanes[lane].push_back({ op, writeBarrier, Clock::now() });
+    ++_statistics[lane].Depth;
+
+    _condition.notify_one();
+}
+
+SQLOperation* DatabaseWorkQueue::WaitAndPop()
+{
+    std::unique_lock<std::mutex> lock(_lock);
+    for (;;)
+    {
+        if (_shutdown)
+            return nullptr;
+
+        if (SQLOperation* op = TryPop())
+            return op;
+
+        _condition.wait(lock);
+    }
+}
+
+SQLOperation* DatabaseWorkQueue::PopPipelinedWrite()
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    std::deque<Entry>& writes = _lanes[SQL_LANE_WRITE];
+    if (_shutdown || writes.empty() || !writes.front().Operation->IsOneWayStatement())
+        return nullptr;
+
+    // interactive work waiting for a free connection goes first
+    for (Entry const& entry : _lanes[SQL_LANE_INTERACTIVE])
+        if (CanStart(entry))
+            return nullptr;
+
+    return Take(writes, writes.begin(), SQL_LANE_WRITE);
+}
+
+void DatabaseWorkQueue::Complete(SQLOperation* op)
+{
+    if (!op->m_writeSequence)
+        return;
+
+    std::lock_guard<std::mutex> lock(_lock);
+    _pendingWrites.erase(op->m_writeSequence);
+
+    // operations behind a write barrier may have become ready
+    _condition.notify_all();
+}
+
+void DatabaseWorkQueue::Cancel()
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    for (std::deque<Entry>& queue : _lanes)
+    {
+        for (Entry& entry : queue)
+            delete entry.Operation;
+        queue.clear();
+    }
+
+    for (SQLLaneStatistics& statistics : _statistics)
+        statistics.Depth = 0;
+
+    _pendingWrites.clear();
+    _shutdown = true;
+    _condition.notify_all();
+}
+
+bool DatabaseWorkQueue::Empty() const
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    return std::all_of(_lanes.begin(), _lanes.end(), [](std::deque<Entry> const& queue) { return queue.empty(); });
+}
+
+uint64 DatabaseWorkQueue::GetWriteSequence() const
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    return _writeSequence;
+}
+
+SQLLaneStatistics DatabaseWorkQueue::GetStatistics(SQLOperationLane lane) const
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    return _statistics[lane];
+}
+
+bool DatabaseWorkQueue::CanStart(Entry const& entry) const
+{
+    return !entry.WriteBarrier || _pendingWrites.empty() || *_pendingWrites.begin() > entry.WriteBarrier;
+}
+
+SQLOperation* DatabaseWorkQueue::Take(std::deque<Entry>& queue, std::deque<Entry>::iterator itr, SQLOperationLane lane)
+{
+    SQLLaneStatistics& statistics = _statistics[lane];
+    uint64 wait = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - itr->PushTime).count();
+    --statistics.Depth;
+    ++statistics.Executed;
+    statistics.TotalWaitUs += wait;
+    statistics.MaxWaitUs = std::max(statistics.MaxWaitUs, wait);
+
+    SQLOperation* op = itr->Operation;
+    queue.erase(itr);
+    return op;
+}
+
+SQLOperation* DatabaseWorkQueue::TryPop()
+{
+    std::deque<Entry>& bulk = _lanes[SQL_LANE_BULK];
+    if (!bulk.empty() && Clock::now() - bulk.front().PushTime > BulkMaxWait && CanStart(bulk.front()))
+        return Take(bulk, bulk.begin(), SQL_LANE_BULK);
+
+    std::deque<Entry>& interactive = _lanes[SQL_LANE_INTERACTIVE];
+    for (auto itr = interactive.begin(); itr != interactive.end(); ++itr)
+        if (CanStart(*itr))
+            return Take(interactive, itr, SQL_LANE_INTERACTIVE);
+
+    // writes keep their order, the head may only wait for a barrier of its own
+    std::deque<Entry>& writes = _lanes[SQL_LANE_WRITE];
+    if (!writes.empty() && CanStart(writes.front()))
+        return Take(writes, writes.begin(), SQL_LANE_WRITE);
+
+    for (auto itr = bulk.begin(); itr != bulk.end(); ++itr)
+        if (CanStart(*itr))
+            return Take(bulk, itr, SQL_LANE_BULK);
+
+    return nullptr;
+}
@@ -0,0 +1,105 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _DATABASEWORKQUEUE_H
+#define _DATABASEWORKQUEUE_H
+
+#include "Define.h"
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <set>
+
+class SQLOperation;
+
+enum SQLOperationLane : uint8
+{
+    SQL_LANE_INTERACTIVE,                                   //! Queries a player or session waits for (login holders, async queries)
+    SQL_LANE_WRITE,                                         //! One-way statements and transactions
+    SQL_LANE_BULK,                                          //! Background work yielding to both (keep alive pings)
+
+    MAX_SQL_LANES
+};
+
+struct SQLLaneStatistics
+{
+    uint64 Depth;                                           //! Operations waiting right now
+    uint64 Executed;
+    uint64 TotalWaitUs;                                     //! Time between Push and the start of execution
+    uint64 MaxWaitUs;
+};
+
+/*! Queue shared by the async connections of a DatabaseWorkerPool.
+
+    Interactive operations are started before queued writes, writes before bulk operations.
+    Writes are always started in the order they were pushed and every write gets a sequence number:
+    an operation pushed with a write barrier isn't started before every write up to that sequence
+    completed. Bulk operations waiting longer than a second go first so a write storm can't starve them.
+*/
+class TC_DATABASE_API DatabaseWorkQueue
+{
+    typedef std::chrono::steady_clock Clock;
+
+    struct Entry
+    {
+        SQLOperation* Operation;
+        uint64 WriteBarrier;
+        Clock::time_point PushTime;
+    };
+
+public:
+    DatabaseWorkQueue();
+    ~DatabaseWorkQueue();
+
+    //! Takes ownership of op. Writes must be pushed to SQL_LANE_WRITE.
+    void Push(SQLOperation* op, SQLOperationLane lane, uint64 writeBarrier = 0);
+
+    //! Blocks until an operation can be started, nullptr once the queue was canceled.
+    SQLOperation* WaitAndPop();
+
+    //! One-way statement waiting at the head of the write lane, to be executed together with the one just popped.
+    SQLOperation* PopPipelinedWrite();
+
+    //! Must be called by the worker once op was executed, before deleting it.
+    void Complete(SQLOperation* op);
+
+    void Cancel();
+
+    bool Empty() const;
+
+    //! Sequence of the last write pushed, usable as a write barrier.
+    uint64 GetWriteSequence() const;
+
+    SQLLaneStatistics GetStatistics(SQLOperationLane lane) const;
+
+private:
+    bool CanStart(Entry const& entry) const;
+    SQLOperation* Take(std::deque<Entry>& queue, std::deque<Entry>::iterator itr, SQLOperationLane lane);
+    SQLOperation* TryPop();
+
+    mutable std::mutex _lock;
+    std::condition_variable _condition;
+    std::array<std::deque<Entry>, MAX_SQL_LANES> _lanes;
+    std::array<SQLLaneStatistics, MAX_SQL_LANES> _statistics;
+    std::set<uint64> _pendingWrites;                        //! Queued or executing
+    uint64 _writeSequence;
+    bool _shutdown;
+};
+
+#endif
@@ -16,10 +16,15 @@
  */
 
 #include "DatabaseWorker.h"
+#include "DatabaseWorkQueue.h"
+#include "Log.h"
+#include "MySQLConnection.h"
 #include "SQLOperation.h"
-#include "ProducerConsumerQueue.h"
 
-DatabaseWorker::DatabaseWorker(ProducerConsumerQueue<SQLOperation*>* newQueue, MySQLConnection* connection)
+//! Most one-way statements run back to back in one transaction, one commit instead of one per statement
+#define DATABASE_WORKER_PIPELINE_SIZE 32
+
+DatabaseWorker::DatabaseWorker(DatabaseWorkQueue* newQueue, MySQLConnection* connection)
 {
     _connection = connection;
     _queue = newQueue;
@@ -41,18 +46,105 @@ void DatabaseWorker::WorkerThread()
     if (!_queue)
         return;
 
+    std::vector<SQLOperation*> pipeline;
+    pipeline.reserve(DATABASE_WORKER_PIPELINE_SIZE);
+
     for (;;)
     {
-        SQLOperation* operation = nullptr;
-
-        _queue->WaitAndPop(operation);
+        SQLOperation* operation = _queue->WaitAndPop();
 
         if (_cancelationToken || !operation)
             return;
 
+        if (operation->IsOneWayStatement())
+        {
+            pipeline.push_back(operation);
+            while (pipeline.size() < DATABASE_WORKER_PIPELINE_SIZE)
+            {
+                SQLOperation* next = _queue->PopPipelinedWrite();
+                if (!next)
+                    break;
+
+                pipeline.push_back(next);
+            }
+
+            if (pipeline.size() > 1)
+            {
+                ExecutePipelined(pipeline);
+                pipeline.clear();
+                continue;
+            }
+
+            pipeline.clear();
+        }
+
         operation->SetConnection(_connection);
         operation->call();
 
+        _queue->Complete(operation);
+        delete operation;
+    }
+}
+
+void DatabaseWorker::ExecutePipelined(std::vector<SQLOperation*>& operations)
+{
+    _connection->BeginTransaction();
+
+    // a reconnect drops the open transaction, the statement that hit it was already retried in autocommit mode
+    uint32 const reconnects = _connection->GetReconnectCount();
+
+    std::size_t executed = 0;
+    bool failed = false;
+    bool lost = false;
+    for (SQLOperation* operation : operations)
+    {
+        operation->SetConnection(_connection);
+        bool result = operation->Execute();
+        if (_connection->GetReconnectCount() != reconnects)
+        {
+            lost = true;
+            break;
+        }
+
+        if (!result)
+        {
+            failed = true;
+            break;
+        }
+
+        ++executed;
+    }
+
+    if (lost)
+    {
+        // statements before the reconnect were discarded with the transaction, the one that hit it is done
+        TC_LOG_WARN("sql.sql", "Connection lost during pipelined statements, executing %u statements one by one.", uint32(operations.size() - 1));
+        for (std::size_t i = 0; i < operations.size(); ++i)
+            if (i != executed)
+                operations[i]->Execute();
+    }
+    else if (!failed)
+    {
+        _connection->CommitTransaction();
+        if (_connection->GetReconnectCount() != reconnects)
+        {
+            TC_LOG_WARN("sql.sql", "Connection lost while committing pipelined statements, executing %u statements one by one.", uint32(operations.size()));
+            for (SQLOperation* operation : operations)
+                operation->Execute();
+        }
+    }
+    else
+    {
+        // the statements were independent, one failing must not take the others down
+        _connection->RollbackTransaction();
+        TC_LOG_WARN("sql.sql", "Pipelined statements rolled back, executing %u statements one by one.", uint32(operations.size()));
+        for (SQLOperation* operation : operations)
+            operation->Execute();
+    }
+
+    for (SQLOperation* operation : operations)
+    {
+        _queue->Complete(operation);
         delete operation;
     }
 }
@@ -21,24 +21,24 @@
 #include "Define.h"
 #include <atomic>
 #include <thread>
+#include <vector>
 
-template <typename T>
-class ProducerConsumerQueue;
-
+class DatabaseWorkQueue;
 class MySQLConnection;
 class SQLOperation;
 
 class TC_DATABASE_API DatabaseWorker
 {
     public:
-        DatabaseWorker(ProducerConsumerQueue<SQLOperation*>* newQueue, MySQLConnection* connection);
+        DatabaseWorker(DatabaseWorkQueue* newQueue, MySQLConnection* connection);
         ~DatabaseWorker();
 
     private:
-        ProducerConsumerQueue<SQLOperation*>* _queue;
+        DatabaseWorkQueue* _queue;
         MySQLConnection* _connection;
 
         void WorkerThread();
+        void ExecutePipelined(std::vector<SQLOperation*>& operations);
         std::thread _workerThread;
 
         std::atomic<bool> _cancelationToken;
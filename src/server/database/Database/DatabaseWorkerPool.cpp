@@ -26,7 +26,6 @@
 #include "Log.h"
 #include "MySQLPreparedStatement.h"
 #include "PreparedStatement.h"
-#include "ProducerConsumerQueue.h"
 #include "QueryCallback.h"
 #include "QueryHolder.h"
 #include "QueryResult.h"
@@ -50,7 +49,7 @@ class PingOperation : public SQLOperation
 
 template <class T>
 DatabaseWorkerPool<T>::DatabaseWorkerPool()
-    : _queue(new ProducerConsumerQueue<SQLOperation*>()),
+    : _queue(new DatabaseWorkQueue()),
       _async_threads(0), _synch_threads(0)
 {
     WPFatal(mysql_thread_safe(), "Used MySQL library isn't thread-safe.");
@@ -208,7 +207,7 @@ QueryCallback DatabaseWorkerPool<T>::AsyncQuery(const char* sql)
     BasicStatementTask* task = new BasicStatementTask(sql, true);
     // Store future result before enqueueing - task might get already processed and deleted before returning from this method
     QueryResultFuture result = task->GetFuture();
-    Enqueue(task);
+    Enqueue(task, SQL_LANE_INTERACTIVE, _queue->GetWriteSequence());
     return QueryCallback(std::move(result));
 }
 
@@ -218,17 +217,26 @@ QueryCallback DatabaseWorkerPool<T>::AsyncQuery(PreparedStatement<T>* stmt)
     PreparedStatementTask* task = new PreparedStatementTask(stmt, true);
     // Store future result before enqueueing - task might get already processed and deleted before returning from this method
     PreparedQueryResultFuture result = task->GetFuture();
-    Enqueue(task);
+    Enqueue(task, SQL_LANE_INTERACTIVE, _queue->GetWriteSequence());
     return QueryCallback(std::move(result));
 }
 
 template <class T>
 QueryResultHolderFuture DatabaseWorkerPool<T>::DelayQueryHolder(SQLQueryHolder<T>* holder)
 {
-    SQLQueryHolderTask* task = new SQLQueryHolderTask(holder);
+    return DelayQueryHolder(holder, _queue->GetWriteSequence());
+}
+
+template <class T>
+QueryResultHolderFuture DatabaseWorkerPool<T>::DelayQueryHolder(SQLQueryHolder<T>* holder, uint64 writeBarrier)
+{
+    // one task per async connection, each idle connection takes its share of the queries
+    uint32 tasks = std::max<uint32>(std::min<size_t>(_async_threads, holder->GetSize()), 1);
+    std::shared_ptr<SQLQueryHolderBatch> batch = std::make_shared<SQLQueryHolderBatch>(holder);
     // Store future result before enqueueing - task might get already processed and deleted before returning from this method
-    QueryResultHolderFuture result = task->GetFuture();
-    Enqueue(task);
+    QueryResultHolderFuture result = batch->Result.get_future();
+    for (uint32 i = 0; i < tasks; ++i)
+        Enqueue(new SQLQueryHolderTask(batch), SQL_LANE_INTERACTIVE, writeBarrier);
     return result;
 }
 
@@ -258,7 +266,7 @@ void DatabaseWorkerPool<T>::CommitTransaction(SQLTransaction<T> transaction)
     }
 #endif // TRINITY_DEBUG
 
-    Enqueue(new TransactionTask(transaction));
+    Enqueue(new TransactionTask(transaction), SQL_LANE_WRITE);
 }
 
 template <class T>
@@ -268,6 +276,7 @@ void DatabaseWorkerPool<T>::DirectCommitTransaction(SQLTransaction<T>& transacti
     int errorCode = connection->ExecuteTransaction(transaction);
     if (!errorCode)
     {
+        transaction->SetCommitted(true);
         connection->Unlock();      // OK, operation succesful
         return;
     }
@@ -280,12 +289,17 @@ void DatabaseWorkerPool<T>::DirectCommitTransaction(SQLTransaction<T>& transacti
         for (uint8 i = 0; i < loopBreaker; ++i)
         {
             if (!connection->ExecuteTransaction(transaction))
-                break;
+            {
+                transaction->SetCommitted(true);
+                connection->Unlock();
+                return;
+            }
         }
     }
 
     //! Clean up now.
     transaction->Cleanup();
+    transaction->SetCommitted(false);
 
     connection->Unlock();
 }
@@ -326,7 +340,7 @@ void DatabaseWorkerPool<T>::KeepAlive()
     //! as the sole purpose is to prevent connections from idling.
     auto const count = _connections[IDX_ASYNC].size();
     for (uint8 i = 0; i < count; ++i)
-        Enqueue(new PingOperation);
+        Enqueue(new PingOperation, SQL_LANE_BULK);
 }
 
 template <class T>
@@ -378,9 +392,9 @@ unsigned long DatabaseWorkerPool<T>::EscapeString(char *to, const char *from, un
 }
 
 template <class T>
-void DatabaseWorkerPool<T>::Enqueue(SQLOperation* op)
+void DatabaseWorkerPool<T>::Enqueue(SQLOperation* op, SQLOperationLane lane, uint64 writeBarrier /*= 0*/)
 {
-    _queue->Push(op);
+    _queue->Push(op, lane, writeBarrier);
 }
 
 template <class T>
@@ -415,6 +429,18 @@ void DatabaseWorkerPool<T>::WaitExecution() const
     }
 }
 
+template <class T>
+uint64 DatabaseWorkerPool<T>::GetWriteSequence() const
+{
+    return _queue->GetWriteSequence();
+}
+
+template <class T>
+SQLLaneStatistics DatabaseWorkerPool<T>::GetLaneStatistics(SQLOperationLane lane) const
+{
+    return _queue->GetStatistics(lane);
+}
+
 template <class T>
 void DatabaseWorkerPool<T>::Execute(const char* sql)
 {
@@ -422,14 +448,14 @@ void DatabaseWorkerPool<T>::Execute(const char* sql)
         return;
 
     BasicStatementTask* task = new BasicStatementTask(sql);
-    Enqueue(task);
+    Enqueue(task, SQL_LANE_WRITE);
 }
 
 template <class T>
 void DatabaseWorkerPool<T>::Execute(PreparedStatement<T>* stmt)
 {
     PreparedStatementTask* task = new PreparedStatementTask(stmt);
-    Enqueue(task);
+    Enqueue(task, SQL_LANE_WRITE);
 }
 
 template <class T>
@@ -20,14 +20,12 @@
 
 #include "Define.h"
 #include "DatabaseEnvFwd.h"
+#include "DatabaseWorkQueue.h"
 #include "StringFormat.h"
 #include <array>
 #include <string>
 #include <vector>
 
-template <typename T>
-class ProducerConsumerQueue;
-
 class SQLOperation;
 struct MySQLConnectionInfo;
 
@@ -160,8 +158,13 @@ class DatabaseWorkerPool
         //! return object as soon as the query is executed.
         //! The return value is then processed in ProcessQueryCallback methods.
         //! Any prepared statements added to this holder need to be prepared with the CONNECTION_ASYNC flag.
+        //! The queries are spread over the async connections idle by the time they run, they must not depend on each other.
         QueryResultHolderFuture DelayQueryHolder(SQLQueryHolder<T>* holder);
 
+        //! Same, but the holder only waits for the writes up to writeBarrier (see GetWriteSequence()) instead of every
+        //! write enqueued before it.
+        QueryResultHolderFuture DelayQueryHolder(SQLQueryHolder<T>* holder, uint64 writeBarrier);
+
         /**
             Transaction context methods.
         */
@@ -204,12 +207,18 @@ class DatabaseWorkerPool
 
         void WaitExecution() const;
 
+        //! Sequence of the last one-way statement or transaction enqueued.
+        uint64 GetWriteSequence() const;
+
+        //! Queue depth and wait time of the async connections per lane.
+        SQLLaneStatistics GetLaneStatistics(SQLOperationLane lane) const;
+
     private:
         uint32 OpenConnections(InternalIndex type, uint8 numConnections);
 
         unsigned long EscapeString(char *to, const char *from, unsigned long length);
 
-        void Enqueue(SQLOperation* op);
+        void Enqueue(SQLOperation* op, SQLOperationLane lane, uint64 writeBarrier = 0);
 
         //! Gets a free connection in the synchronous connection pool.
         //! Caller MUST call t->Unlock() after touching the MySQL context to prevent deadlocks.
@@ -218,7 +227,7 @@ class DatabaseWorkerPool
         char const* GetDatabaseName() const;
 
         //! Queue shared by async worker threads.
-        std::unique_ptr<ProducerConsumerQueue<SQLOperation*>> _queue;
+        std::unique_ptr<DatabaseWorkQueue> _queue;
         std::array<std::vector<std::unique_ptr<T>>, IDX_SIZE> _connections;
         std::unique_ptr<MySQLConnectionInfo> _connectionInfo;
         std::vector<uint8> _preparedStatementSize;
@@ -26,10 +26,7 @@ Field::Field()
     data.raw = false;
 }
 
-Field::~Field()
-{
-    CleanUp();
-}
+Field::~Field() = default;
 
 uint8 Field::GetUInt8() const
 {
@@ -261,6 +258,14 @@ std::vector<uint8> Field::GetBinary() const
     return result;
 }
 
+std::span<uint8 const> Field::GetBinaryView() const
+{
+    if (!data.value || !data.length)
+        return {};
+
+    return { static_cast<uint8 const*>(data.value), data.length };
+}
+
 void Field::SetByteValue(void* newValue, DatabaseFieldTypes newType, uint32 length)
 {
     // This value stores raw bytes that have to be explicitly cast later
@@ -272,18 +277,9 @@ void Field::SetByteValue(void* newValue, DatabaseFieldTypes newType, uint32 leng
 
 void Field::SetStructuredValue(char* newValue, DatabaseFieldTypes newType, uint32 length)
 {
-    if (data.value)
-        CleanUp();
-
     // This value stores somewhat structured data that needs function style casting
-    if (newValue)
-    {
-        data.value = new char[length + 1];
-        memcpy(data.value, newValue, length);
-        *(reinterpret_cast<char*>(data.value) + length) = '\0';
-        data.length = length;
-    }
-
+    data.value = newValue;
+    data.length = newValue ? length : 0;
     data.type = newType;
     data.raw = false;
 }
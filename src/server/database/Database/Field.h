@@ -20,6 +20,8 @@
 
 #include "Define.h"
 #include "DatabaseEnvFwd.h"
+#include <span>
+#include <string_view>
 #include <vector>
 
 enum class DatabaseFieldTypes : uint8
@@ -94,6 +96,8 @@ class TC_DATABASE_API Field
         std::string GetString() const;
         std::string_view GetStringView() const;
         std::vector<uint8> GetBinary() const;
+        // Views into the result set, valid as long as it is
+        std::span<uint8 const> GetBinaryView() const;
 
         bool IsNull() const
         {
@@ -115,23 +119,16 @@ class TC_DATABASE_API Field
         struct
         {
             uint32 length;          // Length (prepared strings only)
-            void* value;            // Actual data in memory
+            void* value;            // Actual data in memory, owned by the result set
             DatabaseFieldTypes type;  // Field type
             bool raw;               // Raw bytes? (Prepared statement or ad hoc)
          } data;
         #pragma pack(pop)
 
         void SetByteValue(void* newValue, DatabaseFieldTypes newType, uint32 length);
+        // newValue is a null terminated row value of a stored MySQL result, it is not copied
         void SetStructuredValue(char* newValue, DatabaseFieldTypes newType, uint32 length);
 
-        void CleanUp()
-        {
-            // Field does not own the data if fetched with prepared statement
-            if (!data.raw)
-                delete[] ((char*)data.value);
-            data.value = NULL;
-        }
-
         bool IsType(DatabaseFieldTypes type) const;
 
         bool IsNumeric() const;
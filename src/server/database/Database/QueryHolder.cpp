@@ -71,24 +71,39 @@ void SQLQueryHolderBase::SetSize(size_t size)
     m_queries.resize(size);
 }
 
-SQLQueryHolderTask::~SQLQueryHolderTask()
+SQLQueryHolderBatch::~SQLQueryHolderBatch()
 {
-    if (!m_executed)
-        delete m_holder;
+    /// nobody will receive the holder if the queue was canceled before every task ran
+    if (!Completed)
+        delete Holder;
 }
 
 bool SQLQueryHolderTask::Execute()
 {
-    m_executed = true;
+    SQLQueryHolderBatch& batch = *m_batch;
 
-    if (!m_holder)
-        return false;
+    /// an empty holder got a single task
+    if (!batch.QueryCount)
+    {
+        batch.Completed = true;
+        batch.Result.set_value(batch.Holder);
+        return true;
+    }
 
-    /// execute all queries in the holder and pass the results
-    for (size_t i = 0; i < m_holder->m_queries.size(); i++)
-        if (PreparedStatementBase* stmt = m_holder->m_queries[i].first)
-            m_holder->SetPreparedResult(i, m_conn->Query(stmt));
+    /// execute the queries not claimed by another task yet, every one writes its own result slot
+    for (size_t i = batch.NextQuery++; i < batch.QueryCount; i = batch.NextQuery++)
+    {
+        SQLQueryHolderBase* holder = batch.Holder;
+        if (PreparedStatementBase* stmt = holder->m_queries[i].first)
+            holder->SetPreparedResult(i, m_conn->Query(stmt));
+
+        /// the task finishing the last query passes the results, the holder belongs to the receiver from here on
+        if (++batch.DoneQueries == batch.QueryCount)
+        {
+            batch.Completed = true;
+            batch.Result.set_value(holder);
+        }
+    }
 
-    m_result.set_value(m_holder);
     return true;
 }
@@ -19,6 +19,8 @@
 #define _QUERYHOLDER_H
 
 #include "SQLOperation.h"
+#include <atomic>
+#include <memory>
 
 class TC_DATABASE_API SQLQueryHolderBase
 {
@@ -29,6 +31,7 @@ class TC_DATABASE_API SQLQueryHolderBase
         SQLQueryHolderBase() { }
         virtual ~SQLQueryHolderBase();
         void SetSize(size_t size);
+        size_t GetSize() const { return m_queries.size(); }
         PreparedQueryResult GetPreparedResult(size_t index);
         void SetPreparedResult(size_t index, PreparedResultSet* result);
 
@@ -46,21 +49,38 @@ public:
     }
 };
 
+//! State shared by the tasks a holder is spread over, see SQLQueryHolderTask
+struct TC_DATABASE_API SQLQueryHolderBatch
+{
+    SQLQueryHolderBatch(SQLQueryHolderBase* holder)
+        : Holder(holder), QueryCount(holder->GetSize()), NextQuery(0), DoneQueries(0), Completed(false) { }
+
+    ~SQLQueryHolderBatch();
+
+    SQLQueryHolderBase* Holder;
+    QueryResultHolderPromise Result;
+    size_t const QueryCount;                                //! the holder isn't touched anymore once every query is done
+    std::atomic<size_t> NextQuery;
+    std::atomic<size_t> DoneQueries;
+    bool Completed;
+};
+
+/*! One of the tasks a holder was split into, one per async connection that may run it.
+    The queries of a holder don't depend on each other: every task claims the next query not
+    started yet until none is left, so a connection becoming idle takes over part of the holder
+    instead of waiting for the one that started it. The task finishing the last query fulfills the
+    future, tasks still queued then find no query left and return without touching the holder.
+*/
 class TC_DATABASE_API SQLQueryHolderTask : public SQLOperation
 {
     private:
-        SQLQueryHolderBase* m_holder;
-        QueryResultHolderPromise m_result;
-        bool m_executed;
+        std::shared_ptr<SQLQueryHolderBatch> m_batch;
 
     public:
-        SQLQueryHolderTask(SQLQueryHolderBase* holder)
-            : m_holder(holder), m_executed(false) { }
-
-        ~SQLQueryHolderTask();
+        SQLQueryHolderTask(std::shared_ptr<SQLQueryHolderBatch> batch)
+            : m_batch(std::move(batch)) { }
 
         bool Execute() override;
-        QueryResultHolderFuture GetFuture() { return m_result.get_future(); }
 };
 
 #endif
@@ -21,6 +21,9 @@
 #include "Log.h"
 #include "MySQLHacks.h"
 #include "MySQLWorkaround.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
 
 static uint32 SizeForType(MYSQL_FIELD* field)
 {
@@ -135,7 +138,9 @@ m_rowPosition(0),
 m_fieldCount(fieldCount),
 m_rBind(NULL),
 m_stmt(stmt),
-m_metadataResult(result)
+m_metadataResult(result),
+m_arenaPos(nullptr),
+m_arenaLeft(0)
 {
     if (!m_metadataResult)
         return;
@@ -186,7 +191,8 @@ m_metadataResult(result)
         m_rBind[i].is_unsigned = field[i].flags & UNSIGNED_FLAG;
     }
 
-    char* dataBuffer = new char[rowSize * m_rowCount];
+    // one row only, each fetched row is packed into the arena
+    char* dataBuffer = new char[rowSize];
     for (uint32 i = 0, offset = 0; i < m_fieldCount; ++i)
     {
         m_rBind[i].buffer = dataBuffer + offset;
@@ -214,6 +220,7 @@ m_metadataResult(result)
             if (!*m_rBind[fIndex].is_null)
             {
                 void* buffer = m_stmt->bind[fIndex].buffer;
+                char* value;
                 switch (m_rBind[fIndex].buffer_type)
                 {
                     case MYSQL_TYPE_TINY_BLOB:
@@ -222,25 +229,25 @@ m_metadataResult(result)
                     case MYSQL_TYPE_BLOB:
                     case MYSQL_TYPE_STRING:
                     case MYSQL_TYPE_VAR_STRING:
-                        // warning - the string will not be null-terminated if there is no space for it in the buffer
-                        // when mysql_stmt_fetch returned MYSQL_DATA_TRUNCATED
-                        // we cannot blindly null-terminate the data either as it may be retrieved as binary blob and not specifically a string
-                        // in this case using Field::GetCString will result in garbage
-                        // TODO: remove Field::GetCString and use boost::string_ref (currently proposed for TS as string_view, maybe in C++17)
-                        if (fetched_length < buffer_length)
-                            *((char*)buffer + fetched_length) = '\0';
+                    case MYSQL_TYPE_DECIMAL:
+                    case MYSQL_TYPE_NEWDECIMAL:
+                        // when mysql_stmt_fetch returned MYSQL_DATA_TRUNCATED only buffer_length bytes were written
+                        // always null-terminated in the arena, so Field::GetCString works for blobs as well
+                        fetched_length = std::min(fetched_length, buffer_length);
+                        value = AllocateValue(fetched_length + 1, 1);
+                        memcpy(value, buffer, fetched_length);
+                        value[fetched_length] = '\0';
                         break;
                     default:
+                        value = AllocateValue(buffer_length, std::min<std::size_t>(buffer_length, alignof(std::max_align_t)));
+                        memcpy(value, buffer, buffer_length);
                         break;
                 }
 
                 m_rows[uint32(m_rowPosition) * m_fieldCount + fIndex].SetByteValue(
-                    buffer,
+                    value,
                     MysqlTypeToFieldType(m_rBind[fIndex].buffer_type),
                     fetched_length);
-
-                // move buffer pointer to next part
-                m_stmt->bind[fIndex].buffer = (char*)buffer + rowSize;
             }
             else
             {
@@ -336,6 +343,25 @@ void ResultSet::CleanUp()
     }
 }
 
+char* PreparedResultSet::AllocateValue(std::size_t size, std::size_t alignment)
+{
+    std::size_t padding = alignment > 1 ? (alignment - reinterpret_cast<uintptr_t>(m_arenaPos) % alignment) % alignment : 0;
+    if (!m_arenaPos || padding + size > m_arenaLeft)
+    {
+        // max_align_t aligned chunks, sized for a few thousand rows of a typical table
+        std::size_t chunkSize = std::max<std::size_t>(size, 64 * 1024);
+        m_arena.emplace_back(new char[chunkSize]);
+        m_arenaPos = m_arena.back().get();
+        m_arenaLeft = chunkSize;
+        padding = 0;
+    }
+
+    char* value = m_arenaPos + padding;
+    m_arenaPos += padding + size;
+    m_arenaLeft -= padding + size;
+    return value;
+}
+
 void PreparedResultSet::CleanUp()
 {
     if (m_metadataResult)
@@ -20,6 +20,7 @@
 
 #include "Define.h"
 #include "DatabaseEnvFwd.h"
+#include <memory>
 #include <vector>
 
 class TC_DATABASE_API ResultSet
@@ -73,8 +74,15 @@ class TC_DATABASE_API PreparedResultSet
         MySQLStmt* m_stmt;
         MySQLResult* m_metadataResult;    ///< Field metadata, returned by mysql_stmt_result_metadata
 
+        /// Values of all rows packed one after another with their fetched length, instead of every row
+        /// padded to the longest value of each column. Fields point into it, it is released at once with the result set.
+        std::vector<std::unique_ptr<char[]>> m_arena;
+        char* m_arenaPos;
+        std::size_t m_arenaLeft;
+
         void CleanUp();
         bool _NextRow();
+        char* AllocateValue(std::size_t size, std::size_t alignment);
 
         PreparedResultSet(PreparedResultSet const& right) = delete;
         PreparedResultSet& operator=(PreparedResultSet const& right) = delete;
@@ -54,7 +54,7 @@ class MySQLConnection;
 class TC_DATABASE_API SQLOperation
 {
     public:
-        SQLOperation(): m_conn(NULL) { }
+        SQLOperation(): m_conn(NULL), m_writeSequence(0) { }
         virtual ~SQLOperation() { }
 
         virtual int call()
@@ -65,7 +65,11 @@ class TC_DATABASE_API SQLOperation
         virtual bool Execute() = 0;
         virtual void SetConnection(MySQLConnection* con) { m_conn = con; }
 
+        //! Statement without result, may be executed in one transaction with the following ones
+        virtual bool IsOneWayStatement() const { return false; }
+
         MySQLConnection* m_conn;
+        uint64 m_writeSequence;                             //! Set by DatabaseWorkQueue for writes
 
     private:
         SQLOperation(SQLOperation const& right) = delete;
@@ -40,6 +40,19 @@ void TransactionBase::AppendPreparedStatement(PreparedStatementBase* stmt)
     m_queries.push_back(data);
 }
 
+TransactionCommitStatePtr TransactionBase::GetCommitState()
+{
+    if (!_commitState)
+        _commitState = std::make_shared<std::atomic<uint8>>(TRANSACTION_COMMIT_PENDING);
+    return _commitState;
+}
+
+void TransactionBase::SetCommitted(bool success)
+{
+    if (_commitState)
+        _commitState->store(success ? TRANSACTION_COMMIT_SUCCEEDED : TRANSACTION_COMMIT_FAILED, std::memory_order_release);
+}
+
 void TransactionBase::Cleanup()
 {
     // This might be called by explicit calls to Cleanup or by the auto-destructor
@@ -67,7 +80,10 @@ bool TransactionTask::Execute()
 {
     int errorCode = m_conn->ExecuteTransaction(m_trans);
     if (!errorCode)
+    {
+        m_trans->SetCommitted(true);
         return true;
+    }
 
     if (errorCode == ER_LOCK_DEADLOCK)
     {
@@ -75,12 +91,18 @@ bool TransactionTask::Execute()
         std::lock_guard<std::mutex> lock(_deadlockLock);
         uint8 loopBreaker = 5;  // Handle MySQL Errno 1213 without extending deadlock to the core itself
         for (uint8 i = 0; i < loopBreaker; ++i)
+        {
             if (!m_conn->ExecuteTransaction(m_trans))
+            {
+                m_trans->SetCommitted(true);
                 return true;
+            }
+        }
     }
 
     // Clean up now.
     m_trans->Cleanup();
+    m_trans->SetCommitted(false);
 
     return false;
 }
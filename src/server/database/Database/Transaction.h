@@ -22,9 +22,20 @@
 #include "DatabaseEnvFwd.h"
 #include "SQLOperation.h"
 #include "StringFormat.h"
+#include <atomic>
+#include <memory>
 #include <mutex>
 #include <vector>
 
+enum TransactionCommitState : uint8
+{
+    TRANSACTION_COMMIT_PENDING      = 0,                    //! queued, executing or never executed
+    TRANSACTION_COMMIT_SUCCEEDED    = 1,
+    TRANSACTION_COMMIT_FAILED       = 2
+};
+
+typedef std::shared_ptr<std::atomic<uint8>> TransactionCommitStatePtr;
+
 /*! Transactions, high level class. */
 class TC_DATABASE_API TransactionBase
 {
@@ -47,13 +58,18 @@ class TC_DATABASE_API TransactionBase
 
         std::size_t GetSize() const { return m_queries.size(); }
 
+        //! TransactionCommitState of this transaction, kept by callers that need to know whether it reached the database.
+        TransactionCommitStatePtr GetCommitState();
+
     protected:
         void AppendPreparedStatement(PreparedStatementBase* statement);
         void Cleanup();
+        void SetCommitted(bool success);
         std::vector<SQLElementData> m_queries;
 
     private:
         bool _cleanedUp;
+        TransactionCommitStatePtr _commitState;
 };
 
 template<typename T>
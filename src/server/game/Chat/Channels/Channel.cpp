@@ -283,6 +283,7 @@ void Channel::JoinChannel(Player* player, std::string const& pass, bool /*client
 
     PlayerInfo pinfo;
     pinfo.player = guid;
+    pinfo.handle = player;
     pinfo.flags = MEMBER_FLAG_NONE;
     _playersStore[guid] = pinfo;
     PlayerInfo& playerInfo = _playersStore[guid];
@@ -640,7 +641,7 @@ void Channel::List(Player const* player)
     list._Members.reserve(_playersStore.size());
     for (auto const& i : _playersStore)
     {
-        Player* member = ObjectAccessor::FindPlayer(i.first);
+        Player* member = i.second.handle;
 
         // PLAYER can't see MODERATOR, GAME MASTER, ADMINISTRATOR characters: MODERATOR, GAME MASTER, ADMINISTRATOR can see all
         if (member && (!AccountMgr::IsPlayerAccount(player->GetSession()->GetSecurity()) || member->GetSession()->GetSecurity() <= AccountTypes(gmLevelInWhoList)) && member->IsVisibleGloballyFor(player))
@@ -979,7 +980,7 @@ void Channel::SendToAll(Builder& builder, ObjectGuid const& guid) const
     Trinity::LocalizedPacketDo<Builder> localizer(builder);
 
     for (auto const& i : _playersStore)
-        if (auto player = ObjectAccessor::FindPlayer(i.first))
+        if (Player* player = i.second.handle)
             if (guid.IsEmpty() || !player->GetSocial()->HasIgnore(guid))
                 localizer(player);
 }
@@ -991,7 +992,7 @@ void Channel::SendToAllButOne(Builder& builder, ObjectGuid const& who) const
 
     for (auto const& i : _playersStore)
         if (i.first != who)
-            if (auto player = ObjectAccessor::FindPlayer(i.first))
+            if (Player* player = i.second.handle)
                 localizer(player);
 }
 
@@ -1010,7 +1011,7 @@ void Channel::SendToAllWithAddon(Builder& builder, std::string const& addonPrefi
     Trinity::LocalizedPacketDo<Builder> localizer(builder);
 
     for (auto const& i : _playersStore)
-        if (auto player = ObjectAccessor::FindPlayer(i.first))
+        if (Player* player = i.second.handle)
             if (player->GetSession()->IsAddonRegistered(addonPrefix) && (guid.IsEmpty() || !player->GetSocial()->HasIgnore(guid)))
                 localizer(player);
 }
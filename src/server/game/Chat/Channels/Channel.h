@@ -126,6 +126,7 @@ class Channel
     struct PlayerInfo
     {
         ObjectGuid player;
+        Player* handle;                                 // valid while on the channel, Player::CleanupChannels leaves every channel before deletion
         uint8 flags;
 
         bool HasFlag(uint8 flag) const;
@@ -0,0 +1,116 @@
+/*
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_CONDITIONDEFINES_H
+#define TRINITY_CONDITIONDEFINES_H
+
+#include "Define.h"
+#include <cstddef>
+
+/*! Documentation on implementing a new ConditionSourceType:
+    Step 1: Check for the lowest free ID. Look for CONDITION_SOURCE_TYPE_UNUSED_XX in the enum.
+            Then define the new source type.
+
+    Step 2: Determine and map the parameters for the new condition type.
+
+    Step 3: Add a case block to ConditionMgr::isSourceTypeValid with the new condition type
+            and validate the parameters.
+
+    Step 4: If your condition can be grouped (determined in step 2), add a rule for it in
+            ConditionMgr::CanHaveSourceGroupSet, following the example of the existing types.
+
+    Step 5: Define the maximum available condition targets in ConditionMgr::GetMaxAvailableConditionTargets.
+
+    The following steps only apply if your condition can be grouped:
+
+    Step 6: Determine how you are going to store your conditions. Conditions kept by ConditionMgr itself
+            all live in the flat ConditionStore, keyed by ConditionStoreKey(SourceType, SourceGroup, SourceEntry, SourceId).
+            Add a function like:
+            ConditionList const& GetConditionsForXXXYourNewSourceTypeXXX(parameters...)
+            looking up the key your source type uses.
+
+            The above function should be placed in upper level (practical) code that actually
+            checks the conditions.
+
+    Step 7: Implement loading for your source type in ConditionMgr::LoadConditions. Conditions stored
+            outside of ConditionMgr must be added with ConditionMgr::AddToConditionList.
+*/
+enum ConditionSourceType
+{
+    CONDITION_SOURCE_TYPE_NONE                           = 0,
+    CONDITION_SOURCE_TYPE_CREATURE_LOOT_TEMPLATE         = 1,
+    CONDITION_SOURCE_TYPE_DISENCHANT_LOOT_TEMPLATE       = 2,
+    CONDITION_SOURCE_TYPE_FISHING_LOOT_TEMPLATE          = 3,
+    CONDITION_SOURCE_TYPE_GAMEOBJECT_LOOT_TEMPLATE       = 4,
+    CONDITION_SOURCE_TYPE_ITEM_LOOT_TEMPLATE             = 5,
+    CONDITION_SOURCE_TYPE_MAIL_LOOT_TEMPLATE             = 6,
+    CONDITION_SOURCE_TYPE_MILLING_LOOT_TEMPLATE          = 7,
+    CONDITION_SOURCE_TYPE_PICKPOCKETING_LOOT_TEMPLATE    = 8,
+    CONDITION_SOURCE_TYPE_PROSPECTING_LOOT_TEMPLATE      = 9,
+    CONDITION_SOURCE_TYPE_REFERENCE_LOOT_TEMPLATE        = 10,
+    CONDITION_SOURCE_TYPE_SKINNING_LOOT_TEMPLATE         = 11,
+    CONDITION_SOURCE_TYPE_SPELL_LOOT_TEMPLATE            = 12,
+    CONDITION_SOURCE_TYPE_SPELL_IMPLICIT_TARGET          = 13,
+    CONDITION_SOURCE_TYPE_GOSSIP_MENU                    = 14,
+    CONDITION_SOURCE_TYPE_GOSSIP_MENU_OPTION             = 15,
+    CONDITION_SOURCE_TYPE_CREATURE_TEMPLATE_VEHICLE      = 16,
+    CONDITION_SOURCE_TYPE_SPELL                          = 17,
+    CONDITION_SOURCE_TYPE_SPELL_CLICK_EVENT              = 18,
+    CONDITION_SOURCE_TYPE_QUEST_ACCEPT                   = 19,
+    CONDITION_SOURCE_TYPE_QUEST_SHOW_MARK                = 20,
+    CONDITION_SOURCE_TYPE_VEHICLE_SPELL                  = 21,
+    CONDITION_SOURCE_TYPE_SMART_EVENT                    = 22,
+    CONDITION_SOURCE_TYPE_PHASE_DEFINITION               = 23,
+    CONDITION_SOURCE_TYPE_SPELL_PROC                     = 24,
+    CONDITION_SOURCE_TYPE_NPC_VENDOR                     = 25,
+    CONDITION_SOURCE_TYPE_AREATRIGGER_ACTION             = 26,
+    CONDITION_SOURCE_TYPE_BONUS_LOOT_TEMPLATE            = 27,
+    CONDITION_SOURCE_TYPE_VIGNETTE                       = 28,
+    CONDITION_SOURCE_TYPE_SEAMLESS_TELEPORT              = 29,
+    CONDITION_SOURCE_TYPE_LOOT_ITEM                      = 30,
+    CONDITION_SOURCE_TYPE_WORLD_LOOT_TEMPLATE            = 31,
+    CONDITION_SOURCE_TYPE_PLAYER_CHOICE                  = 32,
+    CONDITION_SOURCE_TYPE_PLAYER_CHOICE_RESPONS          = 33,
+    CONDITION_SOURCE_TYPE_WORLD_STATE                    = 34,
+    CONDITION_SOURCE_TYPE_MAX                            = 35  //MAX
+};
+
+struct ConditionStoreKey
+{
+    ConditionStoreKey(ConditionSourceType sourceType, uint32 sourceGroup, int32 sourceEntry, uint32 sourceId = 0)
+        : SourceType(sourceType), SourceGroup(sourceGroup), SourceEntry(sourceEntry), SourceId(sourceId) { }
+
+    ConditionSourceType SourceType;
+    uint32 SourceGroup;
+    int32 SourceEntry;
+    uint32 SourceId;
+
+    bool operator==(ConditionStoreKey const& right) const
+    {
+        return SourceType == right.SourceType && SourceGroup == right.SourceGroup && SourceEntry == right.SourceEntry && SourceId == right.SourceId;
+    }
+};
+
+struct ConditionStoreKeyHash
+{
+    std::size_t operator()(ConditionStoreKey const& key) const
+    {
+        uint64 hash = (uint64(key.SourceGroup) << 32 | uint32(key.SourceEntry)) * 0x9E3779B97F4A7C15ULL;
+        hash ^= (uint64(key.SourceType) << 32 | key.SourceId) + (hash >> 29);
+        return std::size_t(hash * 0xBF58476D1CE4E5B9ULL);
+    }
+};
+
+#endif
@@ -857,18 +857,12 @@ uint32 Condition::GetSearcherTypeMaskForCondition()
 
 bool ConditionMgr::IsObjectMeetingSmartEventConditions(int64 entryOrGuid, uint32 eventId, uint32 sourceType, Unit* unit, WorldObject* baseObject) const
 {
-	SmartEventConditionContainer::const_iterator itr = SmartEventConditionStore.find(std::make_pair(entryOrGuid, sourceType));
-	if (itr != SmartEventConditionStore.end())
-	{
-		ConditionTypeContainer::const_iterator i = itr->second.find(eventId + 1);
-		if (i != itr->second.end())
-		{
-			TC_LOG_DEBUG("condition", "GetConditionsForSmartEvent: found conditions for Smart Event entry or guid " SI64FMTD " eventId %u", entryOrGuid, eventId);
-			ConditionSourceInfo sourceInfo(unit, baseObject);
-			return IsObjectMeetToConditions(sourceInfo, i->second);
-		}
-	}
-	return true;
+	ConditionList const& conditions = GetConditionsForSmartEvent(entryOrGuid, eventId, sourceType);
+	if (conditions.empty())
+		return true;
+
+	ConditionSourceInfo sourceInfo(unit, baseObject);
+	return IsObjectMeetToConditionList(sourceInfo, conditions);
 }
 
 bool Condition::isLoaded() const
@@ -913,97 +907,101 @@ ConditionMgr* ConditionMgr::instance()
     return &instance;
 }
 
-ConditionList ConditionMgr::GetConditionReferences(uint32 refId)
+ConditionList const& ConditionMgr::GetConditionReferences(uint32 refId) const
 {
-    ConditionList conditions;
+    static ConditionList const empty;
     ConditionReferenceContainer::const_iterator ref = ConditionReferenceStore.find(refId);
-    if (ref != ConditionReferenceStore.end())
-        conditions = (*ref).second;
-    return conditions;
+    return ref != ConditionReferenceStore.end() ? ref->second : empty;
+}
+
+ConditionList const& ConditionMgr::FindConditions(ConditionStoreKey const& key) const
+{
+    static ConditionList const empty;
+    ConditionContainer::const_iterator itr = ConditionStore.find(key);
+    return itr != ConditionStore.end() ? itr->second : empty;
+}
+
+void ConditionMgr::AddToConditionList(ConditionList& conditions, Condition* cond)
+{
+    ConditionList::iterator itr = std::upper_bound(conditions.begin(), conditions.end(), cond, [](Condition const* left, Condition const* right)
+    {
+        return left->ElseGroup < right->ElseGroup;
+    });
+    conditions.insert(itr, cond);
 }
 
 uint32 ConditionMgr::GetSearcherTypeMaskForConditionList(ConditionList const& conditions)
 {
     if (conditions.empty())
         return GRID_MAP_TYPE_MASK_ALL;
-    //     groupId, typeMask
-    std::map<uint32, uint32> ElseGroupStore;
-    for (ConditionList::const_iterator i = conditions.begin(); i != conditions.end(); ++i)
+
+    // object will match condition when one of the ElseGroups is matching, so let's include all possible masks
+    uint32 mask = 0;
+    for (ConditionList::const_iterator i = conditions.begin(); i != conditions.end();)
     {
-        // no point of having not loaded conditions in list
-        ASSERT((*i)->isLoaded() && "ConditionMgr::GetSearcherTypeMaskForConditionList - not yet loaded condition found in list");
-        std::map<uint32, uint32>::const_iterator itr = ElseGroupStore.find((*i)->ElseGroup);
-        // group not filled yet, fill with widest mask possible
-        if (itr == ElseGroupStore.end())
-            ElseGroupStore[(*i)->ElseGroup] = GRID_MAP_TYPE_MASK_ALL;
-        // no point of checking anymore, empty mask
-        else if (!(*itr).second)
-            continue;
+        // object will match conditions in one ElseGroup only when it matches all of them
+        // so, let's find a smallest possible mask which satisfies all conditions
+        uint32 elseGroup = (*i)->ElseGroup;
+        uint32 groupMask = GRID_MAP_TYPE_MASK_ALL;
+        for (; i != conditions.end() && (*i)->ElseGroup == elseGroup; ++i)
+        {
+            // no point of having not loaded conditions in list
+            ASSERT((*i)->isLoaded() && "ConditionMgr::GetSearcherTypeMaskForConditionList - not yet loaded condition found in list");
+            // no point of checking anymore, empty mask
+            if (!groupMask)
+                continue;
 
-        if ((*i)->ReferenceId) // handle reference
-        {
-            ConditionReferenceContainer::const_iterator ref = ConditionReferenceStore.find((*i)->ReferenceId);
-            ASSERT(ref != ConditionReferenceStore.end() && "ConditionMgr::GetSearcherTypeMaskForConditionList - incorrect reference");
-            ElseGroupStore[(*i)->ElseGroup] &= GetSearcherTypeMaskForConditionList((*ref).second);
-        }
-        else // handle normal condition
-        {
-            // object will match conditions in one ElseGroupStore only when it matches all of them
-            // so, let's find a smallest possible mask which satisfies all conditions
-            ElseGroupStore[(*i)->ElseGroup] &= (*i)->GetSearcherTypeMaskForCondition();
+            if ((*i)->ReferenceId) // handle reference
+            {
+                ConditionReferenceContainer::const_iterator ref = ConditionReferenceStore.find((*i)->ReferenceId);
+                ASSERT(ref != ConditionReferenceStore.end() && "ConditionMgr::GetSearcherTypeMaskForConditionList - incorrect reference");
+                groupMask &= GetSearcherTypeMaskForConditionList(ref->second);
+            }
+            else // handle normal condition
+                groupMask &= (*i)->GetSearcherTypeMaskForCondition();
         }
+
+        mask |= groupMask;
     }
-    // object will match condition when one of the checks in ElseGroupStore is matching
-    // so, let's include all possible masks
-    uint32 mask = 0;
-    for (std::map<uint32, uint32>::const_iterator i = ElseGroupStore.begin(); i != ElseGroupStore.end(); ++i)
-        mask |= i->second;
 
     return mask;
 }
 
 bool ConditionMgr::IsObjectMeetToConditionList(ConditionSourceInfo& sourceInfo, ConditionList const& conditions) const
 {
-    //     groupId, groupCheckPassed
-    std::map<uint32, bool> ElseGroupStore;
-    for (ConditionList::const_iterator i = conditions.begin(); i != conditions.end(); ++i)
+    // the list is grouped by ElseGroup: it's met by the first group having all of its conditions met
+    for (ConditionList::const_iterator i = conditions.begin(); i != conditions.end();)
     {
-        TC_LOG_DEBUG("condition", "ConditionMgr::IsPlayerMeetToConditionList condType: %u val1: %u", (*i)->ConditionType, (*i)->ConditionValue1);
-        if ((*i)->isLoaded())
-        {
-            //! Find ElseGroup in ElseGroupStore
-            std::map<uint32, bool>::const_iterator itr = ElseGroupStore.find((*i)->ElseGroup);
-            //! If not found, add an entry in the store and set to true (placeholder)
-            if (itr == ElseGroupStore.end())
-                ElseGroupStore[(*i)->ElseGroup] = true;
-            else if (!(*itr).second)
+        uint32 elseGroup = (*i)->ElseGroup;
+        bool hasLoaded = false;
+        bool groupMet = true;
+        for (; i != conditions.end() && (*i)->ElseGroup == elseGroup; ++i)
+        {
+            Condition* cond = *i;
+            if (!groupMet || !cond->isLoaded())
                 continue;
 
-            if ((*i)->ReferenceId)//handle reference
+            TC_LOG_DEBUG("condition", "ConditionMgr::IsPlayerMeetToConditionList condType: %u val1: %u", cond->ConditionType, cond->ConditionValue1);
+            hasLoaded = true;
+
+            if (cond->ReferenceId)//handle reference
             {
-                ConditionReferenceContainer::const_iterator ref = ConditionReferenceStore.find((*i)->ReferenceId);
+                ConditionReferenceContainer::const_iterator ref = ConditionReferenceStore.find(cond->ReferenceId);
                 if (ref != ConditionReferenceStore.end())
-                {
-                    if (!IsObjectMeetToConditionList(sourceInfo, (*ref).second))
-                        ElseGroupStore[(*i)->ElseGroup] = false;
-                }
+                    groupMet = IsObjectMeetToConditionList(sourceInfo, ref->second);
                 else
                 {
                     TC_LOG_DEBUG("condition", "IsPlayerMeetToConditionList: Reference template -%u not found",
-                        (*i)->ReferenceId);//checked at loading, should never happen
+                        cond->ReferenceId);//checked at loading, should never happen
                 }
-
             }
             else //handle normal condition
-            {
-                if (!(*i)->Meets(sourceInfo))
-                    ElseGroupStore[(*i)->ElseGroup] = false;
-            }
+                groupMet = cond->Meets(sourceInfo);
         }
-    }
-    for (std::map<uint32, bool>::const_iterator i = ElseGroupStore.begin(); i != ElseGroupStore.end(); ++i)
-        if (i->second)
+
+        if (hasLoaded && groupMet)
             return true;
+    }
 
     return false;
 }
@@ -1064,140 +1062,44 @@ bool ConditionMgr::CanHaveSourceIdSet(ConditionSourceType sourceType) const
     return (sourceType == CONDITION_SOURCE_TYPE_SMART_EVENT);
 }
 
-ConditionList ConditionMgr::GetConditionsForNotGroupedEntry(ConditionSourceType sourceType, uint32 entry)
+ConditionList const& ConditionMgr::GetConditionsForNotGroupedEntry(ConditionSourceType sourceType, uint32 entry) const
 {
-    ConditionList spellCond;
-    if (sourceType > CONDITION_SOURCE_TYPE_NONE && sourceType < CONDITION_SOURCE_TYPE_MAX)
-    {
-        ConditionContainer::const_iterator itr = ConditionStore.find(sourceType);
-        if (itr != ConditionStore.end())
-        {
-            ConditionTypeContainer::const_iterator i = (*itr).second.find(entry);
-            if (i != (*itr).second.end())
-            {
-                spellCond = (*i).second;
-                TC_LOG_DEBUG("condition", "GetConditionsForNotGroupedEntry: found conditions for type %u and entry %u", uint32(sourceType), entry);
-            }
-        }
-    }
-    return spellCond;
+    return FindConditions(ConditionStoreKey(sourceType, 0, entry));
 }
 
-ConditionList ConditionMgr::GetConditionsForSpellClickEvent(uint32 creatureId, uint32 spellId)
+ConditionList const& ConditionMgr::GetConditionsForSpellClickEvent(uint32 creatureId, uint32 spellId) const
 {
-    ConditionList cond;
-    CreatureSpellConditionContainer::const_iterator itr = SpellClickEventConditionStore.find(creatureId);
-    if (itr != SpellClickEventConditionStore.end())
-    {
-        ConditionTypeContainer::const_iterator i = (*itr).second.find(spellId);
-        if (i != (*itr).second.end())
-        {
-            cond = (*i).second;
-            TC_LOG_DEBUG("condition", "GetConditionsForSpellClickEvent: found conditions for Vehicle entry %u spell %u", creatureId, spellId);
-        }
-    }
-    return cond;
+    return FindConditions(ConditionStoreKey(CONDITION_SOURCE_TYPE_SPELL_CLICK_EVENT, creatureId, spellId));
 }
 
-ConditionList ConditionMgr::GetConditionsForVehicleSpell(uint32 creatureId, uint32 spellId)
+ConditionList const& ConditionMgr::GetConditionsForVehicleSpell(uint32 creatureId, uint32 spellId) const
 {
-    ConditionList cond;
-    CreatureSpellConditionContainer::const_iterator itr = VehicleSpellConditionStore.find(creatureId);
-    if (itr != VehicleSpellConditionStore.end())
-    {
-            ConditionTypeContainer::const_iterator i = (*itr).second.find(spellId);
-        if (i != (*itr).second.end())
-        {
-            cond = (*i).second;
-            TC_LOG_DEBUG("condition", "GetConditionsForVehicleSpell: found conditions for Vehicle entry %u spell %u", creatureId, spellId);
-        }
-    }
-    return cond;
+    return FindConditions(ConditionStoreKey(CONDITION_SOURCE_TYPE_VEHICLE_SPELL, creatureId, spellId));
 }
 
-ConditionList ConditionMgr::GetConditionsForSmartEvent(int64 entryOrGuid, uint32 eventId, uint32 sourceType)
+ConditionList const& ConditionMgr::GetConditionsForSmartEvent(int64 entryOrGuid, uint32 eventId, uint32 sourceType) const
 {
-    ConditionList cond;
-    SmartEventConditionContainer::const_iterator itr = SmartEventConditionStore.find(std::make_pair(entryOrGuid, sourceType));
-    if (itr != SmartEventConditionStore.end())
-    {
-        ConditionTypeContainer::const_iterator i = (*itr).second.find(eventId + 1);
-        if (i != (*itr).second.end())
-        {
-            cond = (*i).second;
-            TC_LOG_DEBUG("condition", "GetConditionsForSmartEvent: found conditions for Smart Event entry or guid %ld event_id %u", entryOrGuid, eventId);
-        }
-    }
-    return cond;
+    return FindConditions(ConditionStoreKey(CONDITION_SOURCE_TYPE_SMART_EVENT, eventId + 1, int32(entryOrGuid), sourceType));
 }
 
-ConditionList ConditionMgr::GetConditionsForNpcVendorEvent(uint32 creatureId, uint32 itemId)
+ConditionList const& ConditionMgr::GetConditionsForNpcVendorEvent(uint32 creatureId, uint32 itemId) const
 {
-    ConditionList cond;
-    NpcVendorConditionContainer::const_iterator itr = NpcVendorConditionContainerStore.find(creatureId);
-    if (itr != NpcVendorConditionContainerStore.end())
-    {
-        ConditionTypeContainer::const_iterator i = (*itr).second.find(itemId);
-        if (i != (*itr).second.end())
-        {
-            cond = (*i).second;
-            TC_LOG_DEBUG("condition", "GetConditionsForNpcVendorEvent: found conditions for creature entry %u item %u", creatureId, itemId);
-        }
-    }
-    return cond;
+    return FindConditions(ConditionStoreKey(CONDITION_SOURCE_TYPE_NPC_VENDOR, creatureId, itemId));
 }
 
-ConditionList ConditionMgr::GetConditionsForPhaseDefinition(uint32 zone, uint32 entry)
+ConditionList const& ConditionMgr::GetConditionsForPhaseDefinition(uint32 zone, uint32 entry) const
 {
-    ConditionList cond;
-    PhaseDefinitionConditionContainer::const_iterator itr = PhaseDefinitionsConditionStore.find(zone);
-    if (itr != PhaseDefinitionsConditionStore.end())
-    {
-        ConditionTypeContainer::const_iterator i = (*itr).second.find(entry);
-        if (i != (*itr).second.end())
-        {
-            cond = (*i).second;
-            TC_LOG_DEBUG("condition", "GetConditionsForPhaseDefinition: found conditions for zone %u entry %u size %zu", zone, entry, cond.size());
-        }
-    }
-
-    return cond;
+    return FindConditions(ConditionStoreKey(CONDITION_SOURCE_TYPE_PHASE_DEFINITION, zone, entry));
 }
 
-ConditionList ConditionMgr::GetConditionsForAreaTriggerAction(uint32 areaTriggerId, uint32 actionId)
+ConditionList const& ConditionMgr::GetConditionsForAreaTriggerAction(uint32 areaTriggerId, uint32 actionId) const
 {
-    ConditionList cond;
-    AreaTriggerConditionContainer::const_iterator itr = AreaTriggerConditionStore.find(areaTriggerId);
-    if (itr != AreaTriggerConditionStore.end())
-    {
-        ConditionTypeContainer::const_iterator i = itr->second.find(actionId);
-        if (i != itr->second.end())
-        {
-            cond = i->second;
-            TC_LOG_DEBUG("condition", "GetConditionsForAreaTriggerAction: found conditions for areatrigger id %u entry %u", areaTriggerId, actionId);
-        }
-    }
-
-    return cond;
+    return FindConditions(ConditionStoreKey(CONDITION_SOURCE_TYPE_AREATRIGGER_ACTION, areaTriggerId, actionId));
 }
 
-ConditionList ConditionMgr::GetConditionsForItemLoot(uint32 creatureId, uint32 itemId)
+ConditionList const& ConditionMgr::GetConditionsForItemLoot(uint32 creatureId, uint32 itemId) const
 {
-    ConditionList cond;
-    ItemLootConditionContainer::const_iterator itr = ItemLootConditionStore.find(creatureId);
-    if (itr != ItemLootConditionStore.end())
-    {
-        ConditionTypeContainer::const_iterator i = itr->second.find(itemId);
-        if (i != itr->second.end())
-        {
-            cond = i->second;
-            TC_LOG_DEBUG("condition", "GetConditionsForItemLoot: found conditions for creatureId %u itemId %u", creatureId, itemId);
-        }
-    }
-
-    TC_LOG_DEBUG("condition", "GetConditionsForItemLoot: conditions for creatureId %u itemId %u", creatureId, itemId);
-
-    return cond;
+    return FindConditions(ConditionStoreKey(CONDITION_SOURCE_TYPE_LOOT_ITEM, creatureId, itemId));
 }
 
 void ConditionMgr::LoadConditions(bool isReload)
@@ -1307,12 +1209,7 @@ void ConditionMgr::LoadConditions(bool isReload)
         if (iSourceTypeOrReferenceId < 0)//it is a reference template
         {
             uint32 uRefId = abs(iSourceTypeOrReferenceId);
-            if (ConditionReferenceStore.find(uRefId) == ConditionReferenceStore.end())//make sure we have a list for our conditions, based on reference id
-            {
-                ConditionList mCondList;
-                ConditionReferenceStore[uRefId] = mCondList;
-            }
-            ConditionReferenceStore[uRefId].push_back(cond);//add to reference storage
+            AddToConditionList(ConditionReferenceStore[uRefId], cond);//add to reference storage
             count++;
             continue;
         }//end of reference templates
@@ -1391,7 +1288,7 @@ void ConditionMgr::LoadConditions(bool isReload)
                     break;
                 case CONDITION_SOURCE_TYPE_SPELL_CLICK_EVENT:
                 {
-                    SpellClickEventConditionStore[cond->SourceGroup][cond->SourceEntry].push_back(cond);
+                    AddToConditionList(ConditionStore[ConditionStoreKey(cond->SourceType, cond->SourceGroup, cond->SourceEntry)], cond);
                     valid = true;
                     ++count;
                     continue;   // do not add to m_AllocatedMemory to avoid double deleting
@@ -1401,44 +1298,42 @@ void ConditionMgr::LoadConditions(bool isReload)
                     break;
                 case CONDITION_SOURCE_TYPE_VEHICLE_SPELL:
                 {
-                    VehicleSpellConditionStore[cond->SourceGroup][cond->SourceEntry].push_back(cond);
+                    AddToConditionList(ConditionStore[ConditionStoreKey(cond->SourceType, cond->SourceGroup, cond->SourceEntry)], cond);
                     valid = true;
                     ++count;
                     continue;   // do not add to m_AllocatedMemory to avoid double deleting
                 }
                 case CONDITION_SOURCE_TYPE_SMART_EVENT:
                 {
-                    //! TODO: PAIR_32 ?
-                    std::pair<int32, uint32> key = std::make_pair(cond->SourceEntry, cond->SourceId);
-                    SmartEventConditionStore[key][cond->SourceGroup].push_back(cond);
+                    AddToConditionList(ConditionStore[ConditionStoreKey(cond->SourceType, cond->SourceGroup, cond->SourceEntry, cond->SourceId)], cond);
                     valid = true;
                     ++count;
                     continue;
                 }
                 case CONDITION_SOURCE_TYPE_NPC_VENDOR:
                 {
-                    NpcVendorConditionContainerStore[cond->SourceGroup][cond->SourceEntry].push_back(cond);
+                    AddToConditionList(ConditionStore[ConditionStoreKey(cond->SourceType, cond->SourceGroup, cond->SourceEntry)], cond);
                     valid =  true;
                     ++count;
                     continue;
                 }
                 case CONDITION_SOURCE_TYPE_PHASE_DEFINITION:
                 {
-                    PhaseDefinitionsConditionStore[cond->SourceGroup][cond->SourceEntry].push_back(cond);
+                    AddToConditionList(ConditionStore[ConditionStoreKey(cond->SourceType, cond->SourceGroup, cond->SourceEntry)], cond);
                     valid = true;
                     ++count;
                     continue;
                 }
                 case CONDITION_SOURCE_TYPE_AREATRIGGER_ACTION:
                 {
-                    AreaTriggerConditionStore[cond->SourceGroup][cond->SourceEntry].push_back(cond);
+                    AddToConditionList(ConditionStore[ConditionStoreKey(cond->SourceType, cond->SourceGroup, cond->SourceEntry)], cond);
                     valid = true;
                     ++count;
                     continue;
                 }
                 case CONDITION_SOURCE_TYPE_LOOT_ITEM:
                 {
-                    ItemLootConditionStore[cond->SourceGroup][cond->SourceEntry].push_back(cond);
+                    AddToConditionList(ConditionStore[ConditionStoreKey(cond->SourceType, cond->SourceGroup, cond->SourceEntry)], cond);
                     valid = true;
                     ++count;
                     continue;
@@ -1460,23 +1355,8 @@ void ConditionMgr::LoadConditions(bool isReload)
             continue;
         }
 
-        //handle not grouped conditions
-        //make sure we have a storage list for our SourceType
-        if (ConditionStore.find(cond->SourceType) == ConditionStore.end())
-        {
-            ConditionTypeContainer mTypeMap;
-            ConditionStore[cond->SourceType] = mTypeMap;//add new empty list for SourceType
-        }
-
-        //make sure we have a condition list for our SourceType's entry
-        if (ConditionStore[cond->SourceType].find(cond->SourceEntry) == ConditionStore[cond->SourceType].end())
-        {
-            ConditionList mCondList;
-            ConditionStore[cond->SourceType][cond->SourceEntry] = mCondList;
-        }
-
-        //add new Condition to storage based on Type/Entry
-        ConditionStore[cond->SourceType][cond->SourceEntry].push_back(cond);
+        //handle not grouped conditions, add new Condition to storage based on Type/Entry
+        AddToConditionList(ConditionStore[ConditionStoreKey(cond->SourceType, 0, cond->SourceEntry)], cond);
         ++count;
     }
     while (result->NextRow());
@@ -1510,7 +1390,7 @@ bool ConditionMgr::addToGossipMenus(Condition* cond)
         {
             if ((*itr).second.Entry == cond->SourceGroup && (*itr).second.TextID == uint32(cond->SourceEntry))
             {
-                (*itr).second.Conditions.push_back(cond);
+                AddToConditionList((*itr).second.Conditions, cond);
                 return true;
             }
         }
@@ -1529,7 +1409,7 @@ bool ConditionMgr::addToGossipMenuItems(Condition* cond)
         {
             if ((*itr).second.MenuID == cond->SourceGroup && (*itr).second.OptionIndex == uint32(cond->SourceEntry))
             {
-                (*itr).second.Conditions.push_back(cond);
+                AddToConditionList((*itr).second.Conditions, cond);
                 return true;
             }
         }
@@ -1618,7 +1498,7 @@ bool ConditionMgr::addToSpellImplicitTargetConditions(Condition* cond)
                         spellInfo->Effects[i]->ImplicitTargetConditions = sharedList;
                 }
             }
-            sharedList->push_back(cond);
+            AddToConditionList(*sharedList, cond);
             break;
         }
     }
@@ -2673,109 +2553,11 @@ void ConditionMgr::Clean()
     ConditionReferenceStore.clear();
 
     for (ConditionContainer::iterator itr = ConditionStore.begin(); itr != ConditionStore.end(); ++itr)
-    {
-        for (ConditionTypeContainer::iterator it = itr->second.begin(); it != itr->second.end(); ++it)
-        {
-            for (ConditionList::const_iterator i = it->second.begin(); i != it->second.end(); ++i)
-                delete *i;
-            it->second.clear();
-        }
-        itr->second.clear();
-    }
+        for (ConditionList::const_iterator i = itr->second.begin(); i != itr->second.end(); ++i)
+            delete *i;
 
     ConditionStore.clear();
 
-    for (CreatureSpellConditionContainer::iterator itr = VehicleSpellConditionStore.begin(); itr != VehicleSpellConditionStore.end(); ++itr)
-    {
-        for (ConditionTypeContainer::iterator it = itr->second.begin(); it != itr->second.end(); ++it)
-        {
-            for (ConditionList::const_iterator i = it->second.begin(); i != it->second.end(); ++i)
-                delete *i;
-            it->second.clear();
-        }
-        itr->second.clear();
-    }
-
-    VehicleSpellConditionStore.clear();
-
-    for (SmartEventConditionContainer::iterator itr = SmartEventConditionStore.begin(); itr != SmartEventConditionStore.end(); ++itr)
-    {
-        for (ConditionTypeContainer::iterator it = itr->second.begin(); it != itr->second.end(); ++it)
-        {
-            for (ConditionList::const_iterator i = it->second.begin(); i != it->second.end(); ++i)
-                delete *i;
-            it->second.clear();
-        }
-        itr->second.clear();
-    }
-
-    SmartEventConditionStore.clear();
-
-    for (CreatureSpellConditionContainer::iterator itr = SpellClickEventConditionStore.begin(); itr != SpellClickEventConditionStore.end(); ++itr)
-    {
-        for (ConditionTypeContainer::iterator it = itr->second.begin(); it != itr->second.end(); ++it)
-        {
-            for (ConditionList::const_iterator i = it->second.begin(); i != it->second.end(); ++i)
-                delete *i;
-            it->second.clear();
-        }
-        itr->second.clear();
-    }
-
-    SpellClickEventConditionStore.clear();
-
-    for (NpcVendorConditionContainer::iterator itr = NpcVendorConditionContainerStore.begin(); itr != NpcVendorConditionContainerStore.end(); ++itr)
-    {
-        for (ConditionTypeContainer::iterator it = itr->second.begin(); it != itr->second.end(); ++it)
-        {
-            for (ConditionList::const_iterator i = it->second.begin(); i != it->second.end(); ++i)
-                delete *i;
-            it->second.clear();
-        }
-        itr->second.clear();
-    }
-
-    NpcVendorConditionContainerStore.clear();
-
-    for (PhaseDefinitionConditionContainer::iterator itr = PhaseDefinitionsConditionStore.begin(); itr != PhaseDefinitionsConditionStore.end(); ++itr)
-    {
-        for (ConditionTypeContainer::iterator it = itr->second.begin(); it != itr->second.end(); ++it)
-        {
-            for (ConditionList::const_iterator i = it->second.begin(); i != it->second.end(); ++i)
-                delete *i;
-            it->second.clear();
-        }
-        itr->second.clear();
-    }
-
-    PhaseDefinitionsConditionStore.clear();
-
-    for (AreaTriggerConditionContainer::iterator itr = AreaTriggerConditionStore.begin(); itr != AreaTriggerConditionStore.end(); ++itr)
-    {
-        for (ConditionTypeContainer::iterator it = itr->second.begin(); it != itr->second.end(); ++it)
-        {
-            for (ConditionList::const_iterator i = it->second.begin(); i != it->second.end(); ++i)
-                delete *i;
-            it->second.clear();
-        }
-        itr->second.clear();
-    }
-
-    AreaTriggerConditionStore.clear();
-
-    for (ItemLootConditionContainer::iterator itr = ItemLootConditionStore.begin(); itr != ItemLootConditionStore.end(); ++itr)
-    {
-        for (ConditionTypeContainer::iterator it = itr->second.begin(); it != itr->second.end(); ++it)
-        {
-            for (ConditionList::const_iterator i = it->second.begin(); i != it->second.end(); ++i)
-                delete *i;
-            it->second.clear();
-        }
-        itr->second.clear();
-    }
-
-    ItemLootConditionStore.clear();
-
     // this is a BIG hack, feel free to fix it if you can figure out the ConditionMgr ;)
     for (std::list<Condition*>::const_iterator itr = AllocatedMemoryStore.begin(); itr != AllocatedMemoryStore.end(); ++itr)
         delete *itr;
@@ -19,8 +19,11 @@
 #ifndef TRINITY_CONDITIONMGR_H
 #define TRINITY_CONDITIONMGR_H
 
+#include "ConditionDefines.h"
 #include "LootMgr.h"
 #include "Errors.h"
+#include <unordered_map>
+#include <vector>
 
 struct PlayerConditionEntry;
 class Player;
@@ -102,73 +105,6 @@ enum ConditionTypes
     CONDITION_MAX                   = 68                    // MAX
 };
 
-/*! Documentation on implementing a new ConditionSourceType:
-    Step 1: Check for the lowest free ID. Look for CONDITION_SOURCE_TYPE_UNUSED_XX in the enum.
-            Then define the new source type.
-
-    Step 2: Determine and map the parameters for the new condition type.
-
-    Step 3: Add a case block to ConditionMgr::isSourceTypeValid with the new condition type
-            and validate the parameters.
-
-    Step 4: If your condition can be grouped (determined in step 2), add a rule for it in
-            ConditionMgr::CanHaveSourceGroupSet, following the example of the existing types.
-
-    Step 5: Define the maximum available condition targets in ConditionMgr::GetMaxAvailableConditionTargets.
-
-    The following steps only apply if your condition can be grouped:
-
-    Step 6: Determine how you are going to store your conditions. You need to add a new storage container
-            for it in ConditionMgr class, along with a function like:
-            ConditionList GetConditionsForXXXYourNewSourceTypeXXX(parameters...)
-
-            The above function should be placed in upper level (practical) code that actually
-            checks the conditions.
-
-    Step 7: Implement loading for your source type in ConditionMgr::LoadConditions.
-
-    Step 8: Implement memory cleaning for your source type in ConditionMgr::Clean.
-*/
-enum ConditionSourceType
-{
-    CONDITION_SOURCE_TYPE_NONE                           = 0,
-    CONDITION_SOURCE_TYPE_CREATURE_LOOT_TEMPLATE         = 1,
-    CONDITION_SOURCE_TYPE_DISENCHANT_LOOT_TEMPLATE       = 2,
-    CONDITION_SOURCE_TYPE_FISHING_LOOT_TEMPLATE          = 3,
-    CONDITION_SOURCE_TYPE_GAMEOBJECT_LOOT_TEMPLATE       = 4,
-    CONDITION_SOURCE_TYPE_ITEM_LOOT_TEMPLATE             = 5,
-    CONDITION_SOURCE_TYPE_MAIL_LOOT_TEMPLATE             = 6,
-    CONDITION_SOURCE_TYPE_MILLING_LOOT_TEMPLATE          = 7,
-    CONDITION_SOURCE_TYPE_PICKPOCKETING_LOOT_TEMPLATE    = 8,
-    CONDITION_SOURCE_TYPE_PROSPECTING_LOOT_TEMPLATE      = 9,
-    CONDITION_SOURCE_TYPE_REFERENCE_LOOT_TEMPLATE        = 10,
-    CONDITION_SOURCE_TYPE_SKINNING_LOOT_TEMPLATE         = 11,
-    CONDITION_SOURCE_TYPE_SPELL_LOOT_TEMPLATE            = 12,
-    CONDITION_SOURCE_TYPE_SPELL_IMPLICIT_TARGET          = 13,
-    CONDITION_SOURCE_TYPE_GOSSIP_MENU                    = 14,
-    CONDITION_SOURCE_TYPE_GOSSIP_MENU_OPTION             = 15,
-    CONDITION_SOURCE_TYPE_CREATURE_TEMPLATE_VEHICLE      = 16,
-    CONDITION_SOURCE_TYPE_SPELL                          = 17,
-    CONDITION_SOURCE_TYPE_SPELL_CLICK_EVENT              = 18,
-    CONDITION_SOURCE_TYPE_QUEST_ACCEPT                   = 19,
-    CONDITION_SOURCE_TYPE_QUEST_SHOW_MARK                = 20,
-    CONDITION_SOURCE_TYPE_VEHICLE_SPELL                  = 21,
-    CONDITION_SOURCE_TYPE_SMART_EVENT                    = 22,
-    CONDITION_SOURCE_TYPE_PHASE_DEFINITION               = 23,
-    CONDITION_SOURCE_TYPE_SPELL_PROC                     = 24,
-    CONDITION_SOURCE_TYPE_NPC_VENDOR                     = 25,
-    CONDITION_SOURCE_TYPE_AREATRIGGER_ACTION             = 26,
-    CONDITION_SOURCE_TYPE_BONUS_LOOT_TEMPLATE            = 27,
-    CONDITION_SOURCE_TYPE_VIGNETTE                       = 28,
-    CONDITION_SOURCE_TYPE_SEAMLESS_TELEPORT              = 29,
-    CONDITION_SOURCE_TYPE_LOOT_ITEM                      = 30,
-    CONDITION_SOURCE_TYPE_WORLD_LOOT_TEMPLATE            = 31,
-    CONDITION_SOURCE_TYPE_PLAYER_CHOICE                  = 32,
-    CONDITION_SOURCE_TYPE_PLAYER_CHOICE_RESPONS          = 33,
-    CONDITION_SOURCE_TYPE_WORLD_STATE                    = 34,
-    CONDITION_SOURCE_TYPE_MAX                            = 35  //MAX
-};
-
 enum ComparisionType
 {
     COMP_TYPE_EQ = 0,
@@ -236,17 +172,12 @@ struct Condition
     uint32 GetMaxAvailableConditionTargets();
 };
 
-typedef std::list<Condition*> ConditionList;
-typedef std::map<uint32, ConditionList> ConditionTypeContainer;
-typedef std::map<ConditionSourceType, ConditionTypeContainer> ConditionContainer;
-typedef std::map<uint32, ConditionTypeContainer> CreatureSpellConditionContainer;
-typedef std::map<uint32, ConditionTypeContainer> NpcVendorConditionContainer;
-typedef std::map<std::pair<int32, uint32 /*SAI source_type*/>, ConditionTypeContainer> SmartEventConditionContainer;
-typedef std::map<int32 /*zoneId*/, ConditionTypeContainer> PhaseDefinitionConditionContainer;
-typedef std::map<uint32 /*areatrigger id*/, ConditionTypeContainer> AreaTriggerConditionContainer;
-typedef std::map<uint32 /*itemId*/, ConditionTypeContainer> ItemLootConditionContainer;
+//! Always grouped by ElseGroup, see ConditionMgr::AddToConditionList
+typedef std::vector<Condition*> ConditionList;
 
-typedef std::map<uint32, ConditionList> ConditionReferenceContainer;//only used for references
+//! Every source type ConditionMgr keeps itself in one hash table, a lookup is one probe instead of walking nested trees
+typedef std::unordered_map<ConditionStoreKey, ConditionList, ConditionStoreKeyHash> ConditionContainer;
+typedef std::unordered_map<uint32, ConditionList> ConditionReferenceContainer;//only used for references
 
 class ConditionMgr
 {
@@ -259,7 +190,7 @@ class ConditionMgr
 
         void LoadConditions(bool isReload = false);
         bool isConditionTypeValid(Condition* cond);
-        ConditionList GetConditionReferences(uint32 refId);
+        ConditionList const& GetConditionReferences(uint32 refId) const;
 
         uint32 GetSearcherTypeMaskForConditionList(ConditionList const& conditions);
         bool IsObjectMeetToConditions(WorldObject* object, ConditionList const& conditions);
@@ -267,19 +198,22 @@ class ConditionMgr
         bool IsObjectMeetToConditions(ConditionSourceInfo& sourceInfo, ConditionList const& conditions) const;
         bool CanHaveSourceGroupSet(ConditionSourceType sourceType) const;
         bool CanHaveSourceIdSet(ConditionSourceType sourceType) const;
-        ConditionList GetConditionsForNotGroupedEntry(ConditionSourceType sourceType, uint32 entry);
-        ConditionList GetConditionsForSpellClickEvent(uint32 creatureId, uint32 spellId);
-        ConditionList GetConditionsForSmartEvent(int64 entryOrGuid, uint32 eventId, uint32 sourceType);
-        ConditionList GetConditionsForVehicleSpell(uint32 creatureId, uint32 spellId);
-        ConditionList GetConditionsForNpcVendorEvent(uint32 creatureId, uint32 itemId);
-        ConditionList GetConditionsForPhaseDefinition(uint32 zone, uint32 entry);
-        ConditionList GetConditionsForAreaTriggerAction(uint32 areaTriggerId, uint32 actionId);
-        ConditionList GetConditionsForItemLoot(uint32 creatureId, uint32 itemId);
+        ConditionList const& GetConditionsForNotGroupedEntry(ConditionSourceType sourceType, uint32 entry) const;
+        ConditionList const& GetConditionsForSpellClickEvent(uint32 creatureId, uint32 spellId) const;
+        ConditionList const& GetConditionsForSmartEvent(int64 entryOrGuid, uint32 eventId, uint32 sourceType) const;
+        ConditionList const& GetConditionsForVehicleSpell(uint32 creatureId, uint32 spellId) const;
+        ConditionList const& GetConditionsForNpcVendorEvent(uint32 creatureId, uint32 itemId) const;
+        ConditionList const& GetConditionsForPhaseDefinition(uint32 zone, uint32 entry) const;
+        ConditionList const& GetConditionsForAreaTriggerAction(uint32 areaTriggerId, uint32 actionId) const;
+        ConditionList const& GetConditionsForItemLoot(uint32 creatureId, uint32 itemId) const;
 		bool IsObjectMeetingSmartEventConditions(int64 entryOrGuid, uint32 eventId, uint32 sourceType, Unit* unit, WorldObject* baseObject) const;
         
         static bool IsPlayerMeetingCondition(Unit* unit, int32 conditionID, bool send = false);
         static bool IsPlayerMeetingCondition(Unit* unit, PlayerConditionEntry const* condition);
 
+        //! Inserts cond behind the conditions of its ElseGroup so every group stays contiguous
+        static void AddToConditionList(ConditionList& conditions, Condition* cond);
+
     private:
         bool isSourceTypeValid(Condition* cond);
         bool addToLootTemplate(Condition* cond, LootTemplate* loot);
@@ -287,19 +221,13 @@ class ConditionMgr
         bool addToGossipMenuItems(Condition* cond);
         bool addToSpellImplicitTargetConditions(Condition* cond);
         bool IsObjectMeetToConditionList(ConditionSourceInfo& sourceInfo, ConditionList const& conditions) const;
+        ConditionList const& FindConditions(ConditionStoreKey const& key) const;
 
         void Clean(); // free up resources
         std::list<Condition*> AllocatedMemoryStore; // some garbage collection :)
 
         ConditionContainer                ConditionStore;
         ConditionReferenceContainer       ConditionReferenceStore;
-        CreatureSpellConditionContainer   VehicleSpellConditionStore;
-        CreatureSpellConditionContainer   SpellClickEventConditionStore;
-        NpcVendorConditionContainer       NpcVendorConditionContainerStore;
-        SmartEventConditionContainer      SmartEventConditionStore;
-        PhaseDefinitionConditionContainer PhaseDefinitionsConditionStore;
-        AreaTriggerConditionContainer     AreaTriggerConditionStore;
-        ItemLootConditionContainer        ItemLootConditionStore;
 };
 
 template <class T>
@@ -0,0 +1,70 @@
+/*
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _LFGCOMBINATIONKEY_H
+#define _LFGCOMBINATIONKEY_H
+
+#include "Define.h"
+#include "Errors.h"
+#include <algorithm>
+#include <array>
+
+namespace lfg
+{
+
+enum LfgQueueConstants
+{
+    LFG_MAX_COMBINATION_SIZE = 5                           ///< MAX_GROUP_SIZE, FindNewGroups never combines more queue entries
+};
+
+/// Queue entries of a combination by their LfgQueueData::id, sorted, unused slots are 0
+struct LfgCombinationKey
+{
+    LfgCombinationKey() : ids(), size(0) { }
+
+    void Add(uint32 id)
+    {
+        ASSERT(size < LFG_MAX_COMBINATION_SIZE);
+
+        // keep the ids sorted, every order of the same entries gives the same key
+        uint8 pos = size++;
+        for (; pos && ids[pos - 1] > id; --pos)
+            ids[pos] = ids[pos - 1];
+        ids[pos] = id;
+    }
+
+    bool Contains(uint32 id) const { return std::find(ids.begin(), ids.begin() + size, id) != ids.begin() + size; }
+    bool IsEmpty() const { return !size; }                 ///< No combination, never cached
+
+    bool operator==(LfgCombinationKey const& right) const { return size == right.size && ids == right.ids; }
+
+    std::array<uint32, LFG_MAX_COMBINATION_SIZE> ids;
+    uint8 size;
+};
+
+struct LfgCombinationKeyHash
+{
+    std::size_t operator()(LfgCombinationKey const& key) const
+    {
+        uint64 hash = key.size;
+        for (uint32 id : key.ids)
+            hash = (hash ^ id) * 0x100000001B3ULL;
+        return std::size_t(hash);
+    }
+};
+
+} // namespace lfg
+
+#endif
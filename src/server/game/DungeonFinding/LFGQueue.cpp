@@ -78,6 +78,112 @@ char const* GetCompatibleString(LfgCompatibility compatibles)
     }
 }
 
+static_assert(LFG_MAX_COMBINATION_SIZE == MAX_GROUP_SIZE, "LfgCombinationKey must hold the largest combination FindNewGroups builds");
+
+/**
+   Given a list of guids returns the key of the combination in the compatibility cache
+
+   @param[in]     check list of guids
+   @returns Sorted ids of the queue entries, empty if a guid isn't queued (the combination must not be cached)
+*/
+LfgCombinationKey LFGQueue::GetCombinationKey(GuidList const& check) const
+{
+    LfgCombinationKey key;
+    if (check.size() > LFG_MAX_COMBINATION_SIZE)
+        return key;
+
+    for (ObjectGuid guid : check)
+    {
+        LfgQueueDataContainer::const_iterator itQueue = QueueDataStore.find(guid);
+        if (itQueue == QueueDataStore.end() || key.Contains(itQueue->second.id))
+            return LfgCombinationKey();
+
+        key.Add(itQueue->second.id);
+    }
+    return key;
+}
+
+std::string LFGQueue::GetCombinationString(LfgCombinationKey const& key) const
+{
+    std::ostringstream o;
+    for (uint8 i = 0; i < key.size; ++i)
+    {
+        if (i)
+            o << '|';
+
+        auto itr = EntryGuidStore.find(key.ids[i]);
+        if (itr != EntryGuidStore.end())
+            o << itr->second;
+        else
+            o << '#' << key.ids[i];
+    }
+    return o.str();
+}
+
+/**
+   Remembers a newly cached combination for each of its entries, so only the combinations of
+   an entry leaving the queue have to be dropped
+
+   @param[in]     key Combination just added to the cache
+*/
+void LFGQueue::IndexCombination(LfgCombinationKey const& key)
+{
+    for (uint8 i = 0; i < key.size; ++i)
+    {
+        std::vector<LfgCombinationKey>& keys = CompatibleIndexStore[key.ids[i]];
+
+        // combinations dropped because of another entry leaving stay listed until the list has to grow
+        if (keys.size() >= 32 && keys.size() == keys.capacity())
+            keys.erase(std::remove_if(keys.begin(), keys.end(), [this](LfgCombinationKey const& cached) { return !CompatibleMapStore.count(cached); }), keys.end());
+
+        keys.push_back(key);
+    }
+}
+
+/**
+   Entries only become compatible when they share a dungeon: returns the queued entries sharing
+   one with the given one, in queue order
+
+   @param[in]     guid Entry looking for a group
+   @returns Entries to match it against
+*/
+GuidList LFGQueue::GetCandidates(ObjectGuid guid) const
+{
+    LfgQueueDataContainer::const_iterator itQueue = QueueDataStore.find(guid);
+    if (itQueue == QueueDataStore.end())
+        return currentQueueStore;
+
+    std::vector<std::pair<uint64, ObjectGuid>> candidates;
+    std::unordered_set<uint32> seen;
+    for (uint32 dungeon : itQueue->second.dungeons)
+    {
+        LfgDungeonIndex::const_iterator itDungeon = DungeonIndexStore.find(dungeon);
+        if (itDungeon == DungeonIndexStore.end())
+            continue;
+
+        for (uint32 id : itDungeon->second)
+        {
+            if (id == itQueue->second.id || !seen.insert(id).second)
+                continue;
+
+            auto itGuid = EntryGuidStore.find(id);
+            if (itGuid == EntryGuidStore.end())
+                continue;
+
+            LfgQueueDataContainer::const_iterator itOther = QueueDataStore.find(itGuid->second);
+            if (itOther != QueueDataStore.end() && itOther->second.queueOrder)
+                candidates.emplace_back(itOther->second.queueOrder, itGuid->second);
+        }
+    }
+
+    std::sort(candidates.begin(), candidates.end());
+
+    GuidList all;
+    for (auto const& candidate : candidates)
+        all.push_back(candidate.second);
+    return all;
+}
+
 void LFGQueue::AddToQueue(ObjectGuid guid)
 {
     LfgQueueDataContainer::iterator itQueue = QueueDataStore.find(guid);
@@ -94,27 +200,52 @@ void LFGQueue::RemoveFromQueue(ObjectGuid guid)
 {
     RemoveFromNewQueue(guid);
     RemoveFromCurrentQueue(guid);
-    RemoveFromCompatibles(guid);
 
-    std::ostringstream o;
-    o << guid;
-    std::string sguid = o.str();
+    LfgQueueDataContainer::iterator itQueue = QueueDataStore.find(guid);
+    if (itQueue != QueueDataStore.end())
+        EraseQueueData(itQueue);
+}
 
-    LfgQueueDataContainer::iterator itDelete = QueueDataStore.end();
-    for (LfgQueueDataContainer::iterator itr = QueueDataStore.begin(); itr != QueueDataStore.end(); ++itr)
-        if (itr->first != guid)
-        {
-            if (std::string::npos != itr->second.bestCompatible.find(sguid))
-            {
-                itr->second.bestCompatible.clear();
-                FindBestCompatibleInQueue(itr);
-            }
-        }
-        else
-            itDelete = itr;
+/**
+   Drops an entry with everything cached about it. Only the entries whose best compatible
+   combination included it are looked at again.
+
+   @param[in]     itQueue Entry to remove
+*/
+void LFGQueue::EraseQueueData(LfgQueueDataContainer::iterator itQueue)
+{
+    uint32 id = itQueue->second.id;
+
+    std::vector<uint32> lostBestCompatible;
+    RemoveFromCompatibles(id, lostBestCompatible);
+
+    for (uint32 dungeon : itQueue->second.dungeons)
+    {
+        LfgDungeonIndex::iterator itDungeon = DungeonIndexStore.find(dungeon);
+        if (itDungeon == DungeonIndexStore.end())
+            continue;
+
+        itDungeon->second.erase(id);
+        if (itDungeon->second.empty())
+            DungeonIndexStore.erase(itDungeon);
+    }
+
+    EntryGuidStore.erase(id);
+    QueueDataStore.erase(itQueue);
 
-    if (itDelete != QueueDataStore.end())
-        QueueDataStore.erase(itDelete);
+    for (uint32 otherId : lostBestCompatible)
+    {
+        auto itGuid = EntryGuidStore.find(otherId);
+        if (itGuid == EntryGuidStore.end())
+            continue;
+
+        LfgQueueDataContainer::iterator itOther = QueueDataStore.find(itGuid->second);
+        if (itOther == QueueDataStore.end())
+            continue;
+
+        itOther->second.bestCompatible = LfgCombinationKey();
+        FindBestCompatibleInQueue(itOther);
+    }
 }
 
 void LFGQueue::AddToNewQueue(ObjectGuid guid)
@@ -130,16 +261,40 @@ void LFGQueue::RemoveFromNewQueue(ObjectGuid guid)
 void LFGQueue::AddToCurrentQueue(ObjectGuid guid)
 {
     currentQueueStore.push_back(guid);
+
+    LfgQueueDataContainer::iterator itQueue = QueueDataStore.find(guid);
+    if (itQueue != QueueDataStore.end())
+        itQueue->second.queueOrder = ++lastQueueOrder;
 }
 
 void LFGQueue::RemoveFromCurrentQueue(ObjectGuid guid)
 {
     currentQueueStore.remove(guid);
+
+    LfgQueueDataContainer::iterator itQueue = QueueDataStore.find(guid);
+    if (itQueue != QueueDataStore.end())
+        itQueue->second.queueOrder = 0;
 }
 
 void LFGQueue::AddQueueData(ObjectGuid guid, time_t joinTime, LfgDungeonSet const& dungeons, LfgRolesMap const& rolesMap)
 {
-    QueueDataStore[guid] = LfgQueueData(joinTime, dungeons, rolesMap);
+    uint64 queueOrder = 0;
+    LfgQueueDataContainer::iterator itQueue = QueueDataStore.find(guid);
+    if (itQueue != QueueDataStore.end())
+    {
+        queueOrder = itQueue->second.queueOrder;
+        EraseQueueData(itQueue);
+    }
+
+    LfgQueueData& data = QueueDataStore[guid];
+    data = LfgQueueData(joinTime, dungeons, rolesMap);
+    data.id = ++lastEntryId;
+    data.queueOrder = queueOrder;
+
+    EntryGuidStore[data.id] = guid;
+    for (uint32 dungeon : dungeons)
+        DungeonIndexStore[dungeon].insert(data.id);
+
     AddToQueue(guid);
 }
 
@@ -147,7 +302,7 @@ void LFGQueue::RemoveQueueData(ObjectGuid guid)
 {
     LfgQueueDataContainer::iterator it = QueueDataStore.find(guid);
     if (it != QueueDataStore.end())
-        QueueDataStore.erase(it);
+        EraseQueueData(it);
 }
 
 void LFGQueue::UpdateWaitTimeAvg(int32 waitTime, uint32 dungeonId)
@@ -179,81 +334,110 @@ void LFGQueue::UpdateWaitTimeDps(int32 waitTime, uint32 dungeonId)
 }
 
 /**
-   Remove from cached compatible dungeons any entry that contains the given guid
+   Remove from cached compatible dungeons any entry that contains the given queue entry
 
-   @param[in]     guid Guid to remove from compatible cache
+   @param[in]     id Entry to remove from compatible cache
+   @param[out]    lostBestCompatible Other entries whose best compatible combination was removed
 */
-void LFGQueue::RemoveFromCompatibles(ObjectGuid guid)
+void LFGQueue::RemoveFromCompatibles(uint32 id, std::vector<uint32>& lostBestCompatible)
 {
-    std::stringstream out;
-    out << guid;
-    std::string strGuid = out.str();
-
     std::lock_guard<std::recursive_mutex> _lock(m_lock);
 
-    TC_LOG_DEBUG("lfg", "LFGQueue::RemoveFromCompatibles: Removing %s", guid.ToString().c_str());
-    for (LfgCompatibleContainer::iterator iter = CompatibleMapStore.begin(); iter != CompatibleMapStore.end(); ++iter)
+    LfgCompatibleIndex::iterator itIndex = CompatibleIndexStore.find(id);
+    if (itIndex == CompatibleIndexStore.end())
+        return;
+
+    TC_LOG_DEBUG("lfg", "LFGQueue::RemoveFromCompatibles: Removing entry %u (%u combinations)", id, uint32(itIndex->second.size()));
+    for (LfgCombinationKey const& key : itIndex->second)
     {
-        std::string key = iter->first;
-        if (std::string::npos != key.find(strGuid))
-            CompatibleMapStore.erase(key);
+        // stale, already dropped with another entry
+        if (!CompatibleMapStore.erase(key))
+            continue;
+
+        for (uint8 i = 0; i < key.size; ++i)
+        {
+            if (key.ids[i] == id)
+                continue;
+
+            auto itGuid = EntryGuidStore.find(key.ids[i]);
+            if (itGuid == EntryGuidStore.end())
+                continue;
+
+            LfgQueueDataContainer::const_iterator itOther = QueueDataStore.find(itGuid->second);
+            if (itOther != QueueDataStore.end() && itOther->second.bestCompatible == key)
+                lostBestCompatible.push_back(key.ids[i]);
+        }
     }
+
+    CompatibleIndexStore.erase(itIndex);
 }
 
 /**
    Stores the compatibility of a list of guids
 
-   @param[in]     key String concatenation of guids (| used as separator)
+   @param[in]     key Combination of queue entries
    @param[in]     compatibles type of compatibility
 */
-void LFGQueue::SetCompatibles(std::string const& key, LfgCompatibility compatibles)
+void LFGQueue::SetCompatibles(LfgCombinationKey const& key, LfgCompatibility compatibles)
 {
+    if (key.IsEmpty())
+        return;
+
     std::lock_guard<std::recursive_mutex> _lock(m_lock);
-    CompatibleMapStore.update(key, [compatibles](LfgCompatibleContainer::value_type& item, LfgCompatibleContainer::value_type* old)
-    {
-        if (old)
-            item.second.roles = old->second.roles;
-        item.second.compatibility = compatibles;
-    });
+    auto result = CompatibleMapStore.try_emplace(key);
+    result.first->second.compatibility = compatibles;
+    if (result.second)
+        IndexCombination(key);
 }
 
-void LFGQueue::SetCompatibilityData(std::string const& key, LfgCompatibilityData const& data)
+void LFGQueue::SetCompatibilityData(LfgCombinationKey const& key, LfgCompatibilityData const& data)
 {
+    if (key.IsEmpty())
+        return;
+
     std::lock_guard<std::recursive_mutex> _lock(m_lock);
-    CompatibleMapStore.insert_with(key, [data](LfgCompatibleContainer::value_type& item)
-    {
-        item.second.compatibility = data.compatibility; item.second.roles = data.roles;
-    });
+    if (CompatibleMapStore.try_emplace(key, data).second)
+        IndexCombination(key);
 }
 
 /**
    Get the compatibility of a group of guids
 
-   @param[in]     key String concatenation of guids (| used as separator)
+   @param[in]     key Combination of queue entries
    @return LfgCompatibility type of compatibility
 */
-LfgCompatibility LFGQueue::GetCompatibles(std::string const& key)
+LfgCompatibility LFGQueue::GetCompatibles(LfgCombinationKey const& key)
 {
+    if (key.IsEmpty())
+        return LFG_COMPATIBILITY_PENDING;
+
     std::lock_guard<std::recursive_mutex> _lock(m_lock);
-    LfgCompatibleContainer::guarded_ptr ptr = CompatibleMapStore.get(key);
-    if (ptr)
-        return ptr->second.compatibility;
+    LfgCompatibleContainer::const_iterator itr = CompatibleMapStore.find(key);
+    if (itr != CompatibleMapStore.end())
+        return itr->second.compatibility;
 
     return LFG_COMPATIBILITY_PENDING;
 }
 
-LfgCompatibilityData* LFGQueue::GetCompatibilityData(std::string const& key)
+LfgCompatibilityData* LFGQueue::GetCompatibilityData(LfgCombinationKey const& key)
 {
+    if (key.IsEmpty())
+        return nullptr;
+
     std::lock_guard<std::recursive_mutex> _lock(m_lock);
-    LfgCompatibleContainer::guarded_ptr ptr = CompatibleMapStore.get(key);
-    if (ptr)
-        return &ptr->second;
+    LfgCompatibleContainer::iterator itr = CompatibleMapStore.find(key);
+    if (itr != CompatibleMapStore.end())
+        return &itr->second;
 
     return nullptr;
 }
 
 uint8 LFGQueue::FindGroups()
 {
+    if (newToQueueStore.empty())
+        return 0;
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
     uint8 proposals = 0;
     GuidList firstNew;
     while (!newToQueueStore.empty())
@@ -264,14 +448,21 @@ uint8 LFGQueue::FindGroups()
         firstNew.push_back(frontguid);
         RemoveFromNewQueue(frontguid);
 
-        GuidList temporalList = currentQueueStore;
+        GuidList temporalList = GetCandidates(frontguid);
         LfgCompatibility compatibles = FindNewGroups(firstNew, temporalList);
 
         if (compatibles == LFG_COMPATIBLES_MATCH)
             ++proposals;
         else
             AddToCurrentQueue(frontguid);                  // Lfg group not found, add this group to the queue.
+
+        ++MatchStats.entries;
     }
+
+    uint32 elapsed = uint32(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
+    ++MatchStats.passes;
+    MatchStats.totalTime += elapsed;
+    MatchStats.maxTime = std::max(MatchStats.maxTime, elapsed);
     return proposals;
 }
 
@@ -287,18 +478,18 @@ LfgCompatibility LFGQueue::FindNewGroups(GuidList& check, GuidList& all)
     if (check.empty() || check.size() > MAX_GROUP_SIZE)
         return LFG_INCOMPATIBLES_WRONG_GROUP_SIZE;
 
-    std::string strGuids = ConcatenateGuids(check);
-    LfgCompatibility compatibles = GetCompatibles(strGuids);
+    LfgCombinationKey key = GetCombinationKey(check);
+    LfgCompatibility compatibles = GetCompatibles(key);
 
-    // TC_LOG_DEBUG("lfg", "LFGQueue::FindNewGroup: (%s): %s - all(%s)", strGuids.c_str(), GetCompatibleString(compatibles), ConcatenateGuids(all).c_str());
+    // TC_LOG_DEBUG("lfg", "LFGQueue::FindNewGroup: (%s): %s - all(%s)", ConcatenateGuids(check).c_str(), GetCompatibleString(compatibles), ConcatenateGuids(all).c_str());
     if (compatibles == LFG_COMPATIBILITY_PENDING) // Not previously cached, calculate
         compatibles = CheckCompatibility(check);
-    // TC_LOG_DEBUG("lfg", "LFGQueue::FindNewGroup2: (%s): %s - all(%s)", strGuids.c_str(), GetCompatibleString(compatibles), ConcatenateGuids(all).c_str());
+    // TC_LOG_DEBUG("lfg", "LFGQueue::FindNewGroup2: (%s): %s - all(%s)", ConcatenateGuids(check).c_str(), GetCompatibleString(compatibles), ConcatenateGuids(all).c_str());
 
     if (compatibles == LFG_COMPATIBLES_BAD_STATES && sLFGMgr->AllQueued(check, queueId))
     {
-        TC_LOG_DEBUG("lfg", "LFGQueue::FindNewGroup: (%s) compatibles (cached) changed from bad states to match", strGuids.c_str());
-        SetCompatibles(strGuids, LFG_COMPATIBLES_MATCH);
+        TC_LOG_DEBUG("lfg", "LFGQueue::FindNewGroup: (%s) compatibles (cached) changed from bad states to match", ConcatenateGuids(check).c_str());
+        SetCompatibles(key, LFG_COMPATIBLES_MATCH);
         return LFG_COMPATIBLES_MATCH;
     }
 
@@ -314,6 +505,25 @@ LfgCompatibility LFGQueue::FindNewGroups(GuidList& check, GuidList& all)
         if (sLFGMgr->GetState(guid, queueId) == LFG_STATE_WAITE)
             continue;
 
+        // a combination can't become compatible again by adding entries, skip candidates already failing with one of the checked entries
+        LfgQueueDataContainer::const_iterator itCandidate = QueueDataStore.find(guid);
+        if (itCandidate != QueueDataStore.end())
+        {
+            bool incompatiblePair = false;
+            for (uint8 i = 0; i < key.size && !incompatiblePair; ++i)
+            {
+                LfgCombinationKey pair;
+                pair.Add(key.ids[i]);
+                pair.Add(itCandidate->second.id);
+
+                LfgCompatibility pairCompatibility = GetCompatibles(pair);
+                incompatiblePair = pairCompatibility != LFG_COMPATIBILITY_PENDING && pairCompatibility < LFG_COMPATIBLES_WITH_LESS_PLAYERS;
+            }
+
+            if (incompatiblePair)
+                continue;
+        }
+
         check.push_back(guid);
         LfgCompatibility subcompatibility = FindNewGroups(check, all);
         if (subcompatibility == LFG_COMPATIBLES_MATCH)
@@ -331,7 +541,7 @@ LfgCompatibility LFGQueue::FindNewGroups(GuidList& check, GuidList& all)
 */
 LfgCompatibility LFGQueue::CheckCompatibility(GuidList check)
 {
-    std::string strGuids = ConcatenateGuids(check);
+    LfgCombinationKey key = GetCombinationKey(check);
     LfgProposal proposal;
     LfgDungeonSet proposalDungeons;
     LfgGroupsMap proposalGroups;
@@ -364,7 +574,7 @@ LfgCompatibility LFGQueue::CheckCompatibility(GuidList check)
     // Check for correct size
     if (check.size() > maxGroupSize || check.empty())
     {
-        TC_LOG_DEBUG("lfg", "LFGQueue::CheckCompatibility: (%s): Size wrong - Not compatibles", strGuids.c_str());
+        TC_LOG_DEBUG("lfg", "LFGQueue::CheckCompatibility: (%s): Size wrong - Not compatibles", ConcatenateGuids(check).c_str());
         return LFG_INCOMPATIBLES_WRONG_GROUP_SIZE;
     }
 
@@ -378,8 +588,8 @@ LfgCompatibility LFGQueue::CheckCompatibility(GuidList check)
         LfgCompatibility child_compatibles = CheckCompatibility(check);
         if (child_compatibles < LFG_COMPATIBLES_WITH_LESS_PLAYERS) // Group not compatible
         {
-            // TC_LOG_DEBUG("lfg", "LFGQueue::CheckCompatibility: (%s) child %s not compatibles", strGuids.c_str(), ConcatenateGuids(check).c_str());
-            SetCompatibles(strGuids, child_compatibles);
+            // TC_LOG_DEBUG("lfg", "LFGQueue::CheckCompatibility: (%s) child %s not compatibles", ConcatenateGuids(check).c_str(), ConcatenateGuids(check).c_str());
+            SetCompatibles(key, child_compatibles);
             return child_compatibles;
         }
         check.push_front(frontGuid);
@@ -419,7 +629,7 @@ LfgCompatibility LFGQueue::CheckCompatibility(GuidList check)
     // Group with less that MAX_GROUP_SIZE members always compatible
     if (!sLFGMgr->onTest() && check.size() == 1 && numPlayers < (proposal.isNew && !forceMinPlayers ? maxGroupSize : minGroupSize))
     {
-        TC_LOG_DEBUG("lfg", "LFGQueue::CheckCompatibility: (%s) sigle group. Compatibles", strGuids.c_str());
+        TC_LOG_DEBUG("lfg", "LFGQueue::CheckCompatibility: (%s) sigle group. Compatibles", ConcatenateGuids(check).c_str());
         LfgQueueDataContainer::iterator itQueue = QueueDataStore.find(check.front());
 
         LfgCompatibilityData data(LFG_COMPATIBLES_WITH_LESS_PLAYERS);
@@ -427,22 +637,22 @@ LfgCompatibility LFGQueue::CheckCompatibility(GuidList check)
         uint32 n = 0;
         LFGMgr::CheckGroupRoles(data.roles, LfgRoleData(*itQueue->second.dungeons.begin() & 0xFFFFF), n);
 
-        UpdateBestCompatibleInQueue(itQueue, strGuids, data.roles);
-        SetCompatibilityData(strGuids, data);
+        UpdateBestCompatibleInQueue(itQueue, key, data.roles);
+        SetCompatibilityData(key, data);
         return LFG_COMPATIBLES_WITH_LESS_PLAYERS;
     }
 
     if (numLfgGroups > 1)
     {
-        TC_LOG_DEBUG("lfg", "LFGQueue::CheckCompatibility: (%s) More than one Lfggroup (%u)", strGuids.c_str(), numLfgGroups);
-        SetCompatibles(strGuids, LFG_INCOMPATIBLES_MULTIPLE_LFG_GROUPS);
+        TC_LOG_DEBUG("lfg", "LFGQueue::CheckCompatibility: (%s) More than one Lfggroup (%u)", ConcatenateGuids(check).c_str(), numLfgGroups);
+        SetCompatibles(key, LFG_INCOMPATIBLES_MULTIPLE_LFG_GROUPS);
         return LFG_INCOMPATIBLES_MULTIPLE_LFG_GROUPS;
     }
 
     if (numPlayers > maxGroupSize)
     {
-        TC_LOG_DEBUG("lfg", "LFGQueue::CheckCompatibility: (%s) Too much players (%u)", strGuids.c_str(), numPlayers);
-        SetCompatibles(strGuids, LFG_INCOMPATIBLES_TOO_MUCH_PLAYERS);
+        TC_LOG_DEBUG("lfg", "LFGQueue::CheckCompatibility: (%s) Too much players (%u)", ConcatenateGuids(check).c_str(), numPlayers);
+        SetCompatibles(key, LFG_INCOMPATIBLES_TOO_MUCH_PLAYERS);
         return LFG_INCOMPATIBLES_TOO_MUCH_PLAYERS;
     }
 
@@ -472,8 +682,8 @@ LfgCompatibility LFGQueue::CheckCompatibility(GuidList check)
 
         if (uint8 playersize = numPlayers - proposalRoles.size())
         {
-            TC_LOG_DEBUG("lfg", "LFGQueue::CheckCompatibility: (%s) not compatible, %u players are ignoring each other", strGuids.c_str(), playersize);
-            SetCompatibles(strGuids, LFG_INCOMPATIBLES_HAS_IGNORES);
+            TC_LOG_DEBUG("lfg", "LFGQueue::CheckCompatibility: (%s) not compatible, %u players are ignoring each other", ConcatenateGuids(check).c_str(), playersize);
+            SetCompatibles(key, LFG_INCOMPATIBLES_HAS_IGNORES);
             return LFG_INCOMPATIBLES_HAS_IGNORES;
         }
 
@@ -490,8 +700,8 @@ LfgCompatibility LFGQueue::CheckCompatibility(GuidList check)
             for (LfgRolesMap::const_iterator it = debugRoles.begin(); it != debugRoles.end(); ++it)
                 o << ", " << it->first << ": " << GetRolesString(it->second);
 
-            TC_LOG_DEBUG("lfg", "LFGQueue::CheckCompatibility: (%s) Roles not compatible%s", strGuids.c_str(), o.str().c_str());
-            SetCompatibles(strGuids, LFG_INCOMPATIBLES_NO_ROLES);
+            TC_LOG_DEBUG("lfg", "LFGQueue::CheckCompatibility: (%s) Roles not compatible%s", ConcatenateGuids(check).c_str(), o.str().c_str());
+            SetCompatibles(key, LFG_INCOMPATIBLES_NO_ROLES);
             return LFG_INCOMPATIBLES_NO_ROLES;
         }
 
@@ -508,8 +718,8 @@ LfgCompatibility LFGQueue::CheckCompatibility(GuidList check)
 
         if (proposalDungeons.empty())
         {
-            TC_LOG_DEBUG("lfg", "LFGQueue::CheckCompatibility: (%s) No compatible dungeons%s", strGuids.c_str(), o.str().c_str());
-            SetCompatibles(strGuids, LFG_INCOMPATIBLES_NO_DUNGEONS);
+            TC_LOG_DEBUG("lfg", "LFGQueue::CheckCompatibility: (%s) No compatible dungeons%s", ConcatenateGuids(check).c_str(), o.str().c_str());
+            SetCompatibles(key, LFG_INCOMPATIBLES_NO_DUNGEONS);
             return LFG_INCOMPATIBLES_NO_DUNGEONS;
         }
     }
@@ -526,15 +736,15 @@ LfgCompatibility LFGQueue::CheckCompatibility(GuidList check)
     // Enough players?
     if (!sLFGMgr->onTest() && numPlayers < (proposal.isNew && !forceMinPlayers ? maxGroupSize : minGroupSize))
     {
-        TC_LOG_DEBUG("lfg", "LFGQueue::CheckCompatibility: (%s) Compatibles but not enough players(%u) (%u/%u)", strGuids.c_str(), numPlayers, minGroupSize, maxGroupSize);
+        TC_LOG_DEBUG("lfg", "LFGQueue::CheckCompatibility: (%s) Compatibles but not enough players(%u) (%u/%u)", ConcatenateGuids(check).c_str(), numPlayers, minGroupSize, maxGroupSize);
 
         LfgCompatibilityData data(LFG_COMPATIBLES_WITH_LESS_PLAYERS);
         data.roles = proposalRoles;
 
         for (GuidList::const_iterator itr2 = check.begin(); itr2 != check.end(); ++itr2)
-            UpdateBestCompatibleInQueue(QueueDataStore.find(*itr2), strGuids, data.roles);
+            UpdateBestCompatibleInQueue(QueueDataStore.find(*itr2), key, data.roles);
 
-        SetCompatibilityData(strGuids, data);
+        SetCompatibilityData(key, data);
         return LFG_COMPATIBLES_WITH_LESS_PLAYERS;
     }
 
@@ -542,8 +752,8 @@ LfgCompatibility LFGQueue::CheckCompatibility(GuidList check)
 
     if (!sLFGMgr->AllQueued(check, queueId))
     {
-        TC_LOG_DEBUG("lfg", "LFGQueue::CheckCompatibility: (%s) Group MATCH but can't create proposal!", strGuids.c_str());
-        SetCompatibles(strGuids, LFG_COMPATIBLES_BAD_STATES);
+        TC_LOG_DEBUG("lfg", "LFGQueue::CheckCompatibility: (%s) Group MATCH but can't create proposal!", ConcatenateGuids(check).c_str());
+        SetCompatibles(key, LFG_COMPATIBLES_BAD_STATES);
         return LFG_COMPATIBLES_BAD_STATES;
     }
 
@@ -595,8 +805,8 @@ LfgCompatibility LFGQueue::CheckCompatibility(GuidList check)
 
     sLFGMgr->AddProposal(proposal);
 
-    TC_LOG_DEBUG("lfg", "LFGQueue::CheckCompatibility: (%s) MATCH! Group formed", strGuids.c_str());
-    SetCompatibles(strGuids, LFG_COMPATIBLES_MATCH);
+    TC_LOG_DEBUG("lfg", "LFGQueue::CheckCompatibility: (%s) MATCH! Group formed", ConcatenateGuids(check).c_str());
+    SetCompatibles(key, LFG_COMPATIBLES_MATCH);
     return LFG_COMPATIBLES_MATCH;
 }
 
@@ -659,7 +869,7 @@ void LFGQueue::UpdateQueueTimers(time_t currTime)
                 break;
         }
 
-        if (queueinfo.bestCompatible.empty())
+        if (!queueinfo.bestCompatible.size)
             FindBestCompatibleInQueue(itQueue);
 
         LfgQueueStatusData queueData(dungeonId, waitTime, wtAvg, wtTank, wtHealer, wtDps, queuedTime, &queueinfo);
@@ -691,14 +901,14 @@ uint8 LFGQueue::GetQueueSubType(ObjectGuid guid)
     return itr != QueueDataStore.end() ? itr->second.subType : LFG_QUEUE_DUNGEON;
 }
 
-LfgQueueData::LfgQueueData() : joinTime(time_t(time(nullptr))), type(LFG_TYPE_DUNGEON), subType(LFG_QUEUE_DUNGEON)
+LfgQueueData::LfgQueueData() : joinTime(time_t(time(nullptr))), id(0), queueOrder(0), type(LFG_TYPE_DUNGEON), subType(LFG_QUEUE_DUNGEON)
 {
     tanks = tanksNeeded = minTanksNeeded = LFG_TANKS_NEEDED;
     healers = healerNeeded = minHealerNeeded = LFG_HEALERS_NEEDED;
     dps = dpsNeeded = minDpsNeeded = LFG_DPS_NEEDED;
 }
 
-LfgQueueData::LfgQueueData(time_t _joinTime, LfgDungeonSet const& _dungeons, const LfgRolesMap &_roles)
+LfgQueueData::LfgQueueData(time_t _joinTime, LfgDungeonSet const& _dungeons, const LfgRolesMap &_roles) : id(0), queueOrder(0)
 {
     LFGDungeonData const* dungeon = !_dungeons.empty() ? sLFGMgr->GetLFGDungeon(*_dungeons.begin() & 0xFFFFF) : nullptr;
     type = dungeon ? dungeon->internalType : LFG_TYPE_DUNGEON;
@@ -750,9 +960,12 @@ std::string LFGQueue::DumpCompatibleInfo(bool full /* = false */) const
 {
     std::ostringstream o;
     o << "Compatible Map size: " << CompatibleMapStore.size() << "\n";
+    if (MatchStats.passes)
+        o << "Matching: " << MatchStats.entries << " new entries in " << MatchStats.passes << " passes, avg "
+            << MatchStats.totalTime / MatchStats.passes << " us, max " << MatchStats.maxTime << " us per pass\n";
     if (full)
         for (LfgCompatibleContainer::const_iterator itr = CompatibleMapStore.begin(); itr != CompatibleMapStore.end(); ++itr)
-            o << "(" << itr->first << "): " << GetCompatibleString(itr->second.compatibility) << "\n";
+            o << "(" << GetCombinationString(itr->first) << "): " << GetCompatibleString(itr->second.compatibility) << "\n";
 
     return o.str();
 }
@@ -762,29 +975,28 @@ void LFGQueue::FindBestCompatibleInQueue(LfgQueueDataContainer::iterator itrQueu
     std::lock_guard<std::recursive_mutex> _lock(m_lock);
 
     TC_LOG_DEBUG("lfg", "LFGQueue::FindBestCompatibleInQueue: %s", itrQueue->first.ToString().c_str());
-    std::ostringstream o;
-    o << itrQueue->first;
-    std::string sguid = o.str();
 
-    for (LfgCompatibleContainer::iterator itr = CompatibleMapStore.begin(); itr != CompatibleMapStore.end(); ++itr)
-        if (itr->second.compatibility == LFG_COMPATIBLES_WITH_LESS_PLAYERS && std::string::npos != itr->first.find(sguid))
-            UpdateBestCompatibleInQueue(itrQueue, itr->first, itr->second.roles);
+    LfgCompatibleIndex::const_iterator itIndex = CompatibleIndexStore.find(itrQueue->second.id);
+    if (itIndex == CompatibleIndexStore.end())
+        return;
+
+    for (LfgCombinationKey const& key : itIndex->second)
+    {
+        LfgCompatibleContainer::const_iterator itr = CompatibleMapStore.find(key);
+        if (itr != CompatibleMapStore.end() && itr->second.compatibility == LFG_COMPATIBLES_WITH_LESS_PLAYERS)
+            UpdateBestCompatibleInQueue(itrQueue, key, itr->second.roles);
+    }
 }
 
-void LFGQueue::UpdateBestCompatibleInQueue(LfgQueueDataContainer::iterator itrQueue, std::string const& key, LfgRolesMap const& roles)
+void LFGQueue::UpdateBestCompatibleInQueue(LfgQueueDataContainer::iterator itrQueue, LfgCombinationKey const& key, LfgRolesMap const& roles)
 {
     LfgQueueData& queueData = itrQueue->second;
 
-    uint8 storedSize = queueData.bestCompatible.empty() ? 0 :
-        std::count(queueData.bestCompatible.begin(), queueData.bestCompatible.end(), '|') + 1;
-
-    uint8 size = std::count(key.begin(), key.end(), '|') + 1;
-
-    if (size <= storedSize)
+    if (key.size <= queueData.bestCompatible.size)
         return;
 
     TC_LOG_DEBUG("lfg", "LFGQueue::UpdateBestCompatibleInQueue: Changed (%s) to (%s) as best compatible group for %s",
-        queueData.bestCompatible.c_str(), key.c_str(), itrQueue->first.ToString().c_str());
+        GetCombinationString(queueData.bestCompatible).c_str(), GetCombinationString(key).c_str(), itrQueue->first.ToString().c_str());
 
     queueData.bestCompatible = key;
     queueData.tanks = queueData.tanksNeeded;
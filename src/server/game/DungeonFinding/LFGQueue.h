@@ -19,9 +19,9 @@
 #define _LFGQUEUE_H
 
 #include "LFG.h"
-#include <cds/gc/hp.h>
-#include <cds/container/impl/feldman_hashmap.h>
-#include "HashFuctor.h"
+#include "LFGCombinationKey.h"
+#include <unordered_map>
+#include <unordered_set>
 
 namespace lfg
 {
@@ -57,6 +57,9 @@ struct LfgQueueData
     LfgQueueData();
     LfgQueueData(time_t _joinTime, LfgDungeonSet const& _dungeons, const LfgRolesMap &_roles);
 
+    uint32 id;                                             ///< Numeric id of the queue entry, keys the compatibility cache
+    uint64 queueOrder;                                     ///< Position in the current queue, 0 if not in it
+
     time_t joinTime;                                       ///< Player queue join time (to calculate wait times)
     uint8 tanks;                                           ///< Tanks needed
     uint8 healers;                                         ///< Healers needed
@@ -65,7 +68,7 @@ struct LfgQueueData
     LfgRolesMap roles;                                     ///< Selected Player Role/s
     uint8 type;                                            ///< Queue dungeon type
     uint8 subType;                                         ///< Queue dungeon subtype
-    std::string bestCompatible;                            ///< Best compatible combination of people queued
+    LfgCombinationKey bestCompatible;                      ///< Best compatible combination of people queued
 
     uint8 tanksNeeded;
     uint8 healerNeeded;
@@ -96,8 +99,21 @@ private:
     bool shortageRolesCalculated;
 };
 
+/// Cost of matching new entries against the queue, shown by .lfg queue
+struct LfgMatchStats
+{
+    LfgMatchStats() : passes(0), entries(0), totalTime(0), maxTime(0) { }
+
+    uint64 passes;                                         ///< FindGroups calls with new entries
+    uint64 entries;                                        ///< New entries matched
+    uint64 totalTime;                                      ///< Microseconds
+    uint32 maxTime;                                        ///< Slowest pass, microseconds
+};
+
 typedef std::map<uint32, LfgWaitTime> LfgWaitTimesContainer;
-typedef cds::container::FeldmanHashMap< cds::gc::HP, std::string, LfgCompatibilityData, stringTraits > LfgCompatibleContainer;
+typedef std::unordered_map<LfgCombinationKey, LfgCompatibilityData, LfgCombinationKeyHash> LfgCompatibleContainer;
+typedef std::unordered_map<uint32, std::vector<LfgCombinationKey>> LfgCompatibleIndex;      ///< Entry id -> cached combinations containing it, may hold stale keys
+typedef std::unordered_map<uint32, std::unordered_set<uint32>> LfgDungeonIndex;           ///< Dungeon -> ids of the entries queued for it
 typedef std::map<ObjectGuid, LfgQueueData> LfgQueueDataContainer;
 
 /**
@@ -147,14 +163,20 @@ class LFGQueue
         void RemoveFromNewQueue(ObjectGuid guid);
         void RemoveFromCurrentQueue(ObjectGuid guid);
 
-        void SetCompatibles(std::string const& key, LfgCompatibility compatibles);
-        LfgCompatibility GetCompatibles(std::string const& key);
-        void RemoveFromCompatibles(ObjectGuid guid);
+        LfgCombinationKey GetCombinationKey(GuidList const& check) const;
+        std::string GetCombinationString(LfgCombinationKey const& key) const;
+        void IndexCombination(LfgCombinationKey const& key);
+        void EraseQueueData(LfgQueueDataContainer::iterator itQueue);
+        GuidList GetCandidates(ObjectGuid guid) const;
+
+        void SetCompatibles(LfgCombinationKey const& key, LfgCompatibility compatibles);
+        LfgCompatibility GetCompatibles(LfgCombinationKey const& key);
+        void RemoveFromCompatibles(uint32 id, std::vector<uint32>& lostBestCompatible);
 
-        void SetCompatibilityData(std::string const& key, LfgCompatibilityData const& compatibles);
-        LfgCompatibilityData* GetCompatibilityData(std::string const& key);
+        void SetCompatibilityData(LfgCombinationKey const& key, LfgCompatibilityData const& compatibles);
+        LfgCompatibilityData* GetCompatibilityData(LfgCombinationKey const& key);
         void FindBestCompatibleInQueue(LfgQueueDataContainer::iterator itrQueue);
-        void UpdateBestCompatibleInQueue(LfgQueueDataContainer::iterator itrQueue, std::string const& key, LfgRolesMap const& roles);
+        void UpdateBestCompatibleInQueue(LfgQueueDataContainer::iterator itrQueue, LfgCombinationKey const& key, LfgRolesMap const& roles);
 
         LfgCompatibility FindNewGroups(GuidList& check, GuidList& all);
         LfgCompatibility CheckCompatibility(GuidList check);
@@ -162,7 +184,13 @@ class LFGQueue
         // Queue
         LfgQueueDataContainer QueueDataStore;              ///< Queued groups
         LfgCompatibleContainer CompatibleMapStore;         ///< Compatible dungeons
+        LfgCompatibleIndex CompatibleIndexStore;           ///< Cached combinations of every entry, only the ones of leaving entries are dropped
+        LfgDungeonIndex DungeonIndexStore;                 ///< New entries are only matched against entries sharing a dungeon
+        std::unordered_map<uint32, ObjectGuid> EntryGuidStore;
+        uint32 lastEntryId{};
+        uint64 lastQueueOrder{};
         LfgShortageData ShortageData;                      ///< Roles which currently experience shortage
+        LfgMatchStats MatchStats;
 
         LfgWaitTimesContainer waitTimesAvgStore;           ///< Average wait time to find a group queuing as multiple roles
         LfgWaitTimesContainer waitTimesTankStore;          ///< Average wait time to find a group queuing as tank
@@ -98,11 +98,13 @@ void AreaTrigger::BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player*
     std::size_t maskPos = data->wpos();
     data->resize(data->size() + blockCount * sizeof(UpdateMask::BlockType));
 
-    for (uint16 index = 0; index < m_valuesCount; ++index)
+    BuildUpdateFieldMask(updateType, flags, visibleFlag, _fieldNotifyFlags, m_valuesCount, data->contents() + maskPos);
+
+    for (std::size_t block = 0; block < blockCount; ++block)
     {
-        if (_fieldNotifyFlags & flags[index] || ((updateType == UPDATETYPE_VALUES ? _changesMask[index] : m_uint32Values[index]) && (flags[index] & visibleFlag)))
+        for (UpdateMask::BlockType bits = UpdateMask::GetBlock(data->contents() + maskPos, block); bits; bits &= bits - 1)
         {
-            UpdateMask::SetUpdateBit(data->contents() + maskPos, index);
+            uint16 index = UpdateMask::GetLowestBitIndex(block, bits);
 
             if (index == AREATRIGGER_FIELD_SPELL_XSPELL_VISUAL_ID)
             {
@@ -119,6 +121,12 @@ void AreaTrigger::BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player*
     }
 }
 
+bool AreaTrigger::HasTargetDependentChanges() const
+{
+    // the spell visual is replaced for observers hostile to the caster
+    return Object::HasTargetDependentChanges() || _changesMask[AREATRIGGER_FIELD_SPELL_XSPELL_VISUAL_ID];
+}
+
 AreaTrigger::~AreaTrigger()
 {
     objectCountInWorld[uint8(HighGuid::AreaTrigger)]--;
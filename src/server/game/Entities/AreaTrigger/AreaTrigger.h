@@ -322,6 +322,7 @@ class AreaTrigger : public WorldObject, public GridObject<AreaTrigger>, public M
         ~AreaTrigger();
 
         void BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, Player* target) const override;
+        bool HasTargetDependentChanges() const override;
 
         void AddToWorld() override;
         void RemoveFromWorld() override;
@@ -254,12 +254,14 @@ void Conversation::BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player*
     std::size_t maskPos = data->wpos();
     data->resize(data->size() + blockCount * sizeof(UpdateMask::BlockType));
 
-    for (uint16 index = 0; index < m_valuesCount; ++index)
+    BuildUpdateFieldMask(updateType, flags, visibleFlag, _fieldNotifyFlags, m_valuesCount, data->contents() + maskPos);
+
+    for (std::size_t block = 0; block < blockCount; ++block)
     {
-        if (_fieldNotifyFlags & flags[index] ||
-            ((updateType == UPDATETYPE_VALUES ? _changesMask[index] : m_uint32Values[index]) && (flags[index] & visibleFlag)))
+        for (UpdateMask::BlockType bits = UpdateMask::GetBlock(data->contents() + maskPos, block); bits; bits &= bits - 1)
         {
-            UpdateMask::SetUpdateBit(data->contents() + maskPos, index);
+            uint16 index = UpdateMask::GetLowestBitIndex(block, bits);
+
             *data << m_uint32Values[index];
         }
     }
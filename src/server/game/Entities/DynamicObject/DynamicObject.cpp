@@ -58,13 +58,15 @@ void DynamicObject::BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player
     std::size_t maskPos = data->wpos();
     data->resize(data->size() + blockCount * sizeof(UpdateMask::BlockType));
 
-    for (uint16 index = 0; index < m_valuesCount; ++index)
+    BuildUpdateFieldMask(updateType, flags, visibleFlag, _fieldNotifyFlags, m_valuesCount, data->contents() + maskPos);
+
+    for (std::size_t block = 0; block < blockCount; ++block)
     {
-        if (_fieldNotifyFlags & flags[index] || ((updateType == UPDATETYPE_VALUES ? _changesMask[index] : m_uint32Values[index]) && (flags[index] & visibleFlag)))
+        for (UpdateMask::BlockType bits = UpdateMask::GetBlock(data->contents() + maskPos, block); bits; bits &= bits - 1)
         {
-            UpdateMask::SetUpdateBit(data->contents() + maskPos, index);
+            uint16 index = UpdateMask::GetLowestBitIndex(block, bits);
 
-            if (index == AREATRIGGER_FIELD_SPELL_XSPELL_VISUAL_ID)
+            if (index == DYNAMICOBJECT_FIELD_SPELL_XSPELL_VISUAL_ID)
             {
                 uint32 visualId = GetVisualId();
                 if (auto hostilSpellVisualID = sDB2Manager.GetHostileSpellVisualId(visualId))
@@ -79,6 +81,12 @@ void DynamicObject::BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player
     }
 }
 
+bool DynamicObject::HasTargetDependentChanges() const
+{
+    // the spell visual is replaced for observers hostile to the caster
+    return Object::HasTargetDependentChanges() || _changesMask[DYNAMICOBJECT_FIELD_SPELL_XSPELL_VISUAL_ID];
+}
+
 DynamicObject::~DynamicObject()
 {
     // make sure all references were properly removed
@@ -41,6 +41,7 @@ class DynamicObject : public WorldObject, public GridObject<DynamicObject>, publ
         ~DynamicObject();
 
         void BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, Player* target) const override;
+        bool HasTargetDependentChanges() const override;
 
         void AddToWorld() override;
         void RemoveFromWorld() override;
@@ -160,6 +160,9 @@ void GameObject::AddToWorld()
         sObjectAccessor->AddObject(this);
         // The state can be changed after GameObject::Create but before GameObject::AddToWorld
         bool toggledState = GetGoType() == GAMEOBJECT_TYPE_CHEST ? getLootState() == GO_READY : (GetGoState() == GO_STATE_READY || IsTransport());
+        // the previous model was retired by RemoveFromWorld
+        if (!m_model)
+            m_model = CreateModel();
         if (m_model)
         {
             if (Transport* trans = ToTransport())
@@ -211,9 +214,7 @@ void GameObject::RemoveFromWorld()
                 map->RemoveMaxVisible(this);
 
             RemoveFromOwner();
-            if (m_model)
-                if (map->ContainsGameObjectModel(*m_model))
-                    map->RemoveGameObjectModel(*m_model);
+            RetireModel();
         }
 
         WorldObject::RemoveFromWorld();
@@ -2821,17 +2822,22 @@ void GameObject::EnableCollision(bool enable)
     /*if (enable && !GetMap()->ContainsGameObjectModel(*m_model))
         GetMap()->InsertGameObjectModel(*m_model);*/
 
+    if (m_model->isCollisionEnabled() == enable)
+        return;
+
     m_model->enableCollision(enable);
+    if (IsInWorld())
+    {
+        G3D::AABox const& bounds = m_model->getBounds();
+        GetMap()->InvalidateCollisionQueries(bounds.low().x, bounds.low().y, bounds.high().x, bounds.high().y);
+    }
 }
 
 void GameObject::UpdateModel()
 {
     if (!IsInWorld())
         return;
-    if (m_model)
-        if (GetMap()->ContainsGameObjectModel(*m_model))
-            GetMap()->RemoveGameObjectModel(*m_model);
-    delete m_model;
+    RetireModel();
     m_model = CreateModel();
     if (m_model)
         GetMap()->InsertGameObjectModel(*m_model);
@@ -2922,11 +2928,16 @@ void GameObject::BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player* t
     std::size_t maskPos = data->wpos();
     data->resize(data->size() + blockCount * sizeof(UpdateMask::BlockType));
 
-    for (uint16 index = 0; index < m_valuesCount; ++index)
+    BuildUpdateFieldMask(updateType, flags, visibleFlag, _fieldNotifyFlags, m_valuesCount, data->contents() + maskPos);
+
+    if (forcedFlags)
+        UpdateMask::SetUpdateBit(data->contents() + maskPos, GAMEOBJECT_FIELD_FLAGS);
+
+    for (std::size_t block = 0; block < blockCount; ++block)
     {
-        if (_fieldNotifyFlags & flags[index] || (updateType == UPDATETYPE_VALUES ? _changesMask[index] : m_uint32Values[index]) && flags[index] & visibleFlag || index == GAMEOBJECT_FIELD_FLAGS && forcedFlags)
+        for (UpdateMask::BlockType bits = UpdateMask::GetBlock(data->contents() + maskPos, block); bits; bits &= bits - 1)
         {
-            UpdateMask::SetUpdateBit(data->contents() + maskPos, index);
+            uint16 index = UpdateMask::GetLowestBitIndex(block, bits);
 
             if (index == OBJECT_FIELD_DYNAMIC_FLAGS)
             {
@@ -3028,6 +3039,28 @@ void GameObject::BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player* t
     }
 }
 
+bool GameObject::HasTargetDependentChanges() const
+{
+    if (Object::HasTargetDependentChanges())
+        return true;
+
+    // shipments take every field from the observer's garrison, group loot chests force their flags
+    if (GetGoType() == GAMEOBJECT_TYPE_GARRISON_SHIPMENT || (GetGoType() == GAMEOBJECT_TYPE_CHEST && GetGOInfo()->chest.usegrouplootrules && HasLootRecipient()))
+        return true;
+
+    // fields rewritten per observer in BuildValuesUpdate
+    static uint16 const targetDependentFields[] =
+    {
+        OBJECT_FIELD_DYNAMIC_FLAGS, GAMEOBJECT_FIELD_FLAGS, GAMEOBJECT_FIELD_STATE_WORLD_EFFECT_ID, GAMEOBJECT_FIELD_STATE_SPELL_VISUAL_ID, GAMEOBJECT_FIELD_DISPLAY_ID
+    };
+
+    for (uint16 index : targetDependentFields)
+        if (_changesMask[index])
+            return true;
+
+    return false;
+}
+
 void GameObject::GetRespawnPosition(float &x, float &y, float &z, float* ori /* = nullptr*/) const
 {
     if (m_DBTableGuid)
@@ -3067,6 +3100,22 @@ float GameObject::GetInteractionDistance() const
     }
 }
 
+// Collision queries may still walk the model until the map publishes its next snapshot, possibly after this
+// gameobject was deleted: the model stops colliding, so they never reach its owner again, and the map deletes it
+void GameObject::RetireModel()
+{
+    if (!m_model)
+        return;
+
+    Map* map = GetMap();
+    if (map->ContainsGameObjectModel(*m_model))
+        map->RemoveGameObjectModel(*m_model);
+
+    m_model->enableCollision(false);
+    map->RetireGameObjectModel(m_model);
+    m_model = nullptr;
+}
+
 void GameObject::UpdateModelPosition(bool full)
 {
     if (!m_model)
@@ -3074,11 +3123,17 @@ void GameObject::UpdateModelPosition(bool full)
 
     if (GetMap()->ContainsGameObjectModel(*m_model))
     {
+        G3D::AABox bounds = m_model->getBounds();
+
         if (full)
             GetMap()->RemoveGameObjectModel(*m_model);
         m_model->UpdatePosition();
         if (full)
             GetMap()->InsertGameObjectModel(*m_model);
+
+        // moved in place (transports, lifts), only cached line of sight crossing its old or new bounds is stale
+        bounds.merge(m_model->getBounds());
+        GetMap()->InvalidateCollisionQueries(bounds.low().x, bounds.low().y, bounds.high().x, bounds.high().y);
     }
 }
 
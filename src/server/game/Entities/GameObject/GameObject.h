@@ -104,6 +104,7 @@ class GameObject : public WorldObject, public GridObject<GameObject>, public Map
         ~GameObject();
 
         void BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, Player* target) const override;
+        bool HasTargetDependentChanges() const override;
 
         void AddToWorld() override;
         Battleground* GetBattleground();
@@ -316,6 +317,7 @@ class GameObject : public WorldObject, public GridObject<GameObject>, public Map
     protected:
         GameObjectModel* CreateModel();
         void UpdateModel();                                 // updates model in case displayId were changed
+        void RetireModel();                                 // removes the model from the map, which deletes it later
         lastUserList m_lastUser;
         uint32      m_spellId;
         time_t      m_respawnTime;                          // (secs) time of next respawn (or despawn if GO have owner()),
@@ -8,7 +8,7 @@ class GridObject
     typedef std::vector<ObjectType*> ObjectTypeStorage;
 
 public:
-    GridObject() : _storage(), _offset(0) { }
+    GridObject() : _storage(), _version(nullptr), _offset(0) { }
 
     virtual ~GridObject() { }
 
@@ -17,12 +17,14 @@ public:
         return _storage != nullptr;
     }
 
-    void AddToGrid(ObjectTypeStorage& storage)
+    void AddToGrid(ObjectTypeStorage& storage, uint64& version)
     {
         if (IsInGrid())
             return;
 
         _storage = &storage;
+        _version = &version;
+        ++*_version;
         _offset = _storage->size();
         _storage->emplace_back(static_cast<ObjectType*>(this));
     }
@@ -47,10 +49,12 @@ public:
 
         _storage->pop_back();
         _storage = nullptr;
+        ++*_version;
     }
 
 private:
     ObjectTypeStorage* _storage;
+    uint64* _version;                                       // membership version of the cell container
     std::size_t _offset;
 };
 
@@ -149,7 +149,7 @@ void Object::_InitValues()
     m_uint32Values = new uint32[m_valuesCount];
     memset(m_uint32Values, 0, m_valuesCount * sizeof(uint32));
 
-    _changesMask.resize(m_valuesCount);
+    _changesMask.Resize(m_valuesCount);
     _dynamicChangesMask.resize(_dynamicValuesCount);
     if (_dynamicValuesCount)
     {
@@ -763,14 +763,19 @@ void Object::BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player* targe
     std::size_t maskPos = data->wpos();
     data->resize(data->size() + blockCount * sizeof(UpdateMask::BlockType));
 
-    for (uint16 index = 0; index < m_valuesCount; ++index)
-    {
-        if (_fieldNotifyFlags & flags[index] || (updateType == UPDATETYPE_VALUES ? _changesMask[index] : m_uint32Values[index]) && flags[index] & visibleFlag)
-        {
-            UpdateMask::SetUpdateBit(data->contents() + maskPos, index);
-            *data << m_uint32Values[index];
-        }
-    }
+    BuildUpdateFieldMask(updateType, flags, visibleFlag, _fieldNotifyFlags, m_valuesCount, data->contents() + maskPos);
+
+    for (std::size_t block = 0; block < blockCount; ++block)
+        for (UpdateMask::BlockType bits = UpdateMask::GetBlock(data->contents() + maskPos, block); bits; bits &= bits - 1)
+            *data << m_uint32Values[UpdateMask::GetLowestBitIndex(block, bits)];
+}
+
+void Object::BuildUpdateFieldMask(uint8 updateType, uint32 const* flags, uint32 visibleFlag, uint32 alwaysFlags, uint32 valCount, uint8* mask) const
+{
+    if (updateType == UPDATETYPE_VALUES)
+        _changesMask.BuildFieldMask(flags, valCount, visibleFlag, alwaysFlags, mask);
+    else
+        UpdateMask::BuildCreateFieldMask(m_uint32Values, flags, valCount, visibleFlag, alwaysFlags, mask);
 }
 
 void Object::BuildDynamicValuesUpdate(uint8 updateType, ByteBuffer *data, Player* target) const
@@ -838,7 +843,7 @@ void Object::ClearUpdateMask(bool /*remove*/)
 {
     std::lock_guard<std::recursive_mutex> _update_lock(m_update_lock);
 
-    memset(_changesMask.data(), 0, _changesMask.size());
+    _changesMask.Reset();
     _dynamicChangesMask.assign(_dynamicChangesMask.size(), UpdateMask::UNCHANGED);
     for (uint32 i = 0; i < _dynamicValuesCount; ++i)
         memset(_dynamicChangesArrayMask[i].data(), 0, _dynamicChangesArrayMask[i].size());
@@ -847,7 +852,7 @@ void Object::ClearUpdateMask(bool /*remove*/)
         m_objectUpdated = false;
 }
 
-void Object::BuildFieldsUpdate(Player* player, UpdateDataMapType& data_map) const
+void Object::BuildFieldsUpdate(Player* player, UpdateDataMapType& data_map, SharedValuesUpdateCache* sharedBlocks) const
 {
     auto iter = data_map.find(player);
 
@@ -858,7 +863,49 @@ void Object::BuildFieldsUpdate(Player* player, UpdateDataMapType& data_map) cons
         iter = p.first;
     }
 
-    BuildValuesUpdateBlockForPlayer(&iter->second, iter->first);
+    // Observer waits for a forced dynamic flags refresh, it can't use a shared block
+    if (!sharedBlocks || player->needUpdateDynamicFlags || !IsInWorld())
+    {
+        BuildValuesUpdateBlockForPlayer(&iter->second, iter->first);
+        return;
+    }
+
+    // Only visibility flags decide which changed fields an observer gets, serialize once per flag combination
+    uint32* flags = nullptr;
+    uint32 visibleFlag = GetUpdateFieldData(player, flags);
+    uint32 dynamicVisibleFlag = GetDynamicUpdateFieldData(player, flags);
+
+    for (SharedValuesUpdateBlock const& shared : *sharedBlocks)
+    {
+        if (shared.VisibleFlag == visibleFlag && shared.DynamicVisibleFlag == dynamicVisibleFlag)
+        {
+            iter->second.AddUpdateBlock(shared.Block);
+            return;
+        }
+    }
+
+    sharedBlocks->push_back({ visibleFlag, dynamicVisibleFlag, ByteBuffer(500) });
+    ByteBuffer& buf = sharedBlocks->back().Block;
+
+    buf << uint8(UPDATETYPE_VALUES);
+    buf << GetGUID();
+
+    BuildValuesUpdate(UPDATETYPE_VALUES, &buf, player);
+    BuildDynamicValuesUpdate(UPDATETYPE_VALUES, &buf, player);
+
+    if (buf.size() > 10000000) // Prevent overflow
+    {
+        sharedBlocks->pop_back();
+        return;
+    }
+
+    iter->second.AddUpdateBlock(buf);
+}
+
+bool Object::HasTargetDependentChanges() const
+{
+    // arena cooldowns are rebased on the time sync of each observer
+    return PLAYER_DYNAMIC_FIELD_ARENA_COOLDOWNS < _dynamicValuesCount && _dynamicChangesMask[PLAYER_DYNAMIC_FIELD_ARENA_COOLDOWNS] != UpdateMask::UNCHANGED;
 }
 
 uint32 Object::GetUpdateFieldData(Player const* target, uint32*& flags) const
@@ -985,7 +1032,7 @@ void Object::_LoadIntoDataField(std::string const& data, uint32 startOffset, uin
     for (uint32 index = 0; index < count; ++index)
     {
         m_uint32Values[startOffset + index] = atoul(tokens[index]);
-        _changesMask[startOffset + index] = 1;
+        _changesMask.Set(startOffset + index);
     }
 }
 
@@ -998,7 +1045,7 @@ void Object::SetInt32Value(uint16 index, int32 value)
     if (m_int32Values[index] != value)
     {
         m_int32Values[index] = value;
-        _changesMask[index] = 1;
+        _changesMask.Set(index);
 
         AddToObjectUpdateIfNeeded();
     }
@@ -1011,7 +1058,7 @@ void Object::UpdateInt32Value(uint16 index, int32 value)
         return;
 
     m_int32Values[index] = value;
-    _changesMask[index] = 1;
+    _changesMask.Set(index);
 }
 
 void Object::SetUInt32Value(uint16 index, uint32 value)
@@ -1023,7 +1070,7 @@ void Object::SetUInt32Value(uint16 index, uint32 value)
     if (m_uint32Values[index] != value)
     {
         m_uint32Values[index] = value;
-        _changesMask[index] = 1;
+        _changesMask.Set(index);
 
         AddToObjectUpdateIfNeeded();
     }
@@ -1036,7 +1083,7 @@ void Object::UpdateUInt32Value(uint16 index, uint32 value)
         return;
 
     m_uint32Values[index] = value;
-    _changesMask[index] = 1;
+    _changesMask.Set(index);
 }
 
 void Object::SetUInt64Value(uint16 index, uint64 value)
@@ -1049,8 +1096,8 @@ void Object::SetUInt64Value(uint16 index, uint64 value)
     {
         m_uint32Values[index] = PAIR64_LOPART(value);
         m_uint32Values[index + 1] = PAIR64_HIPART(value);
-        _changesMask[index] = 1;
-        _changesMask[index + 1] = 1;
+        _changesMask.Set(index);
+        _changesMask.Set(index + 1);
 
         AddToObjectUpdateIfNeeded();
     }
@@ -1065,10 +1112,10 @@ bool Object::AddGuidValue(uint16 index, ObjectGuid const& value)
     if (!value.IsEmpty() && reinterpret_cast<ObjectGuid*>(&m_uint32Values[index])->IsEmpty())
     {
         *reinterpret_cast<ObjectGuid*>(&m_uint32Values[index]) = value;
-        _changesMask[index] = 1;
-        _changesMask[index + 1] = 1;
-        _changesMask[index + 2] = 1;
-        _changesMask[index + 3] = 1;
+        _changesMask.Set(index);
+        _changesMask.Set(index + 1);
+        _changesMask.Set(index + 2);
+        _changesMask.Set(index + 3);
 
         AddToObjectUpdateIfNeeded();
         return true;
@@ -1086,10 +1133,10 @@ bool Object::RemoveGuidValue(uint16 index, ObjectGuid const& value)
     if (!value.IsEmpty() && *reinterpret_cast<ObjectGuid*>(&m_uint32Values[index]) == value)
     {
         reinterpret_cast<ObjectGuid*>(&m_uint32Values[index])->Clear();
-        _changesMask[index] = 1;
-        _changesMask[index + 1] = 1;
-        _changesMask[index + 2] = 1;
-        _changesMask[index + 3] = 1;
+        _changesMask.Set(index);
+        _changesMask.Set(index + 1);
+        _changesMask.Set(index + 2);
+        _changesMask.Set(index + 3);
 
         AddToObjectUpdateIfNeeded();
         return true;
@@ -1107,7 +1154,7 @@ void Object::SetFloatValue(uint16 index, float value)
     if (m_floatValues[index] != value)
     {
         m_floatValues[index] = value;
-        _changesMask[index] = 1;
+        _changesMask.Set(index);
 
         AddToObjectUpdateIfNeeded();
     }
@@ -1129,7 +1176,7 @@ void Object::SetByteValue(uint16 index, uint8 offset, uint8 value)
     {
         m_uint32Values[index] &= ~uint32(uint32(0xFF) << offset * 8);
         m_uint32Values[index] |= uint32(uint32(value) << offset * 8);
-        _changesMask[index] = 1;
+        _changesMask.Set(index);
 
         AddToObjectUpdateIfNeeded();
     }
@@ -1151,7 +1198,7 @@ void Object::SetUInt16Value(uint16 index, uint8 offset, uint16 value, bool updat
     {
         m_uint32Values[index] &= ~uint32(uint32(0xFFFF) << offset * 16);
         m_uint32Values[index] |= uint32(uint32(value) << offset * 16);
-        _changesMask[index] = 1;
+        _changesMask.Set(index);
 
         if (update)
             AddToObjectUpdateIfNeeded();
@@ -1167,10 +1214,10 @@ void Object::SetGuidValue(uint16 index, ObjectGuid const& value)
     if (*reinterpret_cast<ObjectGuid*>(&m_uint32Values[index]) != value)
     {
         *reinterpret_cast<ObjectGuid*>(&m_uint32Values[index]) = value;
-        _changesMask[index] = 1;
-        _changesMask[index + 1] = 1;
-        _changesMask[index + 2] = 1;
-        _changesMask[index + 3] = 1;
+        _changesMask.Set(index);
+        _changesMask.Set(index + 1);
+        _changesMask.Set(index + 2);
+        _changesMask.Set(index + 3);
 
         AddToObjectUpdateIfNeeded();
     }
@@ -1252,7 +1299,7 @@ void Object::SetFlag(uint16 index, uint32 newFlag)
     if (oldval != newval)
     {
         m_uint32Values[index] = newval;
-        _changesMask[index] = 1;
+        _changesMask.Set(index);
 
         AddToObjectUpdateIfNeeded();
     }
@@ -1272,7 +1319,7 @@ void Object::RemoveFlag(uint16 index, uint32 oldFlag)
     if (oldval != newval)
     {
         m_uint32Values[index] = newval;
-        _changesMask[index] = 1;
+        _changesMask.Set(index);
 
         AddToObjectUpdateIfNeeded();
     }
@@ -1314,7 +1361,7 @@ void Object::SetByteFlag(uint16 index, uint8 offset, uint8 newFlag)
     if (!(uint8(m_uint32Values[index] >> offset * 8) & newFlag))
     {
         m_uint32Values[index] |= uint32(uint32(newFlag) << offset * 8);
-        _changesMask[index] = 1;
+        _changesMask.Set(index);
 
         AddToObjectUpdateIfNeeded();
     }
@@ -1335,7 +1382,7 @@ void Object::RemoveByteFlag(uint16 index, uint8 offset, uint8 oldFlag)
     if (uint8(m_uint32Values[index] >> offset * 8) & oldFlag)
     {
         m_uint32Values[index] &= ~uint32(uint32(oldFlag) << offset * 8);
-        _changesMask[index] = 1;
+        _changesMask.Set(index);
 
         AddToObjectUpdateIfNeeded();
     }
@@ -2788,7 +2835,7 @@ void WorldObject::SendPlaySound(uint32 soundKitID, bool OnlySelf)
 
 void Object::ForceValuesUpdateAtIndex(uint32 i)
 {
-    _changesMask[i] = 1;
+    _changesMask.Set(i);
     AddToObjectUpdateIfNeeded();
 }
 
@@ -3854,8 +3901,9 @@ struct WorldObjectChangeAccumulator
     UpdateDataMapType& i_updateDatas;
     WorldObject& i_object;
     GuidSet plr_list;
+    SharedValuesUpdateCache* i_sharedBlocks;
 
-    WorldObjectChangeAccumulator(WorldObject &obj, UpdateDataMapType &d) : i_updateDatas(d), i_object(obj) { }
+    WorldObjectChangeAccumulator(WorldObject &obj, UpdateDataMapType &d, SharedValuesUpdateCache* sharedBlocks) : i_updateDatas(d), i_object(obj), i_sharedBlocks(sharedBlocks) { }
 
     void Visit(PlayerMapType &m)
     {
@@ -3902,7 +3950,7 @@ struct WorldObjectChangeAccumulator
         // Only send update once to a player
         if (plr_list.find(player->GetGUID()) == plr_list.end() && player->HaveAtClient(&i_object))
         {
-            i_object.BuildFieldsUpdate(player, i_updateDatas);
+            i_object.BuildFieldsUpdate(player, i_updateDatas, i_sharedBlocks);
             plr_list.insert(player->GetGUID());
         }
     }
@@ -3916,7 +3964,8 @@ void WorldObject::BuildUpdate(UpdateDataMapType& data_map)
     CellCoord p = Trinity::ComputeCellCoord(GetPositionX(), GetPositionY());
     Cell cell(p);
     cell.SetNoCreate();
-    WorldObjectChangeAccumulator notifier(*this, data_map);
+    SharedValuesUpdateCache sharedBlocks;
+    WorldObjectChangeAccumulator notifier(*this, data_map, HasTargetDependentChanges() ? nullptr : &sharedBlocks);
 
     //we must build packets for all visible players
     cell.Visit(p, Trinity::makeWorldVisitor(notifier), *GetMap(), *this, GetVisibilityRange());
@@ -4192,7 +4241,7 @@ void Object::Clear()
     delete[] _dynamicChangesArrayMask;
     _dynamicChangesArrayMask = nullptr;
 
-    _changesMask.clear();
+    _changesMask.Clear();
     _dynamicChangesMask.clear();
 }
 
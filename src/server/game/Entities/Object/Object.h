@@ -22,6 +22,7 @@
 #include "Common.h"
 #include "UpdateFields.h"
 #include "UpdateData.h"
+#include "UpdateMask.h"
 #include "ObjectDefines.h"
 #include "GridDefines.h"
 #include "Map.h"
@@ -99,10 +100,18 @@ struct ObjectInvisibility final
 
 typedef std::unordered_map<Player*, UpdateData> UpdateDataMapType;
 
-namespace UpdateMask
+// Values update block built once in a BuildUpdate pass and copied to every observer with the same visibility flags
+struct SharedValuesUpdateBlock
 {
-    typedef uint32 BlockType;
+    uint32 VisibleFlag;
+    uint32 DynamicVisibleFlag;
+    ByteBuffer Block;
+};
+
+typedef std::vector<SharedValuesUpdateBlock> SharedValuesUpdateCache;
 
+namespace UpdateMask
+{
     enum DynamicFieldChangeType : uint16
     {
         UNCHANGED               = 0,
@@ -310,7 +319,7 @@ class Object
         virtual bool hasInvolvedQuest(uint32 /* quest_id */) const { return false; }
         virtual void BuildUpdate(UpdateDataMapType&) {}
 
-        void BuildFieldsUpdate(Player*, UpdateDataMapType &) const;
+        void BuildFieldsUpdate(Player*, UpdateDataMapType &, SharedValuesUpdateCache* sharedBlocks = nullptr) const;
 
         void SetFieldNotifyFlag(uint16 flag) { _fieldNotifyFlags |= flag; }
         void RemoveFieldNotifyFlag(uint16 flag) { _fieldNotifyFlags &= ~flag; }
@@ -392,6 +401,10 @@ class Object
         void BuildMovementUpdate(ByteBuffer * data, uint16 flags) const;
         virtual void BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, Player* target) const;
         virtual void BuildDynamicValuesUpdate(uint8 updatetype, ByteBuffer* data, Player* target) const;
+        // Writes the update mask of a values block (changed fields) or creation block (non zero fields) for valCount fields
+        void BuildUpdateFieldMask(uint8 updateType, uint32 const* flags, uint32 visibleFlag, uint32 alwaysFlags, uint32 valCount, uint8* mask) const;
+        // true if a changed field is serialized differently per observer, the values block can't be shared then
+        virtual bool HasTargetDependentChanges() const;
 
         uint8 m_spawnMode;
 
@@ -409,7 +422,7 @@ class Object
 
         std::vector<uint32>* _dynamicValues;
 
-        std::vector<uint8> _changesMask;
+        UpdateMask::ChangesMask _changesMask;
         std::vector<UpdateMask::DynamicFieldChangeType> _dynamicChangesMask;
         std::vector<uint8>* _dynamicChangesArrayMask;
 
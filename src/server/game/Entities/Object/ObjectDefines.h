@@ -34,6 +34,7 @@
 #define DEFAULT_WORLD_OBJECT_SIZE   0.306f                  // player size, also currently used (correctly?) for any non Unit world objects
 #define MAGIC_RANGE                 30.0f
 #define GLOBAL_VISIBILITY_DISTANCE  1000.0f
+#define VISIBILITY_FULL_PASS_INTERVAL 10000                 // ms, incremental visibility passes of a player re-test every cell at least this often
 
 // used for creating values for respawn for example
 #define MAKE_PAIR64(l, h)  uint64(uint32(l) | (uint64(h) << 32))
@@ -21,6 +21,7 @@
 
 #include "ByteBuffer.h"
 #include "ObjectDefines.h"
+#include <boost/container/flat_set.hpp>
 #include <deque>
 #include <list>
 #include <set>
@@ -237,6 +238,7 @@ typedef std::list<ObjectGuid> GuidList;
 typedef std::deque<ObjectGuid> GuidDeque;
 typedef std::vector<ObjectGuid> GuidVector;
 typedef std::unordered_set<ObjectGuid> GuidUnorderedSet;
+typedef boost::container::flat_set<ObjectGuid> GuidFlatSet;
 typedef std::map<uint32, GuidSet> GuidSetInMap;
 typedef std::map<uint32, GuidList> GuidListInMap;
 typedef std::map<uint32, GuidVector> GuidVectorInMap;
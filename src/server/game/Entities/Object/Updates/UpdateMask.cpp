@@ -0,0 +1,148 @@
+/*
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "UpdateMask.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace
+{
+    using UpdateMask::BlockType;
+    using UpdateMask::BITS_PER_BLOCK;
+
+    // Bit i is set if values[i] shares a bit with filter, for a whole block of 32 fields
+    inline BlockType MatchBlock(uint32 const* values, uint32 filter)
+    {
+#if defined(__AVX2__)
+        __m256i const mask = _mm256_set1_epi32(int32(filter));
+        __m256i const zero = _mm256_setzero_si256();
+        BlockType result = 0;
+        for (uint32 i = 0; i < BITS_PER_BLOCK; i += 8)
+        {
+            __m256i v = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(values + i));
+            __m256i none = _mm256_cmpeq_epi32(_mm256_and_si256(v, mask), zero);
+            result |= BlockType(~_mm256_movemask_ps(_mm256_castsi256_ps(none)) & 0xFF) << i;
+        }
+        return result;
+#elif defined(__SSE2__)
+        __m128i const mask = _mm_set1_epi32(int32(filter));
+        __m128i const zero = _mm_setzero_si128();
+        BlockType result = 0;
+        for (uint32 i = 0; i < BITS_PER_BLOCK; i += 4)
+        {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<__m128i const*>(values + i));
+            __m128i none = _mm_cmpeq_epi32(_mm_and_si128(v, mask), zero);
+            result |= BlockType(~_mm_movemask_ps(_mm_castsi128_ps(none)) & 0xF) << i;
+        }
+        return result;
+#else
+        BlockType result = 0;
+        for (uint32 i = 0; i < BITS_PER_BLOCK; ++i)
+            if (values[i] & filter)
+                result |= BlockType(1) << i;
+        return result;
+#endif
+    }
+
+    // Last block of an array not ending on a block boundary, never reads past count
+    inline BlockType MatchPartialBlock(uint32 const* values, uint32 count, uint32 filter)
+    {
+        BlockType result = 0;
+        for (uint32 i = 0; i < count; ++i)
+            if (values[i] & filter)
+                result |= BlockType(1) << i;
+        return result;
+    }
+
+    inline BlockType Match(uint32 const* values, uint32 block, uint32 fieldCount, uint32 filter)
+    {
+        uint32 first = block * BITS_PER_BLOCK;
+        if (first + BITS_PER_BLOCK <= fieldCount)
+            return MatchBlock(values + first, filter);
+        return MatchPartialBlock(values + first, fieldCount - first, filter);
+    }
+
+    // Number of consecutive all zero blocks starting at block
+    inline uint32 SkipCleanBlocks(BlockType const* blocks, uint32 block, uint32 blockCount)
+    {
+        uint32 start = block;
+#if defined(__AVX2__)
+        for (; block + 8 <= blockCount; block += 8)
+        {
+            __m256i v = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(blocks + block));
+            if (!_mm256_testz_si256(v, v))
+                break;
+        }
+#elif defined(__SSE2__)
+        __m128i const zero = _mm_setzero_si128();
+        for (; block + 4 <= blockCount; block += 4)
+        {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<__m128i const*>(blocks + block));
+            if (_mm_movemask_epi8(_mm_cmpeq_epi32(v, zero)) != 0xFFFF)
+                break;
+        }
+#endif
+        while (block < blockCount && !blocks[block])
+            ++block;
+
+        return block - start;
+    }
+}
+
+void UpdateMask::BuildFieldMask(BlockType const* dirty, uint32 const* flags, uint32 fieldCount, uint32 visibleFlag, uint32 alwaysFlags, uint8* mask)
+{
+    uint32 blockCount = (fieldCount + BITS_PER_BLOCK - 1) / BITS_PER_BLOCK;
+
+    // fields sent regardless of changes, every block has to be looked at
+    if (alwaysFlags)
+    {
+        for (uint32 block = 0; block < blockCount; ++block)
+        {
+            BlockType bits = Match(flags, block, fieldCount, alwaysFlags);
+            if (dirty[block])
+                bits |= dirty[block] & Match(flags, block, fieldCount, visibleFlag);
+
+            if (bits)
+                SetBlock(mask, block, bits);
+        }
+        return;
+    }
+
+    for (uint32 block = SkipCleanBlocks(dirty, 0, blockCount); block < blockCount; block += 1 + SkipCleanBlocks(dirty, block + 1, blockCount))
+    {
+        // Match has no bits past fieldCount, dirty fields not sent to this target are dropped
+        if (BlockType bits = dirty[block] & Match(flags, block, fieldCount, visibleFlag))
+            SetBlock(mask, block, bits);
+    }
+}
+
+void UpdateMask::BuildCreateFieldMask(uint32 const* values, uint32 const* flags, uint32 fieldCount, uint32 visibleFlag, uint32 alwaysFlags, uint8* mask)
+{
+    uint32 blockCount = (fieldCount + BITS_PER_BLOCK - 1) / BITS_PER_BLOCK;
+
+    for (uint32 block = 0; block < blockCount; ++block)
+    {
+        BlockType bits = Match(values, block, fieldCount, 0xFFFFFFFF) & Match(flags, block, fieldCount, visibleFlag);
+        if (alwaysFlags)
+            bits |= Match(flags, block, fieldCount, alwaysFlags);
+
+        if (bits)
+            SetBlock(mask, block, bits);
+    }
+}
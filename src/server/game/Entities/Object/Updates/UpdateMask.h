@@ -0,0 +1,116 @@
+/*
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __UPDATEMASK_H
+#define __UPDATEMASK_H
+
+#include "ByteConverter.h"
+#include "Define.h"
+
+#include <atomic>
+#include <bit>
+#include <cstring>
+#include <vector>
+
+namespace UpdateMask
+{
+    typedef uint32 BlockType;
+
+    enum : uint32
+    {
+        BITS_PER_BLOCK = sizeof(BlockType) * 8
+    };
+
+    // Block of an update mask as written to the client (little endian)
+    inline BlockType GetBlock(uint8 const* mask, std::size_t block)
+    {
+        BlockType bits;
+        memcpy(&bits, mask + block * sizeof(BlockType), sizeof(BlockType));
+        EndianConvert(bits);
+        return bits;
+    }
+
+    inline void SetBlock(uint8* mask, std::size_t block, BlockType bits)
+    {
+        EndianConvert(bits);
+        memcpy(mask + block * sizeof(BlockType), &bits, sizeof(BlockType));
+    }
+
+    // Field index of the lowest set bit of a non zero block
+    inline uint16 GetLowestBitIndex(std::size_t block, BlockType bits)
+    {
+        return uint16(block * BITS_PER_BLOCK + std::countr_zero(bits));
+    }
+
+    /*
+     * Fills the update mask of a values block: fields with a dirty bit that share a flag with visibleFlag,
+     * plus every field sharing a flag with alwaysFlags. dirty and mask hold GetBlockCount(fieldCount) blocks, mask must be zeroed.
+     * Clean blocks are skipped with SSE2/AVX2 when available and the visibility test is done for 32 fields at once.
+     */
+    void BuildFieldMask(BlockType const* dirty, uint32 const* flags, uint32 fieldCount, uint32 visibleFlag, uint32 alwaysFlags, uint8* mask);
+
+    // Same for creation blocks, non zero values are dirty
+    void BuildCreateFieldMask(uint32 const* values, uint32 const* flags, uint32 fieldCount, uint32 visibleFlag, uint32 alwaysFlags, uint8* mask);
+
+    // Changed update fields of an object, one bit per field laid out like the client update mask
+    class ChangesMask
+    {
+    public:
+        ChangesMask() : _fieldCount(0) { }
+
+        void Resize(uint32 fieldCount)
+        {
+            _fieldCount = fieldCount;
+            _blocks.assign((fieldCount + BITS_PER_BLOCK - 1) / BITS_PER_BLOCK, 0);
+        }
+
+        void Clear()
+        {
+            _fieldCount = 0;
+            _blocks.clear();
+        }
+
+        // marks every field unchanged
+        void Reset()
+        {
+            if (!_blocks.empty())
+                memset(_blocks.data(), 0, _blocks.size() * sizeof(BlockType));
+        }
+
+        bool operator[](uint32 index) const
+        {
+            return (_blocks[index / BITS_PER_BLOCK] >> (index % BITS_PER_BLOCK)) & 1;
+        }
+
+        // Fields of one object may be set from several map threads, don't lose bits of the same block
+        void Set(uint32 index)
+        {
+            std::atomic_ref<BlockType>(_blocks[index / BITS_PER_BLOCK]).fetch_or(BlockType(1) << (index % BITS_PER_BLOCK), std::memory_order_relaxed);
+        }
+
+        void BuildFieldMask(uint32 const* flags, uint32 fieldCount, uint32 visibleFlag, uint32 alwaysFlags, uint8* mask) const
+        {
+            UpdateMask::BuildFieldMask(_blocks.data(), flags, fieldCount, visibleFlag, alwaysFlags, mask);
+        }
+
+        uint32 GetFieldCount() const { return _fieldCount; }
+
+    private:
+        std::vector<BlockType> _blocks;
+        uint32 _fieldCount;
+    };
+}
+
+#endif
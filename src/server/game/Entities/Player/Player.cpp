@@ -94,6 +94,7 @@
 #include "PetPackets.h"
 #include "Player.h"
 #include "PlayerDefines.h"
+#include "PlayerSaveBatch.h"
 #include "QueryHolder.h"
 #include "QuestData.h"
 #include "QuestDef.h"
@@ -222,6 +223,8 @@ m_achievementMgr(sf::safe_ptr<AchievementMgr<Player>>(this))
     NeedUpdateVisibility = false;
 
     m_nextSave = sWorld->getIntConfig(CONFIG_INTERVAL_SAVE);
+    m_lastSaveTime = 0;
+    m_saveExtraRows = 0;
 
     _resurrectionData = NULL;
 
@@ -5771,15 +5774,10 @@ void Player::_LoadSpellCooldowns(PreparedQueryResult result)
 
 void Player::_SaveSpellCooldowns(CharacterDatabaseTransaction& trans)
 {
-    CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CHAR_SPELL_COOLDOWN);
-    stmt->setUInt64(0, GetGUIDLow());
-    trans->Append(stmt);
-
     time_t curTime = time(NULL);
     time_t infTime = curTime + infinityCooldownDelayCheck;
 
-    bool first_round = true;
-    std::ostringstream ss;
+    PlayerSaveBatch cooldowns("INSERT INTO character_spell_cooldown (guid, spell, item, time) VALUES ");
 
     // remove outdated and save active
     for (SpellCooldowns::iterator itr = m_spellCooldowns.begin(); itr != m_spellCooldowns.end();)
@@ -5788,23 +5786,22 @@ void Player::_SaveSpellCooldowns(CharacterDatabaseTransaction& trans)
             m_spellCooldowns.erase(itr++);
         else if (itr->second.end <= infTime)                 // not save locked cooldowns, it will be reset or set at reload
         {
-            if (first_round)
-            {
-                ss << "INSERT INTO character_spell_cooldown (guid, spell, item, time) VALUES ";
-                first_round = false;
-            }
-            // next new/changed record prefix
-            else
-                ss << ',';
-            ss << '(' << GetGUIDLow() << ',' << itr->first << ',' << itr->second.itemid << ',' << uint64(itr->second.end) << ')';
+            cooldowns.AddRow(GetGUIDLow(), itr->first, itr->second.itemid, uint64(itr->second.end));
             ++itr;
         }
         else
             ++itr;
     }
-    // if something changed execute
-    if (!first_round)
-        trans->Append(ss.str().c_str());
+
+    if (!IsSaveSectionChanged(trans, PLAYER_SAVE_SECTION_SPELL_COOLDOWNS, cooldowns.GetHash(), cooldowns.GetRowCount()))
+        return;
+
+    CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CHAR_SPELL_COOLDOWN);
+    stmt->setUInt64(0, GetGUIDLow());
+    trans->Append(stmt);
+
+    cooldowns.AppendTo(trans);
+    m_saveExtraRows += cooldowns.GetRowCount() - cooldowns.GetStatementCount();
 }
 
 bool Player::HasChargesForSpell(SpellInfo const* spellInfo) const
@@ -7497,7 +7494,7 @@ void Player::RepopAtGraveyard(bool outInstance /*= false*/)
             RemoveAllAurasOnDeath();
             ResurrectPlayer(1.0f);
             SpawnCorpseBones();
-            SaveToDB();
+            RequestSave();
         });
     }
 }
@@ -8618,6 +8615,12 @@ void Player::SendDirectMessage(WorldPacket const* data) const
         m_session->SendPacket(data);
 }
 
+void Player::SendDirectMessage(SharedWorldPacket const& data) const
+{
+    if (!IsDelete() && m_session)
+        m_session->SendPacket(data);
+}
+
 void Player::SendCinematicStart(uint32 CinematicSequenceId)
 {
     WorldPackets::Misc::TriggerCinematic packet;
@@ -19940,7 +19943,7 @@ bool Player::SatisfyQuestStatus(Quest const* qInfo, bool msg)
 
 bool Player::SatisfyQuestConditions(Quest const* qInfo, bool msg)
 {
-    ConditionList conditions = sConditionMgr->GetConditionsForNotGroupedEntry(CONDITION_SOURCE_TYPE_QUEST_ACCEPT, qInfo->GetQuestId());
+    ConditionList const& conditions = sConditionMgr->GetConditionsForNotGroupedEntry(CONDITION_SOURCE_TYPE_QUEST_ACCEPT, qInfo->GetQuestId());
     if (!sConditionMgr->IsObjectMeetToConditions(this, conditions))
     {
         if (msg)
@@ -21469,12 +21472,11 @@ QuestGiverStatus Player::GetQuestDialogStatus(Object* questgiver)
         if (!quest)
             continue;
 
-        ConditionList conditions = sConditionMgr->GetConditionsForNotGroupedEntry(CONDITION_SOURCE_TYPE_QUEST_SHOW_MARK, quest->GetQuestId());
+        ConditionList const& conditions = sConditionMgr->GetConditionsForNotGroupedEntry(CONDITION_SOURCE_TYPE_QUEST_SHOW_MARK, quest->GetQuestId());
         if (!sConditionMgr->IsObjectMeetToConditions(this, conditions))
             continue;
 
-        conditions = sConditionMgr->GetConditionsForNotGroupedEntry(CONDITION_SOURCE_TYPE_QUEST_ACCEPT, quest->GetQuestId());
-        if (!sConditionMgr->IsObjectMeetToConditions(this, conditions))
+        if (!sConditionMgr->IsObjectMeetToConditions(this, sConditionMgr->GetConditionsForNotGroupedEntry(CONDITION_SOURCE_TYPE_QUEST_ACCEPT, quest->GetQuestId())))
             continue;
 
         switch (GetQuestStatus(questId))
@@ -21508,12 +21510,11 @@ QuestGiverStatus Player::GetQuestDialogStatus(Object* questgiver)
         if (!quest)
             continue;
 
-        ConditionList conditions = sConditionMgr->GetConditionsForNotGroupedEntry(CONDITION_SOURCE_TYPE_QUEST_SHOW_MARK, quest->GetQuestId());
+        ConditionList const& conditions = sConditionMgr->GetConditionsForNotGroupedEntry(CONDITION_SOURCE_TYPE_QUEST_SHOW_MARK, quest->GetQuestId());
         if (!sConditionMgr->IsObjectMeetToConditions(this, conditions))
             continue;
 
-        conditions = sConditionMgr->GetConditionsForNotGroupedEntry(CONDITION_SOURCE_TYPE_QUEST_ACCEPT, quest->GetQuestId());
-        if (!sConditionMgr->IsObjectMeetToConditions(this, conditions))
+        if (!sConditionMgr->IsObjectMeetToConditions(this, sConditionMgr->GetConditionsForNotGroupedEntry(CONDITION_SOURCE_TYPE_QUEST_ACCEPT, quest->GetQuestId())))
             continue;
 
         if (GetQuestStatus(questId) == QUEST_STATUS_NONE)
@@ -24910,6 +24911,40 @@ bool Player::_LoadHomeBind(PreparedQueryResult result)
 /***                   SAVE SYSTEM                     ***/
 /*********************************************************/
 
+PlayerSaveStatistics Player::SaveStatistics;
+
+void Player::RequestSave()
+{
+    uint32 window = sWorld->getIntConfig(CONFIG_PLAYER_SAVE_COALESCE_WINDOW);
+    uint32 sinceLastSave = GetMSTimeDiffToNow(m_lastSaveTime);
+    if (!m_lastSaveTime || sinceLastSave >= window)
+    {
+        SaveToDB();
+        return;
+    }
+
+    // the next autosave picks up everything changed until then
+    m_nextSave = std::min(m_nextSave, std::max<uint32>(window - sinceLastSave, 1));
+    ++SaveStatistics.CoalescedSaves;
+}
+
+// A section is only skipped when the transaction that last wrote the same content committed: a save still in
+// flight or rolled back is written again, as every save did before sections were compared
+bool Player::IsSaveSectionChanged(CharacterDatabaseTransaction& trans, PlayerSaveSection section, uint64 hash, uint32 rows)
+{
+    SavedSection& saved = m_savedSections[section];
+    if (saved.Hash == hash && saved.CommitState && saved.CommitState->load(std::memory_order_acquire) == TRANSACTION_COMMIT_SUCCEEDED)
+    {
+        ++SaveStatistics.SkippedSections[section];
+        return false;
+    }
+
+    saved.Hash = hash;
+    saved.CommitState = trans->GetCommitState();
+    SaveStatistics.SectionRows[section] += rows;
+    return true;
+}
+
 void Player::SaveToDB(bool create /*=false*/)
 {
     // delay auto save at any saves (manual, in code, or autosave)
@@ -24922,6 +24957,10 @@ void Player::SaveToDB(bool create /*=false*/)
         return;
     }
 
+    m_lastSaveTime = getMSTime();
+    if (!m_lastSaveTime)
+        m_lastSaveTime = 1;
+
     if (m_operationsAfterDelayMask & OAD_ARENA_DESERTER)
         HandleArenaDeserter();
 
@@ -24931,28 +24970,6 @@ void Player::SaveToDB(bool create /*=false*/)
     TC_LOG_DEBUG("entities.unit", "The value of player %s at save: ", m_name.c_str());
     outDebugValues();
 
-    if (m_vis)
-    {
-        std::ostringstream ps;
-        ps << "REPLACE INTO character_visuals (guid, head, shoulders, chest, waist, legs, feet, wrists, hands, back, main, off, ranged, tabard, shirt) VALUES ("
-            << GetGUIDLow() << ", "
-            << m_vis->m_visHead << ", "
-            << m_vis->m_visShoulders << ", "
-            << m_vis->m_visChest << ", "
-            << m_vis->m_visWaist << ", "
-            << m_vis->m_visLegs << ", "
-            << m_vis->m_visFeet << ", "
-            << m_vis->m_visWrists << ", "
-            << m_vis->m_visHands << ", "
-            << m_vis->m_visBack << ", "
-            << m_vis->m_visMainhand << ", "
-            << m_vis->m_visOffhand << ", "
-            << m_vis->m_visRanged << ", "
-            << m_vis->m_visTabard << ", "
-            << m_vis->m_visShirt << ")";
-        CharacterDatabase.Execute(ps.str().c_str());
-    }
-
     CharacterDatabasePreparedStatement* stmt = NULL;
     uint8 index = 0;
 
@@ -25219,8 +25236,10 @@ void Player::SaveToDB(bool create /*=false*/)
     }
 
     CharacterDatabaseTransaction trans = CharacterDatabase.BeginTransaction();
+    m_saveExtraRows = 0;
 
     trans->Append(stmt);
+    _SaveVisuals(trans);
 
     if (m_mailsUpdated)                                     //save mails only when needed
         _SaveMail(trans);
@@ -25267,6 +25286,13 @@ void Player::SaveToDB(bool create /*=false*/)
     _SaveArmyTrainingInfo(trans);
     _SaveAccountProgress(trans);
 
+    uint32 rows = uint32(trans->GetSize()) + m_saveExtraRows;
+    ++SaveStatistics.Saves;
+    SaveStatistics.Statements += trans->GetSize();
+    SaveStatistics.Rows += rows;
+    for (uint32 max = SaveStatistics.MaxRows.load(std::memory_order_relaxed); rows > max && !SaveStatistics.MaxRows.compare_exchange_weak(max, rows);)
+        ;
+
     CharacterDatabase.CommitTransaction(trans);
 
     // TODO: Move this out
@@ -25573,12 +25599,8 @@ void Player::_SaveActions(CharacterDatabaseTransaction& trans)
 
 void Player::_SaveAuras(CharacterDatabaseTransaction& trans)
 {
-    CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CHAR_AURA);
-    stmt->setUInt64(0, GetGUIDLow());
-    trans->Append(stmt);
-    stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CHAR_AURA_EFFECT);
-    stmt->setUInt64(0, GetGUIDLow());
-    trans->Append(stmt);
+    PlayerSaveBatch auras("INSERT INTO character_aura (guid, slot, caster_guid, item_guid, spell, effect_mask, recalculate_mask, stackcount, maxduration, remaintime, remaincharges) VALUES ");
+    PlayerSaveBatch effects("INSERT INTO character_aura_effect (guid, slot, effect, baseamount, amount) VALUES ");
 
     for (AuraMap::const_iterator itr = m_ownedAuras.begin(); itr != m_ownedAuras.end(); ++itr)
     {
@@ -25590,22 +25612,13 @@ void Player::_SaveAuras(CharacterDatabaseTransaction& trans)
         if(!foundAura)
             continue;
 
-        uint8 index = 0;
         uint32 effMask = 0;
         uint32 recalculateMask = 0;
         for (uint8 i = 0; i < MAX_SPELL_EFFECTS; ++i)
         {
             if (AuraEffect const* effect = aura->GetEffect(i))
             {
-                index = 0;
-                stmt = CharacterDatabase.GetPreparedStatement(CHAR_INS_AURA_EFFECT);
-                stmt->setUInt64(index++, GetGUIDLow());
-                stmt->setUInt8(index++, foundAura->GetSlot());
-                stmt->setUInt8(index++, i);
-                stmt->setInt32(index++, effect->GetBaseAmount());
-                stmt->setInt32(index++, effect->GetAmount());
-
-                trans->Append(stmt);
+                effects.AddRow(GetGUIDLow(), foundAura->GetSlot(), i, effect->GetBaseAmount(), effect->GetAmount());
 
                 effMask |= 1 << i;
                 if (effect->CanBeRecalculated())
@@ -25613,21 +25626,37 @@ void Player::_SaveAuras(CharacterDatabaseTransaction& trans)
             }
         }
 
-        index = 0;
-        stmt = CharacterDatabase.GetPreparedStatement(CHAR_INS_AURA);
-        stmt->setUInt64(index++, GetGUIDLow());
-        stmt->setUInt8(index++, foundAura->GetSlot());
-        stmt->setBinary(index++, itr->second->GetCasterGUID().GetRawValue());
-        stmt->setBinary(index++, itr->second->GetCastItemGUID().GetRawValue());
-        stmt->setUInt32(index++, itr->second->GetId());
-        stmt->setUInt16(index++, effMask);
-        stmt->setUInt8(index++, recalculateMask);
-        stmt->setUInt8(index++, itr->second->GetStackAmount());
-        stmt->setInt32(index++, itr->second->GetMaxDuration());
-        stmt->setInt32(index++, itr->second->GetDuration());
-        stmt->setUInt8(index, itr->second->GetCharges());
-        trans->Append(stmt);
+        auras.AddRow(GetGUIDLow(), foundAura->GetSlot(), aura->GetCasterGUID().GetRawValue(), aura->GetCastItemGUID().GetRawValue(), aura->GetId(),
+            uint16(effMask), uint8(recalculateMask), aura->GetStackAmount(), aura->GetMaxDuration(), aura->GetDuration(), aura->GetCharges());
     }
+
+    uint32 rows = auras.GetRowCount() + effects.GetRowCount();
+    if (!IsSaveSectionChanged(trans, PLAYER_SAVE_SECTION_AURAS, PlayerSaveBatch::CombineHash(auras.GetHash(), effects.GetHash()), rows))
+        return;
+
+    CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CHAR_AURA);
+    stmt->setUInt64(0, GetGUIDLow());
+    trans->Append(stmt);
+    stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CHAR_AURA_EFFECT);
+    stmt->setUInt64(0, GetGUIDLow());
+    trans->Append(stmt);
+
+    auras.AppendTo(trans);
+    effects.AppendTo(trans);
+    m_saveExtraRows += rows - auras.GetStatementCount() - effects.GetStatementCount();
+}
+
+void Player::_SaveVisuals(CharacterDatabaseTransaction& trans)
+{
+    if (!m_vis)
+        return;
+
+    PlayerSaveBatch visuals("REPLACE INTO character_visuals (guid, head, shoulders, chest, waist, legs, feet, wrists, hands, back, main, off, ranged, tabard, shirt) VALUES ");
+    visuals.AddRow(GetGUIDLow(), m_vis->m_visHead, m_vis->m_visShoulders, m_vis->m_visChest, m_vis->m_visWaist, m_vis->m_visLegs, m_vis->m_visFeet, m_vis->m_visWrists,
+        m_vis->m_visHands, m_vis->m_visBack, m_vis->m_visMainhand, m_vis->m_visOffhand, m_vis->m_visRanged, m_vis->m_visTabard, m_vis->m_visShirt);
+
+    if (IsSaveSectionChanged(trans, PLAYER_SAVE_SECTION_VISUALS, visuals.GetHash(), visuals.GetRowCount()))
+        visuals.AppendTo(trans);
 }
 
 void Player::_SaveInventory(CharacterDatabaseTransaction& trans)
@@ -27044,7 +27073,7 @@ void Player::VehicleSpellInitialize()
             continue;
         }
 
-        ConditionList conditions = sConditionMgr->GetConditionsForVehicleSpell(vehicle->GetEntry(), spellId);
+        ConditionList const& conditions = sConditionMgr->GetConditionsForVehicleSpell(vehicle->GetEntry(), spellId);
         if (!sConditionMgr->IsObjectMeetToConditions(this, vehicle, conditions))
         {
             TC_LOG_DEBUG("condition", "VehicleSpellInitialize: conditions not met for Vehicle entry %u spell %u", vehicle->ToCreature()->GetEntry(), spellId);
@@ -29718,13 +29747,33 @@ template void Player::UpdateVisibilityOf(DynamicObject* target, UpdateData& data
 template void Player::UpdateVisibilityOf(AreaTrigger*   target, UpdateData& data, std::set<Unit*>& visibleNow);
 template void Player::UpdateVisibilityOf(Conversation*  target, UpdateData& data, std::set<Unit*>& visibleNow);
 
-void Player::UpdateVisibilityForPlayer()
+void Player::UpdateVisibilityForPlayer(bool incremental /*= false*/)
 {
     if (!m_seer)
         return;
 
+    // an incremental pass only skips cells when nothing but the cell membership can have changed since the last full pass
+    VisibilityPassSnapshot& snapshot = m_visibilitySnapshot;
+    bool samePointOfView = incremental && snapshot.Valid && snapshot.Seer == m_seer->GetGUID() && snapshot.MapId == GetMapId() && snapshot.InstanceId == GetInstanceId()
+        && snapshot.X == m_seer->GetPositionX() && snapshot.Y == m_seer->GetPositionY() && snapshot.Z == m_seer->GetPositionZ() && snapshot.Range == GetSightRange()
+        && GetMSTimeDiffToNow(snapshot.FullPassTime) < VISIBILITY_FULL_PASS_INTERVAL;
+
+    if (!samePointOfView)
+    {
+        snapshot.CellVersions.clear();
+        snapshot.Seer = m_seer->GetGUID();
+        snapshot.MapId = GetMapId();
+        snapshot.InstanceId = GetInstanceId();
+        snapshot.X = m_seer->GetPositionX();
+        snapshot.Y = m_seer->GetPositionY();
+        snapshot.Z = m_seer->GetPositionZ();
+        snapshot.Range = GetSightRange();
+        snapshot.FullPassTime = getMSTime();
+        snapshot.Valid = true;
+    }
+
     // updates visibility of all objects around point of view for current player
-    Trinity::VisibleNotifier notifier(*this);
+    Trinity::VisibleNotifier notifier(*this, &snapshot.CellVersions, samePointOfView);
     notifier.AddMaxVisible();   // add global object, need first
     Trinity::VisitNearbyObject(m_seer, GetSightRange(), notifier);
     notifier.SendToSelf();   // send gathered data
@@ -30983,7 +31032,7 @@ void Player::UpdateForQuestWorldObjects()
 
     UpdateData udata(GetMapId());
     WorldPacket packet;
-    for (GuidSet::const_iterator itr = m_clientGUIDs.begin(), next; itr != m_clientGUIDs.end(); itr = next)
+    for (GuidFlatSet::const_iterator itr = m_clientGUIDs.begin(), next; itr != m_clientGUIDs.end(); itr = next)
     {
         next = itr;
         ++next;
@@ -31009,7 +31058,7 @@ void Player::UpdateForQuestWorldObjects()
                 {
                     //! This code doesn't look right, but it was logically converted to condition system to do the exact
                     //! same thing it did before. It definitely needs to be overlooked for intended functionality.
-                    ConditionList conds = sConditionMgr->GetConditionsForSpellClickEvent(obj->GetEntry(), _itr->second.spellId);
+                    ConditionList const& conds = sConditionMgr->GetConditionsForSpellClickEvent(obj->GetEntry(), _itr->second.spellId);
 
                     for (ConditionList::const_iterator jtr = conds.begin(); jtr != conds.end() && !buildUpdateBlock; ++jtr)
                         if ((*jtr)->ConditionType == CONDITION_QUESTREWARDED || (*jtr)->ConditionType == CONDITION_QUESTTAKEN)
@@ -33497,7 +33546,7 @@ bool Player::canSeeSpellClickOn(Creature const* c) const
             continue;
         }
 
-        ConditionList conds = sConditionMgr->GetConditionsForSpellClickEvent(c->GetEntry(), itr->second.spellId);
+        ConditionList const& conds = sConditionMgr->GetConditionsForSpellClickEvent(c->GetEntry(), itr->second.spellId);
         ConditionSourceInfo info = ConditionSourceInfo(const_cast<Player*>(this), const_cast<Creature*>(c));
         if (!sConditionMgr->IsObjectMeetToConditions(info, conds))
         {
@@ -33693,24 +33742,13 @@ void Player::_SaveEquipmentSets(CharacterDatabaseTransaction& trans)
 
 void Player::_SaveBGData(CharacterDatabaseTransaction& trans)
 {
-    CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_PLAYER_BGDATA);
-    stmt->setUInt64(0, GetGUIDLow());
-    trans->Append(stmt);
-    /* guid, bgInstanceID, bgTeam, x, y, z, o, map, taxi[0], taxi[1], mountSpell */
-    stmt = CharacterDatabase.GetPreparedStatement(CHAR_INS_PLAYER_BGDATA);
-    stmt->setUInt64(0, GetGUIDLow());
-    stmt->setUInt32(1, m_bgData.BgInstanceID);
-    stmt->setUInt16(2, m_bgData.BgTeam);
-    stmt->setFloat (3, m_bgData.JoinPosition.GetPositionX());
-    stmt->setFloat (4, m_bgData.JoinPosition.GetPositionY());
-    stmt->setFloat (5, m_bgData.JoinPosition.GetPositionZ());
-    stmt->setFloat (6, m_bgData.JoinPosition.GetOrientation());
-    stmt->setUInt16(7, m_bgData.JoinPosition.GetMapId());
-    stmt->setUInt16(8, m_bgData.TaxiPath[0]);
-    stmt->setUInt16(9, m_bgData.TaxiPath[1]);
-    stmt->setUInt16(10, m_bgData.MountSpellID);
-    stmt->setUInt16(11, m_bgData.LastActiveSpecID);
-    trans->Append(stmt);
+    PlayerSaveBatch data("REPLACE INTO character_battleground_data (guid, instanceId, team, joinX, joinY, joinZ, joinO, joinMapId, taxiStart, taxiEnd, mountSpell, lastActiveSpec) VALUES ");
+    data.AddRow(GetGUIDLow(), m_bgData.BgInstanceID, uint16(m_bgData.BgTeam), m_bgData.JoinPosition.GetPositionX(), m_bgData.JoinPosition.GetPositionY(),
+        m_bgData.JoinPosition.GetPositionZ(), m_bgData.JoinPosition.GetOrientation(), uint16(m_bgData.JoinPosition.GetMapId()), uint16(m_bgData.TaxiPath[0]),
+        uint16(m_bgData.TaxiPath[1]), uint16(m_bgData.MountSpellID), uint16(m_bgData.LastActiveSpecID));
+
+    if (IsSaveSectionChanged(trans, PLAYER_SAVE_SECTION_BG_DATA, data.GetHash(), data.GetRowCount()))
+        data.AppendTo(trans);
 }
 
 void Player::DeleteEquipmentSet(uint64 setGuid)
@@ -33803,24 +33841,21 @@ void Player::_LoadGlyphs(PreparedQueryResult result)
 
 void Player::_SaveGlyphs(CharacterDatabaseTransaction& trans)
 {
-    CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CHAR_GLYPHS);
-    stmt->setUInt64(0, GetGUID().GetCounter());
-    trans->Append(stmt);
+    PlayerSaveBatch glyphs("INSERT INTO character_glyphs VALUES ");
 
     for (uint8 spec = 0; spec < MAX_SPECIALIZATIONS; ++spec)
-    {
         for (uint32 glyphId : GetGlyphs(spec))
-        {
-            uint8 index = 0;
+            glyphs.AddRow(GetGUID().GetCounter(), spec, uint16(glyphId));
 
-            stmt = CharacterDatabase.GetPreparedStatement(CHAR_INS_CHAR_GLYPHS);
-            stmt->setUInt64(index++, GetGUID().GetCounter());
-            stmt->setUInt8(index++, spec);
-            stmt->setUInt16(index++, uint16(glyphId));
+    if (!IsSaveSectionChanged(trans, PLAYER_SAVE_SECTION_GLYPHS, glyphs.GetHash(), glyphs.GetRowCount()))
+        return;
 
-            trans->Append(stmt);
-        }
-    }
+    CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CHAR_GLYPHS);
+    stmt->setUInt64(0, GetGUID().GetCounter());
+    trans->Append(stmt);
+
+    glyphs.AppendTo(trans);
+    m_saveExtraRows += glyphs.GetRowCount() - glyphs.GetStatementCount();
 }
 
 void Player::_LoadTalents(PreparedQueryResult result, PreparedQueryResult result2)
@@ -33844,37 +33879,24 @@ void Player::_LoadTalents(PreparedQueryResult result, PreparedQueryResult result
 
 void Player::_SaveTalents(CharacterDatabaseTransaction& trans)
 {
-    CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CHAR_TALENT);
-    stmt->setUInt64(0, GetGUIDLow());
-    trans->Append(stmt);
+    PlayerSaveBatch talents("INSERT INTO character_talent (guid, talent, spec) VALUES ");
+    PlayerSaveBatch pvpTalents("INSERT INTO character_pvp_talent (guid, talent, spec) VALUES ");
 
-    PlayerTalentMap* talents = nullptr;
     for (uint8 group = 0; group < MAX_SPECIALIZATIONS; ++group)
     {
-        talents = GetTalentMap(group);
-        for (PlayerTalentMap::iterator itr = talents->begin(); itr != talents->end();)
+        PlayerTalentMap* talentMap = GetTalentMap(group);
+        for (PlayerTalentMap::iterator itr = talentMap->begin(); itr != talentMap->end();)
         {
             if (itr->second == PLAYERSPELL_REMOVED)
             {
-                itr = talents->erase(itr);
+                itr = talentMap->erase(itr);
                 continue;
             }
 
-            stmt = CharacterDatabase.GetPreparedStatement(CHAR_INS_CHAR_TALENT);
-            stmt->setUInt64(0, GetGUIDLow());
-            stmt->setUInt32(1, itr->first);
-            stmt->setUInt8(2, group);
-            trans->Append(stmt);
+            talents.AddRow(GetGUIDLow(), itr->first, group);
             ++itr;
         }
-    }
-
-    stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CHAR_TALENT_PVP);
-    stmt->setUInt64(0, GetGUIDLow());
-    trans->Append(stmt);
 
-    for (uint8 group = 0; group < MAX_SPECIALIZATIONS; ++group)
-    {
         PlayerPvPTalentMap* talentPvps = GetPvPTalentMap(group);
         for (PlayerPvPTalentMap::iterator itr = talentPvps->begin(); itr != talentPvps->end();)
         {
@@ -33884,14 +33906,26 @@ void Player::_SaveTalents(CharacterDatabaseTransaction& trans)
                 continue;
             }
 
-            stmt = CharacterDatabase.GetPreparedStatement(CHAR_INS_CHAR_TALENT_PVP);
-            stmt->setUInt64(0, GetGUIDLow());
-            stmt->setUInt32(1, itr->first);
-            stmt->setUInt8(2, group);
-            trans->Append(stmt);
+            pvpTalents.AddRow(GetGUIDLow(), itr->first, group);
             ++itr;
         }
     }
+
+    uint32 rows = talents.GetRowCount() + pvpTalents.GetRowCount();
+    if (!IsSaveSectionChanged(trans, PLAYER_SAVE_SECTION_TALENTS, PlayerSaveBatch::CombineHash(talents.GetHash(), pvpTalents.GetHash()), rows))
+        return;
+
+    CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CHAR_TALENT);
+    stmt->setUInt64(0, GetGUIDLow());
+    trans->Append(stmt);
+    talents.AppendTo(trans);
+
+    stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CHAR_TALENT_PVP);
+    stmt->setUInt64(0, GetGUIDLow());
+    trans->Append(stmt);
+    pvpTalents.AppendTo(trans);
+
+    m_saveExtraRows += rows - talents.GetStatementCount() - pvpTalents.GetStatementCount();
 }
 
 void Player::ActivateTalentGroup(ChrSpecializationEntry const* spec)
@@ -37047,7 +37081,7 @@ void Player::ChaeckSeamlessTeleport(uint32 newZoneOrArea, bool isArea)
             }
             else if (to && !from)
             {
-                ConditionList conditions = sConditionMgr->GetConditionsForNotGroupedEntry(CONDITION_SOURCE_TYPE_SEAMLESS_TELEPORT, to->ToMapID);
+                ConditionList const& conditions = sConditionMgr->GetConditionsForNotGroupedEntry(CONDITION_SOURCE_TYPE_SEAMLESS_TELEPORT, to->ToMapID);
                 if (sConditionMgr->IsObjectMeetToConditions(this, conditions))
                     if (GetMapId() != to->ToMapID)
                         TeleportTo(to->ToMapID, GetPositionX(), GetPositionY(), GetPositionZ(), GetOrientation(), TELE_TO_SEAMLESS);
@@ -37074,7 +37108,7 @@ void Player::ChaeckSeamlessTeleport(uint32 newZoneOrArea, bool isArea)
             }
             else if (to && !from)
             {
-                ConditionList conditions = sConditionMgr->GetConditionsForNotGroupedEntry(CONDITION_SOURCE_TYPE_SEAMLESS_TELEPORT, to->ToMapID);
+                ConditionList const& conditions = sConditionMgr->GetConditionsForNotGroupedEntry(CONDITION_SOURCE_TYPE_SEAMLESS_TELEPORT, to->ToMapID);
                 if (sConditionMgr->IsObjectMeetToConditions(this, conditions))
                     if (GetMapId() != to->ToMapID)
                         TeleportTo(to->ToMapID, GetPositionX(), GetPositionY(), GetPositionZ(), GetOrientation(), TELE_TO_SEAMLESS);
@@ -37399,7 +37433,7 @@ void Player::RemoveClient(ObjectGuid guid)
     i_clientGUIDLock.unlock();
 }
 
-GuidSet& Player::GetClient()
+GuidFlatSet& Player::GetClient()
 {
     return m_clientGUIDs;
 }
@@ -37408,6 +37442,7 @@ void Player::ClearClient()
 {
     i_clientGUIDLock.lock();
     m_clientGUIDs.clear();
+    m_visibilitySnapshot.Valid = false;
     i_clientGUIDLock.unlock();
 }
 
@@ -38531,6 +38566,7 @@ void Player::Clear()
     _researchSites.clear();
     _completedProjects.clear();
     m_clientGUIDs.clear();
+    m_visibilitySnapshot.Valid = false;
     m_extraLookList.clear();
     m_DFQuests.clear();
     for (uint8 i = 0; i < MAX_BOUND; ++i)
@@ -38955,15 +38991,15 @@ void Player::_SaveDeathMatchStats(CharacterDatabaseTransaction& trans)
 
 void Player::_SaveChatLogos(CharacterDatabaseTransaction& trans)
 {
+    PlayerSaveBatch logos("REPLACE INTO character_chat_logos (guid, buyed_logo, active) VALUES ");
     for (auto& pair : buyed_chat_logos)
-    {
-        uint8 index = 0;
-        auto stmt = CharacterDatabase.GetPreparedStatement(CHAR_REP_PLAYER_CHAT_LOGOS);
-        stmt->setUInt64(index++, GetGUIDLow());
-        stmt->setString(index++, pair.first);
-        stmt->setBool(index++, pair.second);
-        trans->Append(stmt);
-    }
+        logos.AddRow(GetGUIDLow(), pair.first, pair.second);
+
+    if (!IsSaveSectionChanged(trans, PLAYER_SAVE_SECTION_CHAT_LOGOS, logos.GetHash(), logos.GetRowCount()))
+        return;
+
+    logos.AppendTo(trans);
+    m_saveExtraRows += logos.GetRowCount() - logos.GetStatementCount();
 }
 
 void Player::_SaveArmyTrainingInfo(CharacterDatabaseTransaction& trans)
@@ -46,6 +46,8 @@
 #include "../../Vignette/VignetteMgr.h"
 #include "EquipementSet.h"
 #include "LogsSystem.h"
+#include <array>
+#include <atomic>
 #include <queue>
 
 class SpectatorAddonMsg;
@@ -1016,6 +1018,31 @@ enum PlayerLoginQueryIndex
     MAX_PLAYER_LOGIN_QUERY
 };
 
+// Sections rewriting their whole row set at every save, skipped while their rows didn't change
+enum PlayerSaveSection
+{
+    PLAYER_SAVE_SECTION_VISUALS,
+    PLAYER_SAVE_SECTION_BG_DATA,
+    PLAYER_SAVE_SECTION_AURAS,
+    PLAYER_SAVE_SECTION_SPELL_COOLDOWNS,
+    PLAYER_SAVE_SECTION_TALENTS,
+    PLAYER_SAVE_SECTION_GLYPHS,
+    PLAYER_SAVE_SECTION_CHAT_LOGOS,
+
+    MAX_PLAYER_SAVE_SECTIONS
+};
+
+struct PlayerSaveStatistics
+{
+    std::atomic<uint64> Saves;
+    std::atomic<uint64> CoalescedSaves;                    // save requests merged into a pending save
+    std::atomic<uint64> Statements;
+    std::atomic<uint64> Rows;                               // statements plus the rows folded into multi-row inserts
+    std::atomic<uint32> MaxRows;                            // largest single save
+    std::atomic<uint64> SkippedSections[MAX_PLAYER_SAVE_SECTIONS];
+    std::atomic<uint64> SectionRows[MAX_PLAYER_SAVE_SECTIONS];
+};
+
 enum PlayerDelayedOperations
 {
     DELAYED_SAVE_PLAYER         = 0x001,
@@ -1453,6 +1480,23 @@ struct ArmyTrainingInfo
     bool needSave = false;
 };
 
+// Point of view of the last full visibility pass and the membership version of every cell container it tested.
+// A pass from the same point of view only re-tests the containers whose membership changed since then,
+// objects changing inside a cell update their own visibility through VisibleChangesNotifier.
+struct VisibilityPassSnapshot
+{
+    std::unordered_map<void const*, uint64> CellVersions;
+    ObjectGuid Seer;
+    uint32 MapId = 0;
+    uint32 InstanceId = 0;
+    float X = 0.0f;
+    float Y = 0.0f;
+    float Z = 0.0f;
+    float Range = 0.0f;
+    uint32 FullPassTime = 0;
+    bool Valid = false;
+};
+
 typedef sf::safe_ptr<AchievementMgr<Player>> AchievementPtr;
 
 class Player : public Unit, public GridObject<Player>
@@ -2071,6 +2115,9 @@ class Player : public Unit, public GridObject<Player>
         /*********************************************************/
 
         void SaveToDB(bool create = false);
+        // SaveToDB unless the player was saved less than PlayerSave.CoalesceWindow ago, then the save is moved up to the end of the window
+        void RequestSave();
+        static PlayerSaveStatistics SaveStatistics;
         void SaveInventoryAndGoldToDB(CharacterDatabaseTransaction& trans);                    // fast save function for item/money cheating preventing
         void SaveGoldToDB(CharacterDatabaseTransaction& trans);
 
@@ -2732,6 +2779,7 @@ class Player : public Unit, public GridObject<Player>
         void SetLastWorldStateUpdateTime(time_t _time) { m_lastWSUpdateTime = _time; };
         
         void SendDirectMessage(WorldPacket const* data) const;
+        void SendDirectMessage(SharedWorldPacket const& data) const;
 
         void SendAurasForTarget(Unit* target);
         void SendSpellHistoryData();
@@ -2914,7 +2962,8 @@ class Player : public Unit, public GridObject<Player>
 
         bool CanSummonPet(uint32 entry) const;
         // currently visible objects at player client
-        GuidSet m_clientGUIDs;
+        GuidFlatSet m_clientGUIDs;
+        VisibilityPassSnapshot m_visibilitySnapshot;
         GuidSet m_extraLookList;
         sf::contention_free_shared_mutex< > i_clientGUIDLock;
         std::recursive_mutex i_killMapLock;
@@ -2923,7 +2972,7 @@ class Player : public Unit, public GridObject<Player>
         bool HaveAtClient(WorldObject const* u);
         void AddClient(ObjectGuid guid);
         void RemoveClient(ObjectGuid guid);
-        GuidSet& GetClient();
+        GuidFlatSet& GetClient();
         void ClearClient();
 
         // some hack :( now impossible implemented correct build of object update packet
@@ -2939,7 +2988,7 @@ class Player : public Unit, public GridObject<Player>
         bool IsVisibleGloballyFor(Player const* player) const;
 
         void SendInitialVisiblePackets(Unit* target);
-        void UpdateVisibilityForPlayer();
+        void UpdateVisibilityForPlayer(bool incremental = false);
         void UpdateVisibilityOf(WorldObject* target);
         void UpdateTriggerVisibility();
         void UpdateCustomField();
@@ -3376,6 +3425,7 @@ class Player : public Unit, public GridObject<Player>
 
         void _SaveActions(CharacterDatabaseTransaction& trans);
         void _SaveAuras(CharacterDatabaseTransaction& trans);
+        void _SaveVisuals(CharacterDatabaseTransaction& trans);
         void _SaveInventory(CharacterDatabaseTransaction& trans);
         void _SaveVoidStorage(CharacterDatabaseTransaction& trans);
         void _SaveMail(CharacterDatabaseTransaction& trans);
@@ -3421,6 +3471,15 @@ class Player : public Unit, public GridObject<Player>
 
         uint32 m_team;
         uint32 m_nextSave;
+        uint32 m_lastSaveTime;                              // getMSTime of the last SaveToDB
+        uint32 m_saveExtraRows;                             // rows of the running save written by multi-row inserts beyond one per statement
+        struct SavedSection
+        {
+            uint64 Hash = 0;
+            std::shared_ptr<std::atomic<uint8>> CommitState;    // TransactionCommitState of the transaction that wrote Hash
+        };
+        std::array<SavedSection, MAX_PLAYER_SAVE_SECTIONS> m_savedSections;
+        bool IsSaveSectionChanged(CharacterDatabaseTransaction& trans, PlayerSaveSection section, uint64 hash, uint32 rows);
         time_t m_speakTime;
         uint32 m_speakCount;
         Difficulty m_dungeonDifficulty;
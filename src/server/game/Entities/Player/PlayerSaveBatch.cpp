@@ -0,0 +1,138 @@
+/*
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "PlayerSaveBatch.h"
+#include "DatabaseEnv.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+
+PlayerSaveBatch::PlayerSaveBatch(char const* head, uint32 maxRows /*= 256*/) : _head(head), _maxRows(std::max<uint32>(maxRows, 1)),
+    _pendingRows(0), _rowCount(0), _rowStart(0), _firstValue(true), _hash(0xCBF29CE484222325ULL)
+{
+}
+
+uint32 PlayerSaveBatch::AppendTo(CharacterDatabaseTransaction& trans)
+{
+    for (std::string const& statement : _statements)
+        trans->Append(statement.c_str());
+
+    if (_pendingRows)
+        trans->Append(_current.c_str());
+
+    return _rowCount;
+}
+
+void PlayerSaveBatch::BeginRow()
+{
+    if (_pendingRows == _maxRows)
+    {
+        _statements.push_back(std::move(_current));
+        _current.clear();
+        _pendingRows = 0;
+    }
+
+    if (!_pendingRows)
+        _current = _head;
+    else
+        _current += ',';
+
+    _rowStart = _current.size();
+    _current += '(';
+    _firstValue = true;
+}
+
+void PlayerSaveBatch::EndRow()
+{
+    _current += ')';
+
+    for (std::size_t i = _rowStart; i < _current.size(); ++i)
+    {
+        _hash ^= uint8(_current[i]);
+        _hash *= 0x100000001B3ULL;
+    }
+
+    ++_pendingRows;
+    ++_rowCount;
+}
+
+void PlayerSaveBatch::Separate()
+{
+    if (!_firstValue)
+        _current += ',';
+    _firstValue = false;
+}
+
+void PlayerSaveBatch::AppendInteger(int64 value)
+{
+    Separate();
+    char buffer[24];
+    _current.append(buffer, std::to_chars(buffer, buffer + sizeof(buffer), value).ptr);
+}
+
+void PlayerSaveBatch::AppendUnsigned(uint64 value)
+{
+    Separate();
+    char buffer[24];
+    _current.append(buffer, std::to_chars(buffer, buffer + sizeof(buffer), value).ptr);
+}
+
+void PlayerSaveBatch::AppendValue(float value)
+{
+    Separate();
+    if (!std::isfinite(value))
+        value = 0.0f;
+
+    // shortest text reading back as the same float
+    char buffer[32];
+    _current.append(buffer, std::to_chars(buffer, buffer + sizeof(buffer), value).ptr);
+}
+
+void PlayerSaveBatch::AppendValue(std::string const& value)
+{
+    Separate();
+    _current += '\'';
+    // same escaping as mysql_real_escape_string for the utf8 connection charset
+    for (char c : value)
+    {
+        switch (c)
+        {
+            case '\0': _current += "\\0"; break;
+            case '\n': _current += "\\n"; break;
+            case '\r': _current += "\\r"; break;
+            case '\\': _current += "\\\\"; break;
+            case '\'': _current += "\\'"; break;
+            case '"': _current += "\\\""; break;
+            case '\032': _current += "\\Z"; break;
+            default: _current += c; break;
+        }
+    }
+    _current += '\'';
+}
+
+void PlayerSaveBatch::AppendValue(std::vector<uint8> const& value)
+{
+    static char const digits[] = "0123456789ABCDEF";
+
+    Separate();
+    _current += "X'";
+    for (uint8 byte : value)
+    {
+        _current += digits[byte >> 4];
+        _current += digits[byte & 0xF];
+    }
+    _current += '\'';
+}
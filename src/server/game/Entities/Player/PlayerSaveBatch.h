@@ -0,0 +1,94 @@
+/*
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PlayerSaveBatch_h__
+#define PlayerSaveBatch_h__
+
+#include "DatabaseEnvFwd.h"
+#include "Define.h"
+
+#include <string>
+#include <type_traits>
+#include <vector>
+
+/*
+ * Rows of one table written by a single multi-row INSERT/REPLACE per MaxRows rows.
+ *
+ * Player sections that rewrite their whole row set (auras, talents, glyphs, ...) used to append one
+ * statement per row, every one of them a round trip inside the save transaction. The rows are
+ * rendered into the statement text, so GetHash() also tells whether the section changed since the
+ * last save and the whole rewrite can be skipped.
+ */
+class PlayerSaveBatch
+{
+public:
+    // head is the statement up to the rows, "INSERT INTO table (a, b) VALUES "
+    explicit PlayerSaveBatch(char const* head, uint32 maxRows = 256);
+
+    template<typename... Values>
+    void AddRow(Values const&... values)
+    {
+        BeginRow();
+        (AppendValue(values), ...);
+        EndRow();
+    }
+
+    // appends the statements, returns the number of rows written
+    uint32 AppendTo(CharacterDatabaseTransaction& trans);
+
+    uint32 GetRowCount() const { return _rowCount; }
+    uint32 GetStatementCount() const { return uint32(_statements.size()) + (_pendingRows ? 1 : 0); }
+
+    // FNV-1a of every row, stable between saves as long as the rows are
+    uint64 GetHash() const { return _hash; }
+
+    static uint64 CombineHash(uint64 left, uint64 right) { return left ^ (right + 0x9E3779B97F4A7C15ULL + (left << 6) + (left >> 2)); }
+
+private:
+    void BeginRow();
+    void EndRow();
+
+    template<typename T>
+    std::enable_if_t<std::is_integral_v<T> || std::is_enum_v<T>> AppendValue(T value)
+    {
+        if constexpr (std::is_enum_v<T>)
+            AppendInteger(int64(value));
+        else if constexpr (std::is_signed_v<T>)
+            AppendInteger(int64(value));
+        else
+            AppendUnsigned(uint64(value));
+    }
+
+    void AppendValue(float value);
+    void AppendValue(std::string const& value);
+    void AppendValue(char const* value) { AppendValue(std::string(value)); }
+    void AppendValue(std::vector<uint8> const& value);
+
+    void AppendInteger(int64 value);
+    void AppendUnsigned(uint64 value);
+    void Separate();
+
+    std::string _head;
+    std::string _current;
+    std::vector<std::string> _statements;
+    uint32 _maxRows;
+    uint32 _pendingRows;
+    uint32 _rowCount;
+    std::size_t _rowStart;
+    bool _firstValue;
+    uint64 _hash;
+};
+
+#endif // PlayerSaveBatch_h__
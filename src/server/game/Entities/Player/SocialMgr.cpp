@@ -36,7 +36,7 @@ FriendInfo::FriendInfo(uint8 flags, std::string const& note) : Status(FRIEND_STA
 {
 }
 
-PlayerSocial::PlayerSocial()
+PlayerSocial::PlayerSocial() : m_ignoreFilter(0)
 {
     m_playerGUID.Clear();
 }
@@ -87,6 +87,10 @@ bool PlayerSocial::AddToSocialList(ObjectGuid const& friendGuid, SocialFlag flag
 
         CharacterDatabase.Execute(stmt);
     }
+
+    if (flag & SOCIAL_FLAG_IGNORED)
+        m_ignoreFilter |= _GetIgnoreFilterBit(friendGuid);
+
     return true;
 }
 
@@ -119,6 +123,21 @@ void PlayerSocial::RemoveFromSocialList(ObjectGuid const& friendGuid, SocialFlag
 
         CharacterDatabase.Execute(stmt);
     }
+
+    if (flag & SOCIAL_FLAG_IGNORED)
+        _RebuildIgnoreFilter();
+}
+
+void PlayerSocial::_RebuildIgnoreFilter()
+{
+    std::lock_guard<std::recursive_mutex> guard(m_social_lock);
+
+    uint64 filter = 0;
+    for (auto& v : m_playerSocialMap)
+        if (v.second.Flags & SOCIAL_FLAG_IGNORED)
+            filter |= _GetIgnoreFilterBit(v.first);
+
+    m_ignoreFilter = filter;
 }
 
 void PlayerSocial::SetFriendNote(ObjectGuid const& friendGuid, std::string note)
@@ -195,6 +214,9 @@ bool PlayerSocial::HasFriend(ObjectGuid const& friendGuid)
 
 bool PlayerSocial::HasIgnore(ObjectGuid const& ignoreGuid)
 {
+    if (!(m_ignoreFilter.load(std::memory_order_relaxed) & _GetIgnoreFilterBit(ignoreGuid)))
+        return false;
+
     return _HasContact(ignoreGuid, SOCIAL_FLAG_IGNORED);
 }
 
@@ -306,6 +328,8 @@ PlayerSocial* SocialMgr::LoadFromDB(PreparedQueryResult result, ObjectGuid const
         social->m_playerSocialMap.emplace(friendGuid, flags, fields[2].GetString());
     } while (result->NextRow());
 
+    social->_RebuildIgnoreFilter();
+
     return social;
 }
 
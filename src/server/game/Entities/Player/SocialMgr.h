@@ -129,6 +129,12 @@ class PlayerSocial
     private:
         bool _HasContact(ObjectGuid const& guid, SocialFlag flags);
 
+        // one bit per hashed ignored guid, lets broadcasts skip the contact lookup for the players ignoring nobody
+        static uint64 _GetIgnoreFilterBit(ObjectGuid const& guid) { return UI64LIT(1) << ((guid.GetCounter() * UI64LIT(0x9E3779B97F4A7C15)) >> 58); }
+        void _RebuildIgnoreFilter();
+
+        std::atomic<uint64> m_ignoreFilter;
+
         PlayerSocialMap m_playerSocialMap;
         ObjectGuid m_playerGUID;
 };
@@ -0,0 +1,59 @@
+/*
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef AppliedAuraFilter_h__
+#define AppliedAuraFilter_h__
+
+#include "Define.h"
+
+#include <array>
+#include <atomic>
+
+/*
+ * Counting filter over the spell ids of the auras applied to a unit. It only answers lookups, the
+ * applications stay owned by Unit::m_appliedAuras and the per AuraType lists are unchanged.
+ *
+ * Most aura lookups by spell id (HasAura, GetAura, GetAuraEffect from scripts and spell checks) are for
+ * auras the unit doesn't have. A zero counter proves the spell isn't applied, so those lookups cost one
+ * load from a flat 512 byte array instead of a descent of the application multimap.
+ * Add is called before the application is inserted and Remove after it is erased, a non zero counter
+ * only means the multimap has to be looked at.
+ */
+class AppliedAuraFilter
+{
+public:
+    AppliedAuraFilter() { Clear(); }
+
+    void Add(uint32 spellId) { _counters[GetSlot(spellId)].fetch_add(1, std::memory_order_relaxed); }
+    void Remove(uint32 spellId) { _counters[GetSlot(spellId)].fetch_sub(1, std::memory_order_relaxed); }
+
+    void Clear()
+    {
+        for (std::atomic<uint16>& counter : _counters)
+            counter.store(0, std::memory_order_relaxed);
+    }
+
+    bool MayContain(uint32 spellId) const { return _counters[GetSlot(spellId)].load(std::memory_order_relaxed) != 0; }
+
+private:
+    static uint32 const SlotBits = 8;
+
+    // Fibonacci hashing, spell ids of related auras are often consecutive
+    static uint32 GetSlot(uint32 spellId) { return (spellId * 2654435769u) >> (32 - SlotBits); }
+
+    std::array<std::atomic<uint16>, 1 << SlotBits> _counters;
+};
+
+#endif // AppliedAuraFilter_h__
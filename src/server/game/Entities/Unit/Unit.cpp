@@ -82,6 +82,7 @@
 #include "World.h"
 #include "WorldPacket.h"
 #include "WorldSession.h"
+#include <bit>
 #include <numeric>
 
 float baseMoveSpeed[MAX_MOVE_TYPE] =
@@ -4528,6 +4529,7 @@ AuraApplication * Unit::_CreateAuraApplication(Aura* aura, uint32 effMask)
 
     m_aura_lock.lock();
     AuraApplicationPtr aurApp = std::make_shared<AuraApplication>(this, caster, aura, effMask);
+    m_appliedAuraFilter.Add(aurId);
     m_appliedAuras.insert(std::make_pair(aurId, aurApp));
 
     if (aurSpellInfo->GetAuraOptions(GetSpawnMode())->IsProcAura)
@@ -4633,6 +4635,7 @@ void Unit::_UnapplyAura(AuraApplicationMap::iterator &i, AuraRemoveMode removeMo
     // Remove all pointers from lists here to prevent possible pointer invalidation on spellcast/auraapply/auraremove
     m_procAuras.erase(aura->GetId());
     m_appliedAuras.erase(i);
+    m_appliedAuraFilter.Remove(aura->GetId());
 
     if (spellInfo->HasAnyAuraInterruptFlag())
     {
@@ -4794,6 +4797,8 @@ void Unit::_RegisterAuraEffect(AuraEffect* aurEff, bool apply)
             if (m_auraTypeCount[auraType])
                 m_auraTypeCount[auraType]--;
     }
+
+    InvalidateAuraModifierCache(auraType);
 }
 
 // All aura base removes should go threw this function!
@@ -4889,6 +4894,7 @@ void Unit::RemoveOwnedAuraAll()
 
     AuraApplicationMap _ownedAuraApplications;
     std::swap(_ownedAuraApplications, m_appliedAuras);
+    m_appliedAuraFilter.Clear();
 
     for (AuraApplicationMap::iterator iter = _ownedAuraApplications.begin(); iter != _ownedAuraApplications.end(); ++iter)
     {
@@ -4997,6 +5003,9 @@ void Unit::RemoveAura(AuraApplicationMap::iterator &i, AuraRemoveMode mode)
 
 void Unit::RemoveAura(uint32 spellId, ObjectGuid caster, uint32 reqEffMask, AuraRemoveMode removeMode)
 {
+    if (!m_appliedAuraFilter.MayContain(spellId))
+        return;
+
     for (AuraApplicationMap::iterator iter = m_appliedAuras.lower_bound(spellId); iter != m_appliedAuras.upper_bound(spellId);)
     {
         Aura const* aura = iter->second->GetBase();
@@ -5093,6 +5102,9 @@ void Unit::RemoveAppliedAuras(std::function<bool(AuraApplicationPtr)> const& che
 
 void Unit::RemoveAppliedAuras(uint32 spellId, std::function<bool(AuraApplicationPtr)> const& check, AuraRemoveMode removeMode /* = AURA_REMOVE_BY_DEFAULT */)
 {
+    if (!m_appliedAuraFilter.MayContain(spellId))
+        return;
+
     for (AuraApplicationMap::iterator iter = m_appliedAuras.lower_bound(spellId); iter != m_appliedAuras.upper_bound(spellId);)
     {
         if (check(iter->second))
@@ -5106,6 +5118,9 @@ void Unit::RemoveAppliedAuras(uint32 spellId, std::function<bool(AuraApplication
 
 void Unit::RemoveAurasDueToSpell(uint32 spellId, ObjectGuid casterGUID, uint32 reqEffMask, AuraRemoveMode removeMode)
 {
+    if (!m_appliedAuraFilter.MayContain(spellId))
+        return;
+
     for (AuraApplicationMap::iterator iter = m_appliedAuras.lower_bound(spellId); iter != m_appliedAuras.upper_bound(spellId);)
     {
         Aura const* aura = iter->second->GetBase();
@@ -5250,6 +5265,9 @@ void Unit::RemoveAurasDueToSpellBySteal(uint32 spellId, ObjectGuid casterGUID, U
 
 void Unit::RemoveAurasDueToItemSpell(Item* castItem, uint32 spellId)
 {
+    if (!m_appliedAuraFilter.MayContain(spellId))
+        return;
+
     for (AuraApplicationMap::iterator iter = m_appliedAuras.lower_bound(spellId); iter != m_appliedAuras.upper_bound(spellId);)
     {
         if (!castItem || iter->second->GetBase()->GetCastItemGUID() == castItem->GetGUID())
@@ -5797,6 +5815,9 @@ void Unit::GetAuraEffectsByMechanic(uint32 mechanic_mask, AuraList& auraList, Ob
 
 AuraEffect* Unit::GetAuraEffect(uint32 spellId, uint8 effIndex, ObjectGuid caster) const
 {
+    if (!m_appliedAuraFilter.MayContain(spellId))
+        return nullptr;
+
     for (AuraApplicationMap::const_iterator itr = m_appliedAuras.lower_bound(spellId); itr != m_appliedAuras.upper_bound(spellId); ++itr)
         if (itr->second->HasEffect(effIndex) && (caster.IsEmpty() || itr->second->GetBase()->GetCasterGUID() == caster))
             return itr->second->GetBase()->GetEffect(effIndex);
@@ -5837,6 +5858,9 @@ AuraEffect* Unit::GetAuraEffect(AuraType type, SpellFamilyNames family, uint32 f
 
 AuraApplication * Unit::GetAuraApplication(uint32 spellId, ObjectGuid casterGUID, ObjectGuid itemCasterGUID, uint32 reqEffMask, AuraApplication * except) const
 {
+    if (!m_appliedAuraFilter.MayContain(spellId))
+        return nullptr;
+
     for (AuraApplicationMap::const_iterator itr = m_appliedAuras.lower_bound(spellId); itr != m_appliedAuras.upper_bound(spellId); ++itr)
     {
         Aura const* aura = itr->second->GetBase();
@@ -5907,6 +5931,9 @@ void Unit::GetDispellableAuraList(Unit* caster, uint32 dispelMask, DispelCharges
 
 bool Unit::HasAuraEffect(uint32 spellId, uint8 effIndex, ObjectGuid caster) const
 {
+    if (!m_appliedAuraFilter.MayContain(spellId))
+        return false;
+
     for (AuraApplicationMap::const_iterator itr = m_appliedAuras.lower_bound(spellId); itr != m_appliedAuras.upper_bound(spellId); ++itr)
         if (itr->second->HasEffect(effIndex) && (caster.IsEmpty() || itr->second->GetBase()->GetCasterGUID() == caster))
             return true;
@@ -5916,6 +5943,9 @@ bool Unit::HasAuraEffect(uint32 spellId, uint8 effIndex, ObjectGuid caster) cons
 uint32 Unit::GetAuraCount(uint32 spellId) const
 {
     uint32 count = 0;
+    if (!m_appliedAuraFilter.MayContain(spellId))
+        return count;
+
     for (AuraApplicationMap::const_iterator itr = m_appliedAuras.lower_bound(spellId); itr != m_appliedAuras.upper_bound(spellId); ++itr)
     {
         if (!itr->second->GetBase()->GetStackAmount())
@@ -6271,24 +6301,87 @@ int32 Unit::GetMaxPositiveAuraModifier(AuraType auratype, std::function<bool(Aur
     return modifier;
 }
 
+static_assert(TOTAL_AURAS <= 0x1000, "aura type doesn't fit in an aura modifier cache slot");
+
+namespace
+{
+    // slot layout: value (32) | aura type version (16) | aura type (12) | kind (3) | valid (1)
+    inline uint64 PackAuraModifierSlot(AuraType auratype, uint8 kind, uint16 version, uint32 value)
+    {
+        return uint64(value) | (uint64(version) << 32) | (uint64(auratype) << 48) | (uint64(kind) << 60) | (UI64LIT(1) << 63);
+    }
+}
+
+bool Unit::GetCachedAuraModifier(AuraType auratype, AuraModifierCacheKind kind, uint16& version, uint32& value) const
+{
+    // read before the effect list, a change made while computing leaves the stored slot already stale
+    version = m_auraTypeVersion[auratype].load(std::memory_order_acquire);
+
+    uint64 slot = m_auraModifierCache[(auratype * MAX_AURA_MODIFIER_KIND + kind) % AuraModifierCacheSize].load(std::memory_order_relaxed);
+    if ((slot & ~UI64LIT(0xFFFFFFFF)) != (PackAuraModifierSlot(auratype, kind, version, 0)))
+        return false;
+
+    value = uint32(slot);
+    return true;
+}
+
+void Unit::SetCachedAuraModifier(AuraType auratype, AuraModifierCacheKind kind, uint16 version, uint32 value) const
+{
+    m_auraModifierCache[(auratype * MAX_AURA_MODIFIER_KIND + kind) % AuraModifierCacheSize].store(PackAuraModifierSlot(auratype, kind, version, value), std::memory_order_relaxed);
+}
+
+void Unit::InvalidateAuraModifierCache(AuraType auratype)
+{
+    m_auraTypeVersion[auratype].fetch_add(1, std::memory_order_release);
+}
+
 int32 Unit::GetTotalAuraModifier(AuraType auratype, bool raid) const
 {
-    return GetTotalAuraModifier(auratype, [](AuraEffect const* /*aurEff*/) { return true; }, raid);
+    AuraModifierCacheKind kind = raid ? AURA_MODIFIER_TOTAL_RAID : AURA_MODIFIER_TOTAL;
+    uint16 version;
+    uint32 value;
+    if (GetCachedAuraModifier(auratype, kind, version, value))
+        return int32(value);
+
+    int32 modifier = GetTotalAuraModifier(auratype, [](AuraEffect const* /*aurEff*/) { return true; }, raid);
+    SetCachedAuraModifier(auratype, kind, version, uint32(modifier));
+    return modifier;
 }
 
 float Unit::GetTotalAuraMultiplier(AuraType auratype) const
 {
-    return GetTotalAuraMultiplier(auratype, [](AuraEffect const* /*aurEff*/) { return true; });
+    uint16 version;
+    uint32 value;
+    if (GetCachedAuraModifier(auratype, AURA_MODIFIER_MULTIPLIER, version, value))
+        return std::bit_cast<float>(value);
+
+    float multiplier = GetTotalAuraMultiplier(auratype, [](AuraEffect const* /*aurEff*/) { return true; });
+    SetCachedAuraModifier(auratype, AURA_MODIFIER_MULTIPLIER, version, std::bit_cast<uint32>(multiplier));
+    return multiplier;
 }
 
 int32 Unit::GetMaxPositiveAuraModifier(AuraType auratype) const
 {
-    return GetMaxPositiveAuraModifier(auratype, [](AuraEffect const* /*aurEff*/) { return true; });
+    uint16 version;
+    uint32 value;
+    if (GetCachedAuraModifier(auratype, AURA_MODIFIER_MAX_POSITIVE, version, value))
+        return int32(value);
+
+    int32 modifier = GetMaxPositiveAuraModifier(auratype, [](AuraEffect const* /*aurEff*/) { return true; });
+    SetCachedAuraModifier(auratype, AURA_MODIFIER_MAX_POSITIVE, version, uint32(modifier));
+    return modifier;
 }
 
 int32 Unit::GetMaxNegativeAuraModifier(AuraType auratype) const
 {
-    return GetMaxNegativeAuraModifier(auratype, [](AuraEffect const* /*aurEff*/) { return true; });
+    uint16 version;
+    uint32 value;
+    if (GetCachedAuraModifier(auratype, AURA_MODIFIER_MAX_NEGATIVE, version, value))
+        return int32(value);
+
+    int32 modifier = GetMaxNegativeAuraModifier(auratype, [](AuraEffect const* /*aurEff*/) { return true; });
+    SetCachedAuraModifier(auratype, AURA_MODIFIER_MAX_NEGATIVE, version, uint32(modifier));
+    return modifier;
 }
 
 int32 Unit::GetTotalForAurasModifier(std::list<AuraType> *auratypelist) const
@@ -17397,8 +17490,13 @@ void Unit::CleanupBeforeRemoveFromMap(bool finalCleanup)
     RemoveAllAuras();   //remove auras witch was added while we where removing from world.
 
     if (!finalCleanup)
+    {
         for (AuraEffectListMap::iterator iter = m_modMapAuras.begin(); iter != m_modMapAuras.end(); ++iter)
+        {
             iter->second->clear();
+            InvalidateAuraModifierCache(AuraType(iter->first));
+        }
+    }
 
     ASSERT(m_appliedAuras.empty());
     ASSERT(m_ownedAuras.empty());
@@ -17838,7 +17936,7 @@ void Unit::ProcDamageAndSpellFor(bool isVictim, Unit* target, uint32 procFlag, u
                 active = true;
         }
         // do checks using conditions table
-        ConditionList conditions = sConditionMgr->GetConditionsForNotGroupedEntry(CONDITION_SOURCE_TYPE_SPELL_PROC, spellProto->Id);
+        ConditionList const& conditions = sConditionMgr->GetConditionsForNotGroupedEntry(CONDITION_SOURCE_TYPE_SPELL_PROC, spellProto->Id);
         ConditionSourceInfo condInfo = ConditionSourceInfo(eventInfo.GetActor(), eventInfo.GetActionTarget());
         if (!sConditionMgr->IsObjectMeetToConditions(condInfo, conditions))
             continue;
@@ -23389,12 +23487,12 @@ private:
 class VisibilityUpdateTask final : public BasicEvent
 {
 public:
-    VisibilityUpdateTask(Unit* me) : m_owner(me) { }
+    VisibilityUpdateTask(Unit* me, bool relocation = false) : m_owner(me), m_relocation(relocation) { }
 
     bool Execute(uint64, uint32) final
     {
         uint32 _ss = getMSTime();
-        UpdateVisibility(m_owner);
+        UpdateVisibility(m_owner, m_relocation);
 
         if (m_owner->IsPlayer() && m_owner->GetMap())
             m_owner->GetMap()->loadGridsInRange(*m_owner, m_owner->GetMap()->IsScenario() ? MAX_VISIBILITY_DISTANCE : m_owner->GetGridActivationRange());
@@ -23408,23 +23506,25 @@ public:
         return true;
     }
 
-    static void UpdateVisibility(Unit* me)
+    // a relocation doesn't change what the unit can detect, the players seeing through it may skip unchanged cells when it only turned
+    static void UpdateVisibility(Unit* me, bool relocation = false)
     {
         SharedVisionList const &shList = me->GetSharedVisionList();
         if (!shList.empty())
         {
             for (SharedVisionList::const_iterator it = shList.begin(); it != shList.end();)
-                (*it++)->UpdateVisibilityForPlayer();
+                (*it++)->UpdateVisibilityForPlayer(relocation);
         }
 
         if (Player* player = me->ToPlayer())
-            player->UpdateVisibilityForPlayer();
+            player->UpdateVisibilityForPlayer(relocation);
 
         me->WorldObject::UpdateObjectVisibility(true);
     }
 
 private:
     Unit* m_owner;
+    bool m_relocation;
 };
 
 void Unit::OnRelocated()
@@ -23434,7 +23534,7 @@ void Unit::OnRelocated()
         if (!m_VisibilityUpdateScheduled)
         {
             m_VisibilityUpdateScheduled = true;
-            m_Events.AddEvent(new VisibilityUpdateTask(this), m_Events.CalculateTime(sWorld->GetVisibilityAINotifyDelay()));
+            m_Events.AddEvent(new VisibilityUpdateTask(this, true), m_Events.CalculateTime(sWorld->GetVisibilityAINotifyDelay()));
         }
     }
     else if (!m_lastVisibilityUpdPos.IsInDist(this, sWorld->GetVisibilityRelocationLowerLimitC()))
@@ -24141,7 +24241,7 @@ bool Unit::HandleSpellClick(Unit* clicker, int8 seatId)
             continue;
 
         //! Check database conditions
-        ConditionList conds = sConditionMgr->GetConditionsForSpellClickEvent(spellClickEntry, itr->second.spellId);
+        ConditionList const& conds = sConditionMgr->GetConditionsForSpellClickEvent(spellClickEntry, itr->second.spellId);
         ConditionSourceInfo info = ConditionSourceInfo(clicker, this);
         if (!sConditionMgr->IsObjectMeetToConditions(info, conds))
             continue;
@@ -25227,15 +25327,20 @@ void Unit::BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player* target)
     std::size_t maskPos = data->wpos();
     data->resize(data->size() + blockCount * sizeof(UpdateMask::BlockType));
 
-    for (uint16 index = 0; index < valCount; ++index)
+    // special info fields are sent with every update to observers allowed to see them
+    BuildUpdateFieldMask(updateType, flags, visibleFlag, _fieldNotifyFlags | (visibleFlag & UF_FLAG_SPECIAL_INFO), valCount, data->contents() + maskPos);
+
+    if (HasFlag(UNIT_FIELD_AURA_STATE, PER_CASTER_AURA_STATE_MASK))
+        UpdateMask::SetUpdateBit(data->contents() + maskPos, UNIT_FIELD_AURA_STATE);
+
+    if (target->needUpdateDynamicFlags)
+        UpdateMask::SetUpdateBit(data->contents() + maskPos, OBJECT_FIELD_DYNAMIC_FLAGS);
+
+    for (std::size_t block = 0; block < blockCount; ++block)
     {
-        if (_fieldNotifyFlags & flags[index] ||
-            ((flags[index] & visibleFlag) & UF_FLAG_SPECIAL_INFO) ||
-            ((updateType == UPDATETYPE_VALUES ? _changesMask[index] : m_uint32Values[index]) && (flags[index] & visibleFlag)) ||
-            (index == UNIT_FIELD_AURA_STATE && HasFlag(UNIT_FIELD_AURA_STATE, PER_CASTER_AURA_STATE_MASK)) ||
-            (index == OBJECT_FIELD_DYNAMIC_FLAGS && target->needUpdateDynamicFlags))
+        for (UpdateMask::BlockType bits = UpdateMask::GetBlock(data->contents() + maskPos, block); bits; bits &= bits - 1)
         {
-            UpdateMask::SetUpdateBit(data->contents() + maskPos, index);
+            uint16 index = UpdateMask::GetLowestBitIndex(block, bits);
 
             if (index == UNIT_FIELD_NPC_FLAGS)
             {
@@ -25403,6 +25508,29 @@ void Unit::BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player* target)
     }
 }
 
+bool Unit::HasTargetDependentChanges() const
+{
+    if (Object::HasTargetDependentChanges())
+        return true;
+
+    // per caster aura states are sent with every update
+    if (HasFlag(UNIT_FIELD_AURA_STATE, PER_CASTER_AURA_STATE_MASK))
+        return true;
+
+    // fields rewritten per observer in BuildValuesUpdate
+    static uint16 const targetDependentFields[] =
+    {
+        OBJECT_FIELD_DYNAMIC_FLAGS, UNIT_FIELD_NPC_FLAGS, UNIT_FIELD_NPC_FLAGS2, UNIT_FIELD_AURA_STATE, UNIT_FIELD_FLAGS,
+        UNIT_FIELD_DISPLAY_ID, UNIT_FIELD_BYTES_2, UNIT_FIELD_FACTION_TEMPLATE, PLAYER_FIELD_BYTES_6
+    };
+
+    for (uint16 index : targetDependentFields)
+        if (index < m_valuesCount && _changesMask[index])
+            return true;
+
+    return false;
+}
+
 bool Unit::SetCanDoubleJump(bool enable)
 {
     if (enable == HasExtraUnitMovementFlag(MOVEMENTFLAG2_CAN_DOUBLE_JUMP))
@@ -27896,6 +28024,7 @@ void Unit::Clear()
     m_visibleAuras.clear();
     m_sharedVision.clear();
     m_appliedAuras.clear();
+    m_appliedAuraFilter.Clear();
     m_ownedAuras.clear();
     m_removedAuras.clear();
     m_gameObj.clear();
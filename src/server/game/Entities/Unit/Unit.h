@@ -19,6 +19,7 @@
 #ifndef __UNIT_H
 #define __UNIT_H
 
+#include "AppliedAuraFilter.h"
 #include "Common.h"
 #include "DataContainers.h"
 #include "EventProcessor.h"
@@ -1128,6 +1129,7 @@ class Unit : public WorldObject
         void SetDisabledCurrentAI() { i_disabledAI = i_AI; i_AI = nullptr; }
 
         void BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, Player* target) const override;
+        bool HasTargetDependentChanges() const override;
 
         void AddToWorld() override;
         void RemoveFromWorld() override;
@@ -1798,6 +1800,8 @@ class Unit : public WorldObject
         float GetTotalAuraMultiplier(AuraType auratype) const;
         int32 GetMaxPositiveAuraModifier(AuraType auratype) const;
         int32 GetMaxNegativeAuraModifier(AuraType auratype) const;
+        // Drops the cached results of the overloads above, called when an effect of this type is registered, unregistered or changes amount
+        void InvalidateAuraModifierCache(AuraType auratype);
         int32 GetTotalAuraDurationByType(AuraType auratype, bool firstAuraInList = false) const;
 
         int32 GetTotalAuraModifierByMiscMask(AuraType auratype, uint32 misc_mask) const;
@@ -2512,6 +2516,7 @@ class Unit : public WorldObject
 
         AuraMap m_ownedAuras;
         AuraApplicationMap m_appliedAuras;
+        AppliedAuraFilter m_appliedAuraFilter;              // spell ids of m_appliedAuras, answers lookups of missing auras
         AuraApplicationMap m_procAuras;
         AuraList m_removedAuras;
         AuraMap::iterator m_auraUpdateIterator;
@@ -2520,6 +2525,27 @@ class Unit : public WorldObject
         AuraEffectList* m_modAuras[TOTAL_AURAS];
         AuraEffectListMap m_modMapAuras;
         uint8 m_auraTypeCount[TOTAL_AURAS];
+
+        enum AuraModifierCacheKind : uint8
+        {
+            AURA_MODIFIER_TOTAL         = 0,
+            AURA_MODIFIER_TOTAL_RAID    = 1,
+            AURA_MODIFIER_MULTIPLIER    = 2,
+            AURA_MODIFIER_MAX_POSITIVE  = 3,
+            AURA_MODIFIER_MAX_NEGATIVE  = 4,
+
+            MAX_AURA_MODIFIER_KIND
+        };
+
+        static uint32 const AuraModifierCacheSize = 64;
+
+        // Results of the predicate-less aura modifier getters. A slot packs value, aura type, kind and the version of the
+        // aura type it was computed at, a slot whose version is behind m_auraTypeVersion is stale.
+        bool GetCachedAuraModifier(AuraType auratype, AuraModifierCacheKind kind, uint16& version, uint32& value) const;
+        void SetCachedAuraModifier(AuraType auratype, AuraModifierCacheKind kind, uint16 version, uint32 value) const;
+
+        std::atomic<uint16> m_auraTypeVersion[TOTAL_AURAS];
+        mutable std::atomic<uint64> m_auraModifierCache[AuraModifierCacheSize];
         AuraList m_scAuras;                        // casted singlecast auras
         AuraList m_gbAuras;                        // casted singlecast auras
         AuraApplicationList m_interruptableAuras;             // auras which have interrupt mask applied on unit
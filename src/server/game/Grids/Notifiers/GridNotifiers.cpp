@@ -37,8 +37,10 @@ bool shouldCallMoveInLineOfSight(Creature const *c, Unit const *u)
 
 using namespace Trinity;
 
-VisibleNotifier::VisibleNotifier(Player& player) : i_player(player), i_data(player.GetMapId()), vis_guids(player.m_clientGUIDs)
+VisibleNotifier::VisibleNotifier(Player& player, std::unordered_map<void const*, uint64>* cellVersions /*= nullptr*/, bool incremental /*= false*/) :
+    i_player(player), i_data(player.GetMapId()), i_cellVersions(cellVersions), i_incremental(incremental), i_retest(true)
 {
+    i_seen.reserve(player.m_clientGUIDs.size());
 }
 
 void VisibleNotifier::AddMaxVisible()
@@ -53,7 +55,7 @@ void VisibleNotifier::AddMaxVisible()
             if (!i_player.InSamePhase((WorldObject*)object))
                 continue;
 
-            vis_guids.erase(object->GetGUID());
+            i_seen.push_back(object->GetGUID());
             switch (object->GetTypeId())
             {
                 case TYPEID_GAMEOBJECT:
@@ -71,7 +73,14 @@ void VisibleNotifier::AddMaxVisible()
 
 void VisibleNotifier::SendToSelf()
 {
-    // at this moment i_clientGUIDs have guids that not iterate at grid level checks
+    std::sort(i_seen.begin(), i_seen.end());
+
+    GuidVector notSeen;
+    i_player.i_clientGUIDLock.lock_shared();
+    std::set_difference(i_player.m_clientGUIDs.begin(), i_player.m_clientGUIDs.end(), i_seen.begin(), i_seen.end(), std::back_inserter(notSeen));
+    i_player.i_clientGUIDLock.unlock_shared();
+
+    // at this moment notSeen have guids that not iterate at grid level checks
     // but exist one case when this possible and object not out of range: transports
     Transport* transport = i_player.GetTransport();
     if (transport && transport->GetMap() == i_player.GetMap())
@@ -82,9 +91,10 @@ void VisibleNotifier::SendToSelf()
             if (!obj || !obj->IsInWorld())
                 continue;
 
-            if (vis_guids.find((*itr)->GetGUID()) != vis_guids.end())
+            GuidVector::iterator notSeenItr = std::lower_bound(notSeen.begin(), notSeen.end(), (*itr)->GetGUID());
+            if (notSeenItr != notSeen.end() && *notSeenItr == (*itr)->GetGUID())
             {
-                vis_guids.erase((*itr)->GetGUID());
+                notSeen.erase(notSeenItr);
 
                 switch ((*itr)->GetTypeId())
                 {
@@ -108,7 +118,7 @@ void VisibleNotifier::SendToSelf()
         }
     }
 
-    for (auto it = vis_guids.begin(); it != vis_guids.end(); ++it)
+    for (auto it = notSeen.begin(); it != notSeen.end(); ++it)
     {
         // extralook shouldn't be removed by missing creature in grid where is curently player
         if (i_player.IsOnVehicle() || i_player.GetVehicleKit() != nullptr)
@@ -382,7 +392,10 @@ void MessageDistDeliverer::SendPacket(Player* player)
     if (i_message->GetOpcode() == SMSG_CHAT && player->GetSocial()->HasIgnore(i_source->GetGUID()))
         return;
 
-    player->SendDirectMessage(i_message);
+    if (!i_sharedMessage)
+        i_sharedMessage = MakeSharedWorldPacket(i_message);
+
+    player->SendDirectMessage(i_sharedMessage);
 }
 
 UnfriendlyMessageDistDeliverer::UnfriendlyMessageDistDeliverer(Unit const* src, WorldPacket* msg, float dist) : i_source(src), i_message(msg), i_phaseMask(src->GetPhaseMask()), i_distSq(dist * dist)
@@ -421,7 +434,10 @@ void UnfriendlyMessageDistDeliverer::SendPacket(Player* player)
     if (!player->HaveAtClient(i_source))
         return;
 
-    player->SendDirectMessage(i_message);
+    if (!i_sharedMessage)
+        i_sharedMessage = MakeSharedWorldPacket(i_message);
+
+    player->SendDirectMessage(i_sharedMessage);
 
     if (i_message->GetOpcode() == SMSG_CLEAR_TARGET)
     {
@@ -38,13 +38,19 @@ namespace Trinity
         Player &i_player;
         UpdateData i_data;
         std::set<Unit*> i_visibleNow;
-        GuidSet vis_guids;
+        GuidVector i_seen;                                  // objects met by the pass, the client guids missing from it are out of range
+        std::unordered_map<void const*, uint64>* i_cellVersions;
+        bool i_incremental;
+        bool i_retest;
 
-        VisibleNotifier(Player& player);
+        explicit VisibleNotifier(Player& player, std::unordered_map<void const*, uint64>* cellVersions = nullptr, bool incremental = false);
 
         void AddMaxVisible();
         void SendToSelf();
 
+        template <typename ObjectTypes>
+        void BeginContainer(TypeMapContainer<ObjectTypes> const& c);
+
         template <typename AnyMapType>
         void Visit(AnyMapType &m);
         void Visit(EventObjectMapType &m);
@@ -88,6 +94,7 @@ namespace Trinity
     {
         WorldObject* i_source;
         WorldPacket const* i_message;
+        SharedWorldPacket i_sharedMessage;                  // copied once at the first recipient
         uint32 i_phaseMask;
         float i_distSq;
         uint32 team;
@@ -109,6 +116,7 @@ namespace Trinity
     {
         Unit const *i_source;
         WorldPacket* i_message;
+        SharedWorldPacket i_sharedMessage;                  // copied once at the first recipient
         uint32 i_phaseMask;
         float i_distSq;
 
@@ -1218,17 +1226,11 @@ namespace Trinity
     public:
         explicit LocalizedPacketDo(Builder& builder) : _builder(builder) { }
 
-        ~LocalizedPacketDo()
-        {
-            for (size_t i = 0; i < _dataCache.size(); ++i)
-                delete _dataCache[i];
-        }
-
         void operator()(Player* p);
 
     private:
         Builder& _builder;
-        std::vector<WorldPackets::Packet*> _dataCache;         // 0 = default, i => i-1 locale index
+        std::vector<SharedWorldPacket> _dataCache;             // 0 = default, i => i-1 locale index, built once and shared by all recipients of that locale
     };
 
     template<class Builder>
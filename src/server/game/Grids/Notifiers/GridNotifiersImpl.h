@@ -32,15 +32,28 @@ void Trinity::VisibleNotifier::Visit(AnyMapType &m)
 {
     for (auto &object : m)
     {
-        vis_guids.erase(object->GetGUID());
-        i_player.UpdateVisibilityOf(object, i_data, i_visibleNow);
+        i_seen.push_back(object->GetGUID());
+        if (i_retest)
+            i_player.UpdateVisibilityOf(object, i_data, i_visibleNow);
     }
 }
 
 inline void Trinity::VisibleNotifier::Visit(EventObjectMapType &m)
 {
     for (auto &object : m)
-        vis_guids.erase(object->GetGUID());
+        i_seen.push_back(object->GetGUID());
+}
+
+template <typename ObjectTypes>
+void Trinity::VisibleNotifier::BeginContainer(TypeMapContainer<ObjectTypes> const& c)
+{
+    if (!i_cellVersions)
+        return;
+
+    // unchanged membership, the objects of the cell keep the client up to date themselves
+    uint64& version = (*i_cellVersions)[&c];
+    i_retest = !i_incremental || version != c.version();
+    version = c.version();
 }
 
 // SEARCHERS & LIST SEARCHERS & WORKERS
@@ -567,26 +580,23 @@ void Trinity::LocalizedPacketDo<Builder>::operator()(Player* p)
 {
     LocaleConstant localeConstant = p->GetSession()->GetSessionDbLocaleIndex();
     uint32 cache_idx = localeConstant + 1;
-    WorldPackets::Packet* data;
+
+    if (_dataCache.size() < cache_idx + 1)
+        _dataCache.resize(cache_idx + 1);
 
     // create if not cached yet
-    if (_dataCache.size() < cache_idx + 1 || !_dataCache[cache_idx])
+    SharedWorldPacket& data = _dataCache[cache_idx];
+    if (!data)
     {
-        if (_dataCache.size() < cache_idx + 1)
-            _dataCache.resize(cache_idx + 1);
-
-        data = _builder(localeConstant);
+        WorldPackets::Packet* packet = _builder(localeConstant);
 
-        ASSERT(data->GetSize() == 0);
+        ASSERT(packet->GetSize() == 0);
 
-        data->Write();
-
-        _dataCache[cache_idx] = data;
+        data = MakeSharedWorldPacket(packet->Write());
+        delete packet;
     }
-    else
-        data = _dataCache[cache_idx];
 
-    p->SendDirectMessage(data->GetRawPacket());
+    p->SendDirectMessage(data);
 }
 
 template<class Builder>
@@ -1862,6 +1862,7 @@ void Group::BroadcastAddonMessagePacket(WorldPacket const* packet, std::string c
 
 void Group::BroadcastPacket(const WorldPacket* packet, bool ignorePlayersInBGRaid, int group, ObjectGuid ignore)
 {
+    SharedWorldPacket shared;
     for (GroupReference* itr = GetFirstMember(); itr != nullptr; itr = itr->next())
     {
         Player* player = itr->getSource();
@@ -1869,7 +1870,12 @@ void Group::BroadcastPacket(const WorldPacket* packet, bool ignorePlayersInBGRai
             continue;
 
         if (group == -1 || itr->getSubGroup() == group)
-            player->SendDirectMessage(packet);
+        {
+            if (!shared)
+                shared = MakeSharedWorldPacket(packet);
+
+            player->SendDirectMessage(shared);
+        }
     }
 }
 
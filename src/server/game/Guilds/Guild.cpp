@@ -2944,17 +2944,35 @@ bool Guild::Validate()
 
 ///////////////////////////////////////////////////////////////////////////////
 // Broadcasts
+// The payload is copied once into an immutable buffer shared by every recipient
+template<class Predicate>
+void Guild::_BroadcastShared(WorldPacket const* packet, Predicate const& predicate) const
+{
+    SharedWorldPacket shared;
+    for (auto const& member : m_members)
+    {
+        Player* player = member.second->FindPlayer();
+        if (!player || !predicate(*member.second, player))
+            continue;
+
+        if (!shared)
+            shared = MakeSharedWorldPacket(packet);
+
+        player->SendDirectMessage(shared);
+    }
+}
+
 void Guild::BroadcastToGuild(WorldSession* session, bool officerOnly, std::string const& msg, uint32 language) const
 {
     if (session && session->GetPlayer() && _HasRankRight(session->GetPlayer(), officerOnly ? GR_RIGHT_OFFCHATSPEAK : GR_RIGHT_GCHATSPEAK))
     {
         WorldPackets::Chat::Chat packet;
         packet.Initialize(officerOnly ? CHAT_MSG_OFFICER : CHAT_MSG_GUILD, Language(language), session->GetPlayer(), nullptr, msg);
-        WorldPacket const* data = packet.Write();
-        for (const auto& member : m_members)
-            if (Player* player = member.second->FindPlayer())
-                if (player->CanContact() && _HasRankRight(player, officerOnly ? GR_RIGHT_OFFCHATLISTEN : GR_RIGHT_GCHATLISTEN) && !player->GetSocial()->HasIgnore(session->GetPlayer()->GetGUID()))
-                    player->SendDirectMessage(data);
+        ObjectGuid senderGuid = session->GetPlayer()->GetGUID();
+        _BroadcastShared(packet.Write(), [this, officerOnly, senderGuid](Member const& /*member*/, Player* player)
+        {
+            return player->CanContact() && _HasRankRight(player, officerOnly ? GR_RIGHT_OFFCHATLISTEN : GR_RIGHT_GCHATLISTEN) && !player->GetSocial()->HasIgnore(senderGuid);
+        });
     }
 }
 
@@ -2964,35 +2982,27 @@ void Guild::BroadcastAddonToGuild(WorldSession* session, bool officerOnly, std::
     {
         WorldPackets::Chat::Chat packet;
         packet.Initialize(officerOnly ? CHAT_MSG_OFFICER : CHAT_MSG_GUILD, LANG_ADDON, session->GetPlayer(), nullptr, msg, 0, "", DEFAULT_LOCALE, prefix);
-        WorldPacket const* data = packet.Write();
-        for (const auto& member : m_members)
-            if (Player* player = member.second->FindPlayer())
-                if (player->CanContact() && _HasRankRight(player, officerOnly ? GR_RIGHT_OFFCHATLISTEN : GR_RIGHT_GCHATLISTEN) && !player->GetSocial()->HasIgnore(session->GetPlayer()->GetGUID()) && player->GetSession()->IsAddonRegistered(prefix))
-                    player->SendDirectMessage(data);
+        ObjectGuid senderGuid = session->GetPlayer()->GetGUID();
+        _BroadcastShared(packet.Write(), [this, officerOnly, senderGuid, &prefix](Member const& /*member*/, Player* player)
+        {
+            return player->CanContact() && _HasRankRight(player, officerOnly ? GR_RIGHT_OFFCHATLISTEN : GR_RIGHT_GCHATLISTEN) && !player->GetSocial()->HasIgnore(senderGuid) && player->GetSession()->IsAddonRegistered(prefix);
+        });
     }
 }
 
 void Guild::BroadcastPacketToRank(WorldPacket const* packet, uint8 rankId) const
 {
-    for (const auto& member : m_members)
-        if (member.second->IsRank(rankId))
-            if (Player* player = member.second->FindPlayer())
-                player->SendDirectMessage(packet);
+    _BroadcastShared(packet, [rankId](Member const& member, Player* /*player*/) { return member.IsRank(rankId); });
 }
 
 void Guild::BroadcastPacket(WorldPacket const* packet) const
 {
-    for (const auto& member : m_members)
-        if (Player* player = member.second->FindPlayer())
-            player->SendDirectMessage(packet);
+    _BroadcastShared(packet, [](Member const& /*member*/, Player* /*player*/) { return true; });
 }
 
 void Guild::BroadcastPacketIfTrackingAchievement(WorldPacket const* packet, uint32 criteriaId) const
 {
-    for (auto const& v : m_members)
-        if (v.second->IsTrackingCriteriaId(criteriaId))
-            if (Player* player = v.second->FindPlayer())
-                player->SendDirectMessage(packet);
+    _BroadcastShared(packet, [criteriaId](Member const& member, Player* /*player*/) { return member.IsTrackingCriteriaId(criteriaId); });
 }
 
 void Guild::MassInviteToEvent(WorldSession* session, uint32 minLevel, uint32 maxLevel, uint32 minRank)
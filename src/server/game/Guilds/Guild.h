@@ -962,6 +962,8 @@ private:
     const RankInfo* GetRankInfo(uint32 rankId) const;
     RankInfo* GetRankInfo(uint32 rankId);
     bool _HasRankRight(Player* player, uint32 right) const;
+    template<class Predicate>
+    void _BroadcastShared(WorldPacket const* packet, Predicate const& predicate) const;
     uint32 _GetLowestRankId() const;
     BankTab* GetBankTab(uint8 tabId);
     const BankTab* GetBankTab(uint8 tabId) const;
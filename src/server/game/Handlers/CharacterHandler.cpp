@@ -2016,6 +2016,7 @@ void WorldSession::HandleContinuePlayerLogin()
     TC_LOG_INFO("network.opcode", "WorldSession::HandleContinuePlayerLogin");
 
     SendPacket(WorldPackets::Auth::ResumeComms(CONNECTION_TYPE_INSTANCE).Write());
+    // waits for every write queued so far, mail, auction expiry and GM commands of other sessions can target this character too
     _charLoginCallback = CharacterDatabase.DelayQueryHolder(holder);
 }
 
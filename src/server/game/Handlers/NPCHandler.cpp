@@ -561,13 +561,12 @@ void WorldSession::SendListInventory(ObjectGuid const& vendorGuid, uint32 entry)
                 if (leftInStock == 0)
                     continue;
 
-                ConditionList conditions = sConditionMgr->GetConditionsForNpcVendorEvent(vendor->GetEntry(), vendorItem->item);
+                ConditionList const& conditions = sConditionMgr->GetConditionsForNpcVendorEvent(vendor->GetEntry(), vendorItem->item);
                 if (!sConditionMgr->IsObjectMeetToConditions(player, vendor, conditions))
                     continue;
 
                 // Check item for all NCP
-                conditions = sConditionMgr->GetConditionsForNotGroupedEntry(CONDITION_SOURCE_TYPE_NPC_VENDOR, vendorItem->item);
-                if (!sConditionMgr->IsObjectMeetToConditions(player, vendor, conditions))
+                if (!sConditionMgr->IsObjectMeetToConditions(player, vendor, sConditionMgr->GetConditionsForNotGroupedEntry(CONDITION_SOURCE_TYPE_NPC_VENDOR, vendorItem->item)))
                     continue;
 
                 if (vendorItem->DonateCost == 0)
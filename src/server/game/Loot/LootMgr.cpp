@@ -3340,7 +3340,7 @@ bool LootTemplate::addConditionItem(Condition* cond)
         {
             if (i->itemid == uint32(cond->SourceEntry))
             {
-                i->conditions.push_back(cond);
+                ConditionMgr::AddToConditionList(i->conditions, cond);
                 return true;
             }
         }
@@ -3356,7 +3356,7 @@ bool LootTemplate::addConditionItem(Condition* cond)
                 {
                     if ((*i).itemid == uint32(cond->SourceEntry))
                     {
-                        (*i).conditions.push_back(cond);
+                        ConditionMgr::AddToConditionList((*i).conditions, cond);
                         return true;
                     }
                 }
@@ -3368,7 +3368,7 @@ bool LootTemplate::addConditionItem(Condition* cond)
                 {
                     if ((*i).itemid == uint32(cond->SourceEntry))
                     {
-                        (*i).conditions.push_back(cond);
+                        ConditionMgr::AddToConditionList((*i).conditions, cond);
                         return true;
                     }
                 }
@@ -3400,13 +3400,13 @@ bool LootTemplate::CheckItemCondition(Player const* player, uint32 itemId, uint8
                 return false;
         }
 
-        ConditionList conditionsList = sConditionMgr->GetConditionsForItemLoot(1, itemId);
+        ConditionList const& conditionsList = sConditionMgr->GetConditionsForItemLoot(1, itemId);
         if (!sConditionMgr->IsObjectMeetToConditions(const_cast<Player*>(player), conditionsList))
             return false;
     }
     else
     {
-        ConditionList conditionsList = sConditionMgr->GetConditionsForItemLoot(2, itemId);
+        ConditionList const& conditionsList = sConditionMgr->GetConditionsForItemLoot(2, itemId);
         if (!sConditionMgr->IsObjectMeetToConditions(const_cast<Player*>(player), conditionsList))
             return false;
     }
@@ -154,7 +154,7 @@ class ConditionMgr;
 
 struct LootStoreItem
 {
-    std::list<Condition*>  conditions;                               // additional loot condition
+    std::vector<Condition*> conditions;                               // additional loot condition
     float   chance;                                         // always positive, chance to drop for both quest and non-quest items, chance to be used for refs
     uint32  itemid;                                         // id of the item
     int32   mincountOrRef;                                  // mincount for drop items (positive) or minus referenced TemplateleId (negative)
@@ -207,7 +207,7 @@ struct LootItem
 
     uint8   type;                                           // 0 = item, 1 = currency
     ItemQualities quality;
-    std::list<Condition*> conditions;                               // additional loot condition
+    std::vector<Condition*> conditions;                               // additional loot condition
     GuidSet allowedGUIDs;
     uint32  count;
     bool    currency          : 1;
@@ -0,0 +1,155 @@
+/*
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "GridPreloader.h"
+#include "Config.h"
+#include "Log.h"
+#include "Map.h"
+#include "StringFormat.h"
+#include "World.h"
+
+#include <cstdio>
+
+GridPreloadRequest::GridPreloadRequest(uint32 mapId, uint32 gridX, uint32 gridY) : MapId(mapId), GridX(gridX), GridY(gridY),
+    Queued(std::chrono::steady_clock::now()), Ready(false), Terrain(nullptr)
+{
+}
+
+GridPreloadRequest::~GridPreloadRequest()
+{
+    delete Terrain;
+}
+
+GridPreloader::GridPreloader() : _enabled(false), _distance(0.0f), _maxQueued(0), _stopped(false)
+{
+}
+
+GridPreloader* GridPreloader::instance()
+{
+    static GridPreloader instance;
+    return &instance;
+}
+
+void GridPreloader::LoadConfig()
+{
+    _distance = std::max(sConfigMgr->GetFloatDefault("GridPreload.Distance", SIZE_OF_GRIDS / 2), 0.0f);
+    _maxQueued = sConfigMgr->GetIntDefault("GridPreload.MaxQueued", 64);
+
+    uint32 threads = sConfigMgr->GetIntDefault("GridPreload.Threads", 0);
+    if (_workers.empty())
+    {
+        for (uint32 i = 0; i < threads; ++i)
+            _workers.emplace_back(&GridPreloader::WorkerThread, this);
+    }
+    else if (threads != _workers.size())
+        TC_LOG_ERROR("server.loading", "GridPreload.Threads option can't be changed at worldserver.conf reload, using current value (%u).", uint32(_workers.size()));
+
+    _enabled = !_workers.empty() && _distance > 0.0f && sConfigMgr->GetBoolDefault("GridPreload.Enable", false);
+}
+
+void GridPreloader::Stop()
+{
+    _enabled = false;
+
+    {
+        std::lock_guard<std::mutex> guard(_queueLock);
+        if (_stopped)
+            return;
+
+        _stopped = true;
+        _queue.clear();
+    }
+
+    _queueCond.notify_all();
+    for (std::thread& worker : _workers)
+        worker.join();
+}
+
+bool GridPreloader::Enqueue(std::shared_ptr<GridPreloadRequest> const& request)
+{
+    {
+        std::lock_guard<std::mutex> guard(_queueLock);
+        if (_stopped || _queue.size() >= _maxQueued)
+        {
+            _counters.Dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        _queue.push_back(request);
+    }
+
+    _counters.Requested.fetch_add(1, std::memory_order_relaxed);
+    _queueCond.notify_one();
+    return true;
+}
+
+void GridPreloader::WorkerThread()
+{
+    while (true)
+    {
+        std::shared_ptr<GridPreloadRequest> request;
+        {
+            std::unique_lock<std::mutex> lock(_queueLock);
+            _queueCond.wait(lock, [this] { return _stopped || !_queue.empty(); });
+            if (_stopped)
+                return;
+
+            request = std::move(_queue.front());
+            _queue.pop_front();
+        }
+
+        // the map gave up on it already
+        if (request.use_count() == 1)
+            continue;
+
+        Preload(*request);
+    }
+}
+
+void GridPreloader::Preload(GridPreloadRequest& request)
+{
+    std::string const& dataPath = sWorld->GetDataPath();
+
+    GridMap* terrain = new GridMap();
+    if (terrain->loadData(Trinity::StringFormat("%smaps/%04u_%02u_%02u.map", dataPath.c_str(), request.MapId, request.GridX, request.GridY).c_str()))
+        request.Terrain = terrain;
+    else
+    {
+        // the map thread loads it again and reports the error
+        delete terrain;
+    }
+
+    // tile file names as in StaticMapTree::getTileFileName and MMapManager::loadMap, missing files are normal
+    ReadFile(Trinity::StringFormat("%svmaps/%04u_%02u_%02u.vmtile", dataPath.c_str(), request.MapId, request.GridY, request.GridX));
+    ReadFile(Trinity::StringFormat("%smmaps/%04u%02u%02u.mmtile", dataPath.c_str(), request.MapId, request.GridX, request.GridY));
+
+    request.Ready.store(true, std::memory_order_release);
+
+    TC_LOG_DEBUG("maps", "GridPreloader: preloaded grid [%u, %u] of map %u in %u ms", request.GridX, request.GridY, request.MapId,
+        uint32(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - request.Queued).count()));
+}
+
+void GridPreloader::ReadFile(std::string const& fileName)
+{
+    FILE* file = fopen(fileName.c_str(), "rb");
+    if (!file)
+        return;
+
+    char buffer[64 * 1024];
+    while (fread(buffer, 1, sizeof(buffer), file) == sizeof(buffer))
+        ;
+
+    fclose(file);
+}
@@ -0,0 +1,106 @@
+/*
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_GRID_PRELOADER_H
+#define TRINITY_GRID_PRELOADER_H
+
+#include "Define.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+class GridMap;
+
+// One grid of one terrain map, GridX/GridY are the GridMaps indices (63 - grid coord)
+struct GridPreloadRequest
+{
+    GridPreloadRequest(uint32 mapId, uint32 gridX, uint32 gridY);
+    ~GridPreloadRequest();
+
+    uint32 MapId;
+    uint32 GridX;
+    uint32 GridY;
+    std::chrono::steady_clock::time_point Queued;
+
+    std::atomic<bool> Ready;
+    GridMap* Terrain;                                       // owned until taken by the map, null if the .map file failed to load
+};
+
+/*
+ * Loads grids ahead of moving players on a small I/O pool (GridPreload.Threads).
+ *
+ * Workers build the GridMap of the .map file and read the .vmtile and .mmtile files of the grid so that
+ * the map thread finds them in the page cache. The map thread keeps doing the final part: it takes the
+ * prepared GridMap in Map::LoadMapImpl if the request is ready, loads the vmap and mmap tiles and inserts
+ * the grid objects. A request that is not ready yet is simply ignored and the grid is loaded as before.
+ */
+class GridPreloader
+{
+public:
+    struct Counters
+    {
+        Counters() : Requested(0), Dropped(0), Used(0), Late(0), Discarded(0) { }
+
+        std::atomic<uint64> Requested;
+        std::atomic<uint64> Dropped;                        // queue full
+        std::atomic<uint64> Used;
+        std::atomic<uint64> Late;                           // grid loaded before the worker was done
+        std::atomic<uint64> Discarded;                      // expired before the grid was needed
+    };
+
+    static GridPreloader* instance();
+
+    // World thread, workers are started by the first call and kept at reload
+    void LoadConfig();
+    void Stop();
+
+    bool IsEnabled() const { return _enabled.load(std::memory_order_relaxed); }
+    float GetDistance() const { return _distance; }
+
+    bool Enqueue(std::shared_ptr<GridPreloadRequest> const& request);
+
+    Counters& GetCounters() { return _counters; }
+    uint32 GetWorkerCount() const { return uint32(_workers.size()); }
+
+private:
+    GridPreloader();
+
+    void WorkerThread();
+    void Preload(GridPreloadRequest& request);
+    static void ReadFile(std::string const& fileName);
+
+    std::atomic<bool> _enabled;
+    float _distance;
+    uint32 _maxQueued;
+
+    std::vector<std::thread> _workers;
+    std::deque<std::shared_ptr<GridPreloadRequest>> _queue;
+    std::mutex _queueLock;
+    std::condition_variable _queueCond;
+    bool _stopped;
+
+    Counters _counters;
+};
+
+#define sGridPreloader GridPreloader::instance()
+
+#endif
@@ -25,6 +25,7 @@
 #include "DisableMgr.h"
 #include "DynamicTree.h"
 #include "GridInfo.h"
+#include "GridPreloader.h"
 #include "GridNotifiers.h"
 #include "GridNotifiersImpl.h"
 #include "Group.h"
@@ -34,6 +35,8 @@
 #include "Map.h"
 #include "MapInstanced.h"
 #include "MapManager.h"
+#include "MapTickProfiler.h"
+#include "MappedFile.h"
 #include "MiscPackets.h"
 #include "MMapFactory.h"
 #include "ObjectAccessor.h"
@@ -411,6 +414,9 @@ void Map::LoadMapImpl(Map* map, int gx, int gy, bool reload)
         if (map->GridMaps[gx][gy])
             return;
 
+        // instances of one parent may load grids on several pool threads, the parent grids and reference counts are shared
+        GridGuardType guard(map->m_parentMap->i_gridLock);
+
         // load grid map for base map
         if (!map->m_parentMap->GridMaps[gx][gy])
             map->m_parentMap->EnsureGridCreated_i(GridCoord(63-gx, 63-gy));
@@ -423,6 +429,16 @@ void Map::LoadMapImpl(Map* map, int gx, int gy, bool reload)
     if (map->GridMaps[gx][gy] && !reload)
         return;
 
+    if (!reload)
+    {
+        if (GridMap* preloaded = map->TakePreloadedGridMap(gx, gy))
+        {
+            map->GridMaps[gx][gy] = preloaded;
+            sScriptMgr->OnLoadGridMap(map, preloaded, gx, gy);
+            return;
+        }
+    }
+
     //map already load, delete it before reloading (Is it necessary? Do we really need the ability the reload maps during runtime?)
     if (map->GridMaps[gx][gy])
     {
@@ -448,6 +464,90 @@ void Map::LoadMapImpl(Map* map, int gx, int gy, bool reload)
     sScriptMgr->OnLoadGridMap(map, map->GridMaps[gx][gy], gx, gy);
 }
 
+// Predicts the grid a player is heading to from its last move, the terrain map prepares it in the background
+void Map::PreloadGridAhead(float oldX, float oldY, float x, float y)
+{
+    float dx = x - oldX;
+    float dy = y - oldY;
+    float length = std::sqrt(dx * dx + dy * dy);
+
+    // standing still or teleported, no direction of travel
+    if (length < 0.1f || length > SIZE_OF_GRID_CELL)
+        return;
+
+    float distance = sGridPreloader->GetDistance();
+    float aheadX = x + dx / length * distance;
+    float aheadY = y + dy / length * distance;
+    if (!Trinity::IsValidMapCoord(aheadX, aheadY))
+        return;
+
+    Cell current(x, y);
+    Cell ahead(aheadX, aheadY);
+    if (!ahead.DiffGrid(current) || getNGrid(ahead.GridX(), ahead.GridY()))
+        return;
+
+    m_parentMap->RequestGridPreload(MAX_NUMBER_OF_GRIDS - 1 - ahead.GridX(), MAX_NUMBER_OF_GRIDS - 1 - ahead.GridY());
+}
+
+void Map::RequestGridPreload(int gx, int gy)
+{
+    // a player that turned away leaves its request behind
+    static std::chrono::seconds const expiry(60);
+
+    if (GridMaps[gx][gy])
+        return;
+
+    uint32 key = uint32(gx) * MAX_NUMBER_OF_GRIDS + uint32(gy);
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+
+    std::lock_guard<std::mutex> guard(_gridPreloadLock);
+    for (auto itr = _gridPreloads.begin(); itr != _gridPreloads.end();)
+    {
+        if (now - itr->second->Queued > expiry)
+        {
+            if (itr->second->Ready.load(std::memory_order_acquire) && itr->second->Terrain)
+                sGridPreloader->GetCounters().Discarded.fetch_add(1, std::memory_order_relaxed);
+            itr = _gridPreloads.erase(itr);
+        }
+        else
+            ++itr;
+    }
+
+    if (_gridPreloads.find(key) != _gridPreloads.end())
+        return;
+
+    std::shared_ptr<GridPreloadRequest> request = std::make_shared<GridPreloadRequest>(GetId(), gx, gy);
+    if (sGridPreloader->Enqueue(request))
+        _gridPreloads[key] = request;
+}
+
+GridMap* Map::TakePreloadedGridMap(int gx, int gy)
+{
+    std::shared_ptr<GridPreloadRequest> request;
+    {
+        std::lock_guard<std::mutex> guard(_gridPreloadLock);
+        auto itr = _gridPreloads.find(uint32(gx) * MAX_NUMBER_OF_GRIDS + uint32(gy));
+        if (itr == _gridPreloads.end())
+            return nullptr;
+
+        request = std::move(itr->second);
+        _gridPreloads.erase(itr);
+    }
+
+    // never wait for the worker, loading it here is not slower
+    if (!request->Ready.load(std::memory_order_acquire))
+    {
+        sGridPreloader->GetCounters().Late.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    GridMap* terrain = request->Terrain;
+    request->Terrain = nullptr;
+    if (terrain)
+        sGridPreloader->GetCounters().Used.fetch_add(1, std::memory_order_relaxed);
+    return terrain;
+}
+
 void Map::UnloadMap(int gx, int gy)
 {
     // for (Map* childBaseMap : *m_childTerrainMaps)
@@ -467,7 +567,10 @@ void Map::UnloadMapImpl(Map* map, int gx, int gy)
         }
     }
     else
+    {
+        GridGuardType guard(map->m_parentMap->i_gridLock);
         static_cast<MapInstanced*>(map->m_parentMap)->RemoveGridMapReference(GridCoord(gx, gy));
+    }
 
     map->GridMaps[gx][gy] = nullptr;
 }
@@ -586,8 +689,13 @@ m_activeNonPlayersIter(m_activeNonPlayers.end()), i_grids(), GridMaps()
 
     if (CanCreatedZone() || CanCreatedThread())
     {
-        threadPool = new ThreadPoolMap();
-        threadPool->start(sWorld->getIntConfig(CONFIG_MAP_NUMTHREADS));
+        if (sMapUpdateScheduler->IsEnabled())
+            threadPool = new ThreadPoolMap(sMapUpdateScheduler);
+        else
+        {
+            threadPool = new ThreadPoolMap();
+            threadPool->start(sWorld->getIntConfig(CONFIG_MAP_NUMTHREADS));
+        }
     }
     else
         threadPool = nullptr;
@@ -861,6 +969,8 @@ void Map::EnsureGridLoadedForActiveObject(const Cell &cell, WorldObject* object)
 //Create NGrid and load the object data in it
 bool Map::EnsureGridLoaded(const Cell &cell)
 {
+    MapTickProfiler::ClockType::time_point start = MapTickProfiler::ClockType::now();
+
     EnsureGridCreated(GridCoord(cell.GridX(), cell.GridY()));
 
     auto const ngrid = getNGrid(cell.GridX(), cell.GridY());
@@ -875,6 +985,9 @@ bool Map::EnsureGridLoaded(const Cell &cell)
 
     Trinity::ObjectGridLoader::LoadN(*ngrid, this, cell);
 
+    // cached heights and line of sight checks of this area were made without its terrain
+    _queryCache.InvalidateTerrain();
+
     //Hook for garrisones spawn system
     onEnsureGridLoaded(ngrid, cell);
 
@@ -882,6 +995,9 @@ bool Map::EnsureGridLoaded(const Cell &cell)
     sObjectAccessor->AddCorpsesToGrid(GridCoord(cell.GridX(), cell.GridY()), ngrid->GetGrid(cell.CellX(), cell.CellY()), this);
 
     Balance();
+
+    if (sMapTickProfiler->IsEnabled())
+        sMapTickProfiler->Record(GetId(), i_InstanceId, MAP_TICK_PHASE_GRID_LOAD, uint32(std::chrono::duration_cast<std::chrono::microseconds>(MapTickProfiler::ClockType::now() - start).count()));
     return true;
 }
 
@@ -1049,10 +1165,14 @@ void Map::Update(const uint32 t_diff)
     volatile uint32 _instanceId = GetInstanceId();
 
     uint32 _s = getMSTime();
+    MapTickPhaseTimer phaseTimer(GetId(), GetInstanceId());
 
-    m_Functions.Update(t_diff);
+    // publish gameobject collision changes before anything of this tick may query them
+    if (_dynamicTree.update(t_diff))
+        _queryCache.Invalidate();
+    _queryCache.FlushStats();
 
-    _dynamicTree.update(t_diff);
+    m_Functions.Update(t_diff);
 
     /// update active cells around players and active objects
     resetMarkedCells();
@@ -1109,6 +1229,8 @@ void Map::Update(const uint32 t_diff)
 
     m_currentSession = nullptr;
 
+    phaseTimer.Mark(MAP_TICK_PHASE_PLAYERS);
+
     uint32 _ms = GetMSTimeDiffToNow(_s);
     if (_ms > 200)
         sLog->outDiff("Map::Update Player mapId %u Update time - %ums diff %u Players online: %u i_InstanceId %u activeEntry %u", GetId(), _ms, t_diff, m_sessions.size(), i_InstanceId, m_activeEntry);
@@ -1145,8 +1267,9 @@ void Map::Update(const uint32 t_diff)
 
                 if (threadPool)
                 {
-                    threadPool->schedule([collected, t_diff, this]() mutable {
-                    updateCollected(collected.second, t_diff, GetId(), GetInstanceId());
+                    // container lives until the wait below, no need to copy it into the job
+                    threadPool->schedule([objects = &collected.second, t_diff, this]() {
+                    updateCollected(*objects, t_diff, GetId(), GetInstanceId());
                     });
                 }
                 else
@@ -1161,6 +1284,8 @@ void Map::Update(const uint32 t_diff)
     }
     i_objectTest.clear();
 
+    phaseTimer.Mark(MAP_TICK_PHASE_COLLECTED);
+
     _ms = GetMSTimeDiffToNow(_s);
     if (_ms > 250)
         sLog->outDiff("Map::Update Collected mapId %u Update time - %ums diff %u Players online: %u i_InstanceId %u activeEntry %u collectedCount %u", GetId(), _ms, t_diff, m_sessions.size(), i_InstanceId, m_activeEntry, collectedCount);
@@ -1185,6 +1310,8 @@ void Map::Update(const uint32 t_diff)
         _weatherUpdateTimer.Reset();
     }
 
+    phaseTimer.Mark(MAP_TICK_PHASE_SCRIPTS);
+
     _ms = GetMSTimeDiffToNow(_s);
     if (_ms > 250)
         sLog->outDiff("Map::Update ScriptsProcess mapId %u Update time - %ums diff %u Players online: %u i_InstanceId %u activeEntry %u activeEncounter %u", GetId(), _ms, t_diff, m_sessions.size(), i_InstanceId, m_activeEntry, m_activeEncounter);
@@ -1197,6 +1324,8 @@ void Map::Update(const uint32 t_diff)
     MoveAllDynamicObjectsInMoveList();
     MoveAllAreaTriggersInMoveList();
 
+    phaseTimer.Mark(MAP_TICK_PHASE_MOVE_ALL);
+
     _ms = GetMSTimeDiffToNow(_s);
     if (_ms > 250)
         sLog->outDiff("Map::Update MoveAll mapId %u Update time - %ums diff %u Players online: %u i_InstanceId %u activeEntry %u activeEncounter %u", GetId(), _ms, t_diff, m_sessions.size(), i_InstanceId, m_activeEntry, m_activeEncounter);
@@ -1249,6 +1378,8 @@ void Map::Update(const uint32 t_diff)
     }
     objectsTemp.clear();
 
+    phaseTimer.Mark(MAP_TICK_PHASE_UPDATE_DATA);
+
     _ms = GetMSTimeDiffToNow(_s);
     if (_ms > 250)
         sLog->outDiff("Map::Update UpdateDataMap mapId %u Update time - %ums diff %u Players online: %u i_InstanceId %u activeEntry %u activeEncounter %u", GetId(), _ms, t_diff, m_sessions.size(), i_InstanceId, m_activeEntry, m_activeEncounter);
@@ -1268,6 +1399,8 @@ void Map::Update(const uint32 t_diff)
     }
     objectsAddTemp.clear();
 
+    phaseTimer.Mark(MAP_TICK_PHASE_ADD_TO_MAP);
+
     for (auto& scenario : m_scenarios)
         scenario->Update(t_diff);
 
@@ -1284,6 +1417,8 @@ void Map::Update(const uint32 t_diff)
         i_timer_op.SetCurrent(0);
     }
 
+    phaseTimer.Finish();
+
     _ms = GetMSTimeDiffToNow(_s);
     if (_ms > 500) // Only lags
         sLog->outDiff("Map::Update mapId %u Update time - %ums diff %u Players online: %u i_InstanceId %u activeEntry %u activeEncounter %u", GetId(), _ms, t_diff, m_sessions.size(), i_InstanceId, m_activeEntry, m_activeEncounter);
@@ -1453,7 +1588,9 @@ void Map::PlayerRelocation(Player* player, float x, float y, float z, float orie
 {
     ASSERT(player);
 
-    Cell old_cell(player->GetPositionX(), player->GetPositionY());
+    float oldX = player->GetPositionX();
+    float oldY = player->GetPositionY();
+    Cell old_cell(oldX, oldY);
     Cell new_cell(x, y);
 
     player->Relocate(x, y, z, orientation);
@@ -1473,6 +1610,9 @@ void Map::PlayerRelocation(Player* player, float x, float y, float z, float orie
             EnsureGridLoadedForActiveObject(new_cell, player);
 
         AddToGrid(player, new_cell);
+
+        if (sGridPreloader->IsEnabled())
+            PreloadGridAhead(oldX, oldY, x, y);
     }
 
     player->OnRelocated();
@@ -2181,8 +2321,14 @@ bool Map::IsRegularDifficulty() const
 
 bool Map::UnloadGrid(GridContainerType::iterator itr, bool unloadAll)
 {
+    // instances take this lock to reference the grid map, see LoadMapImpl
+    GridGuardType guard(i_gridLock);
+
     auto &ngrid = itr->second;
 
+    if (!unloadAll && ngrid.getGridInfo().getUnloadLock())
+        return false;
+
     auto const x = ngrid.getX();
     auto const y = ngrid.getY();
 
@@ -2255,6 +2401,7 @@ bool Map::UnloadGrid(GridContainerType::iterator itr, bool unloadAll)
 
         i_loadedGrids.erase(itr);
         setNGrid(nullptr, x, y);
+        _queryCache.InvalidateTerrain();
     }
     int gx = (MAX_NUMBER_OF_GRIDS - 1) - x;
     int gy = (MAX_NUMBER_OF_GRIDS - 1) - y;
@@ -2274,7 +2421,10 @@ bool Map::UnloadGrid(GridContainerType::iterator itr, bool unloadAll)
             MMAP::MMapFactory::createOrGetMMapManager()->unloadMap(GetId(), gx, gy);
         }
         else
+        {
+            GridGuardType guard(m_parentMap->i_gridLock);
             static_cast<MapInstanced*>(m_parentMap)->RemoveGridMapReference(GridCoord(gx, gy));
+        }
 
         GridMaps[gx][gy] = nullptr;
     }
@@ -2355,6 +2505,84 @@ uint32 Map::GetParentMap() const
 // *****************************
 // Grid function
 // *****************************
+
+// Reads a .map file through stdio or, with MapFiles.MemoryMapped, straight from the mapped file
+class GridMapFile
+{
+public:
+    explicit GridMapFile(MappedFile* mapping) : _mapping(mapping), _file(nullptr), _pos(0) { }
+    explicit GridMapFile(FILE* file) : _mapping(nullptr), _file(file), _pos(0) { }
+    ~GridMapFile()
+    {
+        if (_file)
+            fclose(_file);
+    }
+
+    bool Seek(uint32 offset)
+    {
+        if (!_mapping)
+            return fseek(_file, offset, SEEK_SET) == 0;
+
+        if (offset > _mapping->GetSize())
+            return false;
+
+        _pos = offset;
+        return true;
+    }
+
+    bool Read(void* dest, std::size_t size)
+    {
+        if (!size)
+            return true;
+
+        if (!_mapping)
+            return fread(dest, size, 1, _file) == 1;
+
+        if (size > _mapping->GetSize() - _pos)
+            return false;
+
+        memcpy(dest, _mapping->GetData() + _pos, size);
+        _pos += size;
+        return true;
+    }
+
+    // Returns a pointer into the mapping when the data is suitably aligned, otherwise a new[] copy
+    template<class T>
+    T* ReadArray(std::size_t count)
+    {
+        if (_mapping && count <= (_mapping->GetSize() - _pos) / sizeof(T))
+        {
+            uint8* data = _mapping->GetData() + _pos;
+            if (reinterpret_cast<uintptr_t>(data) % alignof(T) == 0)
+            {
+                _pos += count * sizeof(T);
+                return reinterpret_cast<T*>(data);
+            }
+        }
+
+        T* array = new T[count];
+        if (!Read(array, count * sizeof(T)))
+        {
+            delete[] array;
+            return nullptr;
+        }
+        return array;
+    }
+
+private:
+    MappedFile* _mapping;
+    FILE* _file;
+    std::size_t _pos;
+};
+
+template<class T>
+static void ReleaseGridMapArray(T*& array, MappedFile const* mapping)
+{
+    if (!mapping || !mapping->Contains(array))
+        delete[] array;
+    array = nullptr;
+}
+
 GridMap::GridMap()
 {
     _flags = 0;
@@ -2392,94 +2620,90 @@ bool GridMap::loadData(const char* filename)
     // Unload old data if exist
     unloadData();
 
-    map_fileheader header;
-    // Not return error if file not found
-    FILE* in = fopen(filename, "rb");
-    if (!in)
-        return false;
+    if (sWorld->getBoolConfig(CONFIG_MAP_FILES_MEMORY_MAPPED))
+    {
+        _mappedFile.reset(new MappedFile());
+        if (!_mappedFile->Open(filename))
+            _mappedFile.reset();
+    }
 
-    _fileExists = true;
-    if (fread(&header, sizeof(header), 1, in) != 1)
+    FILE* file = nullptr;
+    if (!_mappedFile)
     {
-        fclose(in);
-        return false;
+        // Not return error if file not found
+        file = fopen(filename, "rb");
+        if (!file)
+            return false;
     }
 
+    GridMapFile in = _mappedFile ? GridMapFile(_mappedFile.get()) : GridMapFile(file);
+
+    map_fileheader header;
+    _fileExists = true;
+    if (!in.Read(&header, sizeof(header)))
+        return false;
+
     if (header.mapMagic == MapMagic.asUInt && header.versionMagic == MapVersionMagic.asUInt)
     {
         // loadup area data
         if (header.areaMapOffset && !loadAreaData(in, header.areaMapOffset, header.areaMapSize))
         {
             TC_LOG_ERROR("maps", "Error loading map area data\n");
-            fclose(in);
             return false;
         }
         // loadup height data
         if (header.heightMapOffset && !loadHeightData(in, header.heightMapOffset, header.heightMapSize))
         {
             TC_LOG_ERROR("maps", "Error loading map height data\n");
-            fclose(in);
             return false;
         }
         // loadup liquid data
         if (header.liquidMapOffset && !loadLiquidData(in, header.liquidMapOffset, header.liquidMapSize))
         {
             TC_LOG_ERROR("maps", "Error loading map liquids data\n");
-            fclose(in);
             return false;
         }
-        fclose(in);
         return true;
     }
     TC_LOG_ERROR("maps", "Map file '%s' is from an incompatible clientversion. Please recreate using the mapextractor.", filename);
-    fclose(in);
     return false;
 }
 
 void GridMap::unloadData()
 {
-    delete[] _areaMap;
-    delete[] m_V9;
-    delete[] m_V8;
+    ReleaseGridMapArray(_areaMap, _mappedFile.get());
+    ReleaseGridMapArray(m_V9, _mappedFile.get());
+    ReleaseGridMapArray(m_V8, _mappedFile.get());
+    ReleaseGridMapArray(_liquidEntry, _mappedFile.get());
+    ReleaseGridMapArray(_liquidFlags, _mappedFile.get());
+    ReleaseGridMapArray(_liquidMap, _mappedFile.get());
     delete[] _minHeightPlanes;
-    delete[] _liquidEntry;
-    delete[] _liquidFlags;
-    delete[] _liquidMap;
-    _areaMap = nullptr;
-    m_V9 = nullptr;
-    m_V8 = nullptr;
     _minHeightPlanes = nullptr;
-    _liquidEntry = nullptr;
-    _liquidFlags = nullptr;
-    _liquidMap  = nullptr;
+    _mappedFile.reset();
     _gridGetHeight = &GridMap::getHeightFromFlat;
     _fileExists = false;
 }
 
-bool GridMap::loadAreaData(FILE* in, uint32 offset, uint32 /*size*/)
+bool GridMap::loadAreaData(GridMapFile& in, uint32 offset, uint32 /*size*/)
 {
     map_areaHeader header;
-    fseek(in, offset, SEEK_SET);
-
-    if (fread(&header, sizeof(header), 1, in) != 1 || header.fourcc != MapAreaMagic.asUInt)
+    if (!in.Seek(offset) || !in.Read(&header, sizeof(header)) || header.fourcc != MapAreaMagic.asUInt)
         return false;
 
     _gridArea = header.gridArea;
     if (!(header.flags & MAP_AREA_NO_AREA))
     {
-        _areaMap = new uint16[16 * 16];
-        if (fread(_areaMap, sizeof(uint16), 16*16, in) != 16*16)
+        _areaMap = in.ReadArray<uint16>(16 * 16);
+        if (!_areaMap)
             return false;
     }
     return true;
 }
 
-bool GridMap::loadHeightData(FILE* in, uint32 offset, uint32 /*size*/)
+bool GridMap::loadHeightData(GridMapFile& in, uint32 offset, uint32 /*size*/)
 {
     map_heightHeader header;
-    fseek(in, offset, SEEK_SET);
-
-    if (fread(&header, sizeof(header), 1, in) != 1 || header.fourcc != MapHeightMagic.asUInt)
+    if (!in.Seek(offset) || !in.Read(&header, sizeof(header)) || header.fourcc != MapHeightMagic.asUInt)
         return false;
 
     _gridHeight = header.gridHeight;
@@ -2487,30 +2711,21 @@ bool GridMap::loadHeightData(FILE* in, uint32 offset, uint32 /*size*/)
     {
         if ((header.flags & MAP_HEIGHT_AS_INT16))
         {
-            m_uint16_V9 = new uint16 [129*129];
-            m_uint16_V8 = new uint16 [128*128];
-            if (fread(m_uint16_V9, sizeof(uint16), 129*129, in) != 129*129 ||
-                fread(m_uint16_V8, sizeof(uint16), 128*128, in) != 128*128)
+            if (!(m_uint16_V9 = in.ReadArray<uint16>(129 * 129)) || !(m_uint16_V8 = in.ReadArray<uint16>(128 * 128)))
                 return false;
             _gridIntHeightMultiplier = (header.gridMaxHeight - header.gridHeight) / 65535;
             _gridGetHeight = &GridMap::getHeightFromUint16;
         }
         else if ((header.flags & MAP_HEIGHT_AS_INT8))
         {
-            m_uint8_V9 = new uint8 [129*129];
-            m_uint8_V8 = new uint8 [128*128];
-            if (fread(m_uint8_V9, sizeof(uint8), 129*129, in) != 129*129 ||
-                fread(m_uint8_V8, sizeof(uint8), 128*128, in) != 128*128)
+            if (!(m_uint8_V9 = in.ReadArray<uint8>(129 * 129)) || !(m_uint8_V8 = in.ReadArray<uint8>(128 * 128)))
                 return false;
             _gridIntHeightMultiplier = (header.gridMaxHeight - header.gridHeight) / 255;
             _gridGetHeight = &GridMap::getHeightFromUint8;
         }
         else
         {
-            m_V9 = new float [129*129];
-            m_V8 = new float [128*128];
-            if (fread(m_V9, sizeof(float), 129*129, in) != 129*129 ||
-                fread(m_V8, sizeof(float), 128*128, in) != 128*128)
+            if (!(m_V9 = in.ReadArray<float>(129 * 129)) || !(m_V8 = in.ReadArray<float>(128 * 128)))
                 return false;
             _gridGetHeight = &GridMap::getHeightFromFloat;
         }
@@ -2522,8 +2737,8 @@ bool GridMap::loadHeightData(FILE* in, uint32 offset, uint32 /*size*/)
     {
         std::array<int16, 9> maxHeights;
         std::array<int16, 9> minHeights;
-        if (fread(maxHeights.data(), sizeof(int16), maxHeights.size(), in) != maxHeights.size() ||
-            fread(minHeights.data(), sizeof(int16), minHeights.size(), in) != minHeights.size())
+        if (!in.Read(maxHeights.data(), sizeof(int16) * maxHeights.size()) ||
+            !in.Read(minHeights.data(), sizeof(int16) * minHeights.size()))
             return false;
 
         static uint32 constexpr indices[8][3] =
@@ -2563,12 +2778,10 @@ bool GridMap::loadHeightData(FILE* in, uint32 offset, uint32 /*size*/)
     return true;
 }
 
-bool GridMap::loadLiquidData(FILE* in, uint32 offset, uint32 /*size*/)
+bool GridMap::loadLiquidData(GridMapFile& in, uint32 offset, uint32 /*size*/)
 {
     map_liquidHeader header;
-    fseek(in, offset, SEEK_SET);
-
-    if (fread(&header, sizeof(header), 1, in) != 1 || header.fourcc != MapLiquidMagic.asUInt)
+    if (!in.Seek(offset) || !in.Read(&header, sizeof(header)) || header.fourcc != MapLiquidMagic.asUInt)
         return false;
 
     _liquidGlobalEntry = header.liquidType;
@@ -2581,18 +2794,13 @@ bool GridMap::loadLiquidData(FILE* in, uint32 offset, uint32 /*size*/)
 
     if (!(header.flags & MAP_LIQUID_NO_TYPE))
     {
-        _liquidEntry = new uint16[16*16];
-        if (fread(_liquidEntry, sizeof(uint16), 16*16, in) != 16*16)
-            return false;
-
-        _liquidFlags = new uint8[16*16];
-        if (fread(_liquidFlags, sizeof(uint8), 16*16, in) != 16*16)
+        if (!(_liquidEntry = in.ReadArray<uint16>(16 * 16)) || !(_liquidFlags = in.ReadArray<uint8>(16 * 16)))
             return false;
     }
     if (!(header.flags & MAP_LIQUID_NO_HEIGHT))
     {
-        _liquidMap = new float[uint32(_liquidWidth) * uint32(_liquidHeight)];
-        if (fread(_liquidMap, sizeof(float), _liquidWidth*_liquidHeight, in) != (uint32(_liquidWidth) * uint32(_liquidHeight)))
+        _liquidMap = in.ReadArray<float>(uint32(_liquidWidth) * uint32(_liquidHeight));
+        if (!_liquidMap)
             return false;
     }
     return true;
@@ -3036,6 +3244,22 @@ float Map::GetGridMapHeigh(float x, float y) const
 }
 
 float Map::GetHeight(float x, float y, float z, bool checkVMap /*= true*/, float maxSearchDist /*= DEFAULT_HEIGHT_SEARCH*/) const
+{
+    // without vmap the grid lookup is cheaper than the cache
+    if (!checkVMap)
+        return _GetHeight(x, y, z, checkVMap, maxSearchDist);
+
+    float height;
+    MapQueryStamp stamp;
+    if (_queryCache.GetHeight(x, y, z, checkVMap, maxSearchDist, height, stamp))
+        return height;
+
+    height = _GetHeight(x, y, z, checkVMap, maxSearchDist);
+    _queryCache.StoreHeight(x, y, z, checkVMap, maxSearchDist, height, stamp);
+    return height;
+}
+
+float Map::_GetHeight(float x, float y, float z, bool checkVMap, float maxSearchDist) const
 {
     // find raw .map surface under Z coordinates
     float mapHeight = VMAP_INVALID_HEIGHT_VALUE;
@@ -3361,8 +3585,20 @@ float Map::GetWaterLevel(float x, float y) const
 
 bool Map::isInLineOfSight(float x1, float y1, float z1, float x2, float y2, float z2, std::set<uint32> const& phases, DynamicTreeCallback* dCallback /*= nullptr*/) const
 {
-    return VMAP::VMapFactory::createOrGetVMapManager()->isInLineOfSight(GetId(), x1, y1, z1, x2, y2, z2)
-        && _dynamicTree.isInLineOfSight({ x1, y1, z1 }, { x2, y2, z2 }, phases, dCallback);
+    // callers asking for the blocking gameobject can't be served from the cache
+    if (dCallback)
+        return VMAP::VMapFactory::createOrGetVMapManager()->isInLineOfSight(GetId(), x1, y1, z1, x2, y2, z2)
+            && _dynamicTree.isInLineOfSight({ x1, y1, z1 }, { x2, y2, z2 }, phases, dCallback);
+
+    bool result;
+    MapQueryStamp stamp;
+    if (_queryCache.GetLineOfSight(x1, y1, z1, x2, y2, z2, phases, result, stamp))
+        return result;
+
+    result = VMAP::VMapFactory::createOrGetVMapManager()->isInLineOfSight(GetId(), x1, y1, z1, x2, y2, z2)
+        && _dynamicTree.isInLineOfSight({ x1, y1, z1 }, { x2, y2, z2 }, phases, false);
+    _queryCache.StoreLineOfSight(x1, y1, z1, x2, y2, z2, phases, result, stamp);
+    return result;
 }
 
 bool Map::getObjectHitPos(std::set<uint32> const& phases, bool otherUsePlayerPhasingRules, Position startPos, Position destPos, float modifyDist, DynamicTreeCallback* dCallback /*= nullptr*/)
@@ -3834,11 +4070,15 @@ uint32 Map::GetPlayersCountExceptGMs() const
 
 void Map::SendToPlayers(WorldPacket const* data) const
 {
+    if (m_mapRefManager.isEmpty())
+        return;
+
+    SharedWorldPacket shared = MakeSharedWorldPacket(data);
     for (MapRefManager::const_iterator itr = m_mapRefManager.begin(), next; itr != m_mapRefManager.end(); itr = next)
     {
         next = itr;
         ++next;
-        itr->getSource()->SendDirectMessage(data);
+        itr->getSource()->SendDirectMessage(shared);
     }
 }
 
@@ -5320,87 +5560,98 @@ void Map::UpdateLoop(volatile uint32 _mapID)
 
     while (!b_isMapStop)
     {
-        if (m_worldCrashChecker) // Crashing detected, need stop map
-        {
-            m_Transports.clear();
-            UnloadAll();
-            b_isMapStop = true;
-            TC_LOG_ERROR("server", "Map::UpdateLoop Crash _mapID %u thread %zu", _mapID, std::hash<std::thread::id>()(std::this_thread::get_id()));
-            break;
-        }
+        realCurrTime = getMSTime();
 
-        try
-        {
-            m_mapLoopCounter++;
-            uint32 slepp = sWorld->getIntConfig(CONFIG_INTERVAL_MAP_SESSION_UPDATE);
-            if (!Instanceable() && !CanCreatedZone() && !HavePlayers())
-                slepp = 1000;
+        uint32 diff = getMSTimeDiff(realPrevTime, realCurrTime);
+        uint32 slepp = UpdateTick(_mapID, diff);
+        if (b_isMapStop)
+            break;
 
-            realCurrTime = getMSTime();
+        realPrevTime = realCurrTime;
 
-            uint32 diff = getMSTimeDiff(realPrevTime, realCurrTime);
+        if (diff <= slepp + prevSleepTime)
+        {
+            prevSleepTime = slepp + prevSleepTime - diff;
+            std::this_thread::sleep_for(Milliseconds(prevSleepTime));
+        }
+        else
+            prevSleepTime = 0;
+    }
 
-            i_timer.Update(diff);
-            i_timer_se.Update(diff);
+    //TC_LOG_ERROR(LOG_FILTER_WORLDSERVER, "Map::UpdateLoop Stop _mapID %u thread %u", _mapID, std::this_thread::get_id());
 
-            if (i_timer_se.Passed())
-            {
-                uint32 _s = getMSTime();
-                UpdateSessions(uint32(i_timer_se.GetCurrent()));
-                m_sessionTime = GetMSTimeDiffToNow(_s);
+    cds::threading::Manager::detachThread();
+}
 
-                i_timer_se.SetCurrent(0);
-            }
+uint32 Map::UpdateTick(uint32 _mapID, uint32 diff)
+{
+    if (m_worldCrashChecker) // Crashing detected, need stop map
+    {
+        m_Transports.clear();
+        UnloadAll();
+        b_isMapStop = true;
+        TC_LOG_ERROR("server", "Map::UpdateLoop Crash _mapID %u thread %zu", _mapID, std::hash<std::thread::id>()(std::this_thread::get_id()));
+        return 0;
+    }
 
-            if (i_timer.Passed())
-            {
-                uint32 _s = getMSTime();
-                uint32 curr = uint32(i_timer.GetCurrent());
-                Update(curr);
-                DelayedUpdate(curr);
-                UpdateTransport(curr);
-                m_updateTime = GetMSTimeDiffToNow(_s);
-
-                i_timer.SetCurrent(0);
-            }
+    uint32 slepp = sWorld->getIntConfig(CONFIG_INTERVAL_MAP_SESSION_UPDATE);
+    if (!Instanceable() && !CanCreatedZone() && !HavePlayers())
+        slepp = 1000;
 
-            if (i_timer_bp.Passed())
-            {
-                PopulateBattlePet(uint32(i_timer_bp.GetCurrent()));
-                i_timer_bp.SetCurrent(0);
-            }
+    try
+    {
+        m_mapLoopCounter++;
 
-            realPrevTime = realCurrTime;
+        i_timer.Update(diff);
+        i_timer_se.Update(diff);
 
-            if (diff <= slepp + prevSleepTime)
-            {
-                prevSleepTime = slepp + prevSleepTime - diff;
-                std::this_thread::sleep_for(Milliseconds(prevSleepTime));
-            }
-            else
-                prevSleepTime = 0;
-        }
-        catch (std::exception& e)
+        if (i_timer_se.Passed())
         {
-            // sLog->outTryCatch("\n\n//==-----------------------------------------------------------------------------------------------------==//");
-            sLog->outTryCatch("Exception caught in Map::UpdateLoop %s _mapID %u InstanceId %u", e.what(), _mapID, i_InstanceId);
+            uint32 _s = getMSTime();
+            MapTickPhaseTimer phaseTimer(GetId(), GetInstanceId());
+            UpdateSessions(uint32(i_timer_se.GetCurrent()));
+            phaseTimer.Mark(MAP_TICK_PHASE_SESSIONS);
+            m_sessionTime = GetMSTimeDiffToNow(_s);
 
-            if (m_currentSession)
-                m_currentSession->KickPlayer();
+            i_timer_se.SetCurrent(0);
         }
-        catch (...)
+
+        if (i_timer.Passed())
         {
-            // sLog->outTryCatch("\n\n//==-----------------------------------------------------------------------------------------------------==//");
-            sLog->outTryCatch("Exception caught in Map::UpdateLoop _mapID %u InstanceId %u", _mapID, i_InstanceId);
+            uint32 _s = getMSTime();
+            uint32 curr = uint32(i_timer.GetCurrent());
+            Update(curr);
+            DelayedUpdate(curr);
+            UpdateTransport(curr);
+            m_updateTime = GetMSTimeDiffToNow(_s);
+
+            i_timer.SetCurrent(0);
+        }
 
-            if (m_currentSession)
-                m_currentSession->KickPlayer();
+        if (i_timer_bp.Passed())
+        {
+            PopulateBattlePet(uint32(i_timer_bp.GetCurrent()));
+            i_timer_bp.SetCurrent(0);
         }
     }
+    catch (std::exception& e)
+    {
+        // sLog->outTryCatch("\n\n//==-----------------------------------------------------------------------------------------------------==//");
+        sLog->outTryCatch("Exception caught in Map::UpdateLoop %s _mapID %u InstanceId %u", e.what(), _mapID, i_InstanceId);
 
-    //TC_LOG_ERROR(LOG_FILTER_WORLDSERVER, "Map::UpdateLoop Stop _mapID %u thread %u", _mapID, std::this_thread::get_id());
+        if (m_currentSession)
+            m_currentSession->KickPlayer();
+    }
+    catch (...)
+    {
+        // sLog->outTryCatch("\n\n//==-----------------------------------------------------------------------------------------------------==//");
+        sLog->outTryCatch("Exception caught in Map::UpdateLoop _mapID %u InstanceId %u", _mapID, i_InstanceId);
 
-    cds::threading::Manager::detachThread();
+        if (m_currentSession)
+            m_currentSession->KickPlayer();
+    }
+
+    return slepp;
 }
 
 void Map::SetMapUpdateInterval()
@@ -5551,7 +5802,7 @@ bool Map::CanUnloadMap()
 
 void Map::TerminateThread()
 {
-    if (threadPool)
+    if (threadPool && !threadPool->shared())
     {
         threadPool->terminate();
         delete threadPool;
@@ -26,6 +26,7 @@
 #include "DynamicTree.h"
 #include "GameObjectModel.h"
 #include "GridDefines.h"
+#include "MapQueryCache.h"
 #include "MapRefManager.h"
 #include "SharedDefines.h"
 #include "Timer.h"
@@ -173,6 +174,10 @@ struct LiquidData
     float depth_level = 0.0f;
 };
 
+class GridMapFile;
+struct GridPreloadRequest;
+class MappedFile;
+
 class GridMap
 {
     uint32  _flags;
@@ -207,10 +212,11 @@ class GridMap
     uint8 _liquidWidth;
     uint8 _liquidHeight;
     bool _fileExists;
+    std::unique_ptr<MappedFile> _mappedFile;    // MapFiles.MemoryMapped, arrays may point into it
 
-    bool loadAreaData(FILE* in, uint32 offset, uint32 size);
-    bool loadHeightData(FILE* in, uint32 offset, uint32 size);
-    bool loadLiquidData(FILE* in, uint32 offset, uint32 size);
+    bool loadAreaData(GridMapFile& in, uint32 offset, uint32 size);
+    bool loadHeightData(GridMapFile& in, uint32 offset, uint32 size);
+    bool loadLiquidData(GridMapFile& in, uint32 offset, uint32 size);
 
     // Get height functions and pointers
     typedef float (GridMap::*GetHeightPtr) (float x, float y) const;
@@ -541,10 +547,14 @@ class Map
         float GetWaterOrGroundLevel(std::set<uint32> const& phases, float x, float y, float z, float* ground = nullptr, bool swim = false) const;
         float GetHeight(std::set<uint32> const& phases, float x, float y, float z, bool vmap = true, float maxSearchDist = DEFAULT_HEIGHT_SEARCH, DynamicTreeCallback* dCallback = nullptr) const;
         bool isInLineOfSight(float x1, float y1, float z1, float x2, float y2, float z2, std::set<uint32> const& phases, DynamicTreeCallback* dCallback = nullptr) const;
-        void Balance() { _dynamicTree.balance(); }
+        void Balance() { if (_dynamicTree.balance()) _queryCache.Invalidate(); }
         void RemoveGameObjectModel(GameObjectModel const& model) { _dynamicTree.remove(model); }
         void InsertGameObjectModel(GameObjectModel const& model) { _dynamicTree.insert(model); }
         bool ContainsGameObjectModel(GameObjectModel const& model) const { return _dynamicTree.contains(model);}
+        void RetireGameObjectModel(GameObjectModel const* model) { _dynamicTree.retire(model); }
+        // collision of a model in the tree was toggled or moved in place (doors, transports) inside the rectangle
+        void InvalidateCollisionQueries(float minX, float minY, float maxX, float maxY) { _queryCache.InvalidateArea(minX, minY, maxX, maxY); }
+        MapQueryCache const& GetQueryCache() const { return _queryCache; }
         bool getObjectHitPos(std::set<uint32> const& phases, bool otherUsePlayerPhasingRules, Position startPos, Position destPos, float modifyDist, DynamicTreeCallback* dCallback = nullptr);
         bool getObjectHitPos(std::set<uint32> const& phases, bool otherUsePlayerPhasingRules, float x1, float y1, float z1, float x2, float y2, float z2, float& rx, float &ry, float& rz, float modifyDist, DynamicTreeCallback* dCallback = nullptr);
         void UpdateEncounterState(EncounterCreditType type, uint32 creditEntry, Unit* sourc, Unit* player);
@@ -577,11 +587,13 @@ class Map
         bool IsMapUnload() { return b_isMapUnload; }
         void SetMapUnload(bool unload = true) { b_isMapUnload = unload; }
         void SetMapStop(bool _stop = true) { b_isMapStop = _stop; }
+        bool IsMapStopped() const { return b_isMapStop; }
 
         // Update object in map
         void AddUpdateObject(Object* obj);
         void RemoveUpdateObject(Object* obj);
         void UpdateLoop(volatile uint32 _mapID);
+        uint32 UpdateTick(uint32 _mapID, uint32 diff);      ///< one iteration of UpdateLoop, returns delay until the next tick
         uint32 GetUpdateTime() const;
         uint32 GetSessionTime() const;
         void SetMapUpdateInterval();
@@ -719,6 +731,7 @@ class Map
         uint32 m_unloadTimer;
         float m_VisibleDistance;
         DynamicMapTree _dynamicTree;
+        MapQueryCache _queryCache;
 
         MapRefManager m_mapRefManager;
         MapRefManager::iterator m_mapRefIter;
@@ -730,6 +743,13 @@ class Map
         ActiveNonPlayers::iterator m_activeNonPlayersIter;
 
     private:
+        float _GetHeight(float x, float y, float z, bool checkVMap, float maxSearchDist) const;
+
+        // Grid preloading, requests are kept by the map owning the terrain (m_parentMap)
+        void PreloadGridAhead(float oldX, float oldY, float x, float y);
+        void RequestGridPreload(int gx, int gy);
+        GridMap* TakePreloadedGridMap(int gx, int gy);
+
         Player* _GetScriptPlayerSourceOrTarget(Object* source, Object* target, const ScriptInfo* scriptInfo) const;
         Creature* _GetScriptCreatureSourceOrTarget(Object* source, Object* target, const ScriptInfo* scriptInfo, bool bReverse = false) const;
         Unit* _GetScriptUnit(Object* obj, bool isSource, const ScriptInfo* scriptInfo) const;
@@ -759,6 +779,8 @@ class Map
 
         NGrid* i_grids[MAX_NUMBER_OF_GRIDS][MAX_NUMBER_OF_GRIDS];
         GridMap* GridMaps[MAX_NUMBER_OF_GRIDS][MAX_NUMBER_OF_GRIDS];
+        std::map<uint32, std::shared_ptr<GridPreloadRequest>> _gridPreloads;
+        std::mutex _gridPreloadLock;
         std::bitset<TOTAL_NUMBER_OF_CELLS_PER_MAP*TOTAL_NUMBER_OF_CELLS_PER_MAP> marked_cells;
 
         std::atomic<bool> i_scriptLock;
@@ -23,6 +23,7 @@
 #include "InstanceSaveMgr.h"
 #include "MapInstanced.h"
 #include "MapManager.h"
+#include "MapUpdateScheduler.h"
 #include "MMapFactory.h"
 #include "ObjectMgr.h"
 #include "VMapFactory.h"
@@ -491,7 +492,10 @@ ZoneMap* MapInstanced::CreateZoneMap(uint32 zoneId, Player* player)
 
     map->UpdateOutdoorPvPScript();
 
-    _zoneThreads[zoneId] = new std::thread(&Map::UpdateLoop, map, zoneId);
+    if (sMapUpdateScheduler->IsEnabled())
+        sMapUpdateScheduler->ScheduleMap(map, zoneId);
+    else
+        _zoneThreads[zoneId] = new std::thread(&Map::UpdateLoop, map, zoneId);
     return map;
 }
 
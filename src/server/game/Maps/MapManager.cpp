@@ -23,6 +23,7 @@
 #include "Corpse.h"
 #include "DatabaseEnv.h"
 #include "GridDefines.h"
+#include "GridPreloader.h"
 #include "Group.h"
 #include "GuildMgr.h"
 #include "InstanceSaveMgr.h"
@@ -30,6 +31,7 @@
 #include "Log.h"
 #include "MapInstanced.h"
 #include "MapManager.h"
+#include "MapUpdateScheduler.h"
 #include "MiscPackets.h"
 #include "ObjectAccessor.h"
 #include "ObjectMgr.h"
@@ -84,7 +86,10 @@ Map* MapManager::CreateBaseMap(uint32 id)
         }
 
         i_maps[id] = map;
-        _mapThreads[id] = new std::thread(&Map::UpdateLoop, map, id);
+        if (sMapUpdateScheduler->IsEnabled())
+            sMapUpdateScheduler->ScheduleMap(map, id);
+        else
+            _mapThreads[id] = new std::thread(&Map::UpdateLoop, map, id);
     }
 
     ASSERT(map);
@@ -376,6 +381,10 @@ void MapManager::UnloadAll()
     // Wait when map is stop update
     std::this_thread::sleep_for(Milliseconds(1000));
 
+    // Maps are deleted below, scheduler workers must not hold them anymore
+    sMapUpdateScheduler->Stop();
+    sGridPreloader->Stop();
+
     for (uint16 i = 0; i < _mapCount; ++i)
     {
         if (Map* map = i_maps[i])
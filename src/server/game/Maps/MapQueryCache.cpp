@@ -0,0 +1,301 @@
+/*
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MapQueryCache.h"
+#include "World.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+MapQueryCounters MapQueryCache::WorldStats;
+
+namespace
+{
+    inline uint32 HashCombine(uint32 seed, uint32 value)
+    {
+        return seed ^ (value * 0x9E3779B1u + 0x7F4A7C15u + (seed << 6) + (seed >> 2));
+    }
+
+    template<std::size_t N>
+    uint32 HashKey(int32 const (&key)[N], uint32 seed)
+    {
+        for (int32 value : key)
+            seed = HashCombine(seed, uint32(value));
+        return seed ^ (seed >> 16);
+    }
+
+    uint32 HashPhases(std::set<uint32> const& phases)
+    {
+        uint32 hash = uint32(phases.size());
+        for (uint32 phase : phases)
+            hash = HashCombine(hash, phase);
+        return hash;
+    }
+
+    // heights change along x and y, only the exact position may share a result
+    inline int32 FloatBits(float value)
+    {
+        int32 bits;
+        memcpy(&bits, &value, sizeof(bits));
+        return bits;
+    }
+
+    void NextGeneration(std::atomic<uint32>& generation)
+    {
+        // generation 0 marks empty slots
+        if (generation.fetch_add(1, std::memory_order_acq_rel) + 1 == 0)
+            generation.fetch_add(1, std::memory_order_acq_rel);
+    }
+}
+
+MapQueryCache::MapQueryCache() : _size(0), _invQuantum(1.0f), _generation(1), _heightGeneration(1), _regionClock(0)
+{
+    uint32 size = sWorld->getIntConfig(CONFIG_MAP_QUERY_CACHE_SIZE);
+    float quantum = sWorld->getFloatConfig(CONFIG_MAP_QUERY_CACHE_QUANTUM);
+    if (!size || quantum <= 0.0f)
+        return;
+
+    _size = 1;
+    while (_size < size)
+        _size <<= 1;
+    _invQuantum = 1.0f / quantum;
+}
+
+int32 MapQueryCache::Quantize(float value) const
+{
+    return int32(std::floor(value * _invQuantum));
+}
+
+// Tables are only allocated by maps that are actually queried, most base maps never are
+void MapQueryCache::Allocate() const
+{
+    std::call_once(_allocated, [this]()
+    {
+        _lineOfSight.reset(new LineOfSightEntry[_size]);
+        _height.reset(new HeightEntry[_size]);
+        _regions.reset(new std::atomic<uint64>[RegionSlots]);
+        memset(_lineOfSight.get(), 0, sizeof(LineOfSightEntry) * _size);
+        memset(_height.get(), 0, sizeof(HeightEntry) * _size);
+        for (uint32 i = 0; i < RegionSlots; ++i)
+            _regions[i].store(0, std::memory_order_relaxed);
+    });
+}
+
+int32 MapQueryCache::GetRegion(float value)
+{
+    return int32(std::floor(value / RegionSize));
+}
+
+uint32 MapQueryCache::GetRegionSlot(int32 x, int32 y)
+{
+    return (uint32(x) * 0x9E3779B1u ^ uint32(y) * 0x85EBCA77u) & (RegionSlots - 1);
+}
+
+bool MapQueryCache::GetRegionStamp(float minX, float minY, float maxX, float maxY, uint64& stamp) const
+{
+    int32 x1 = GetRegion(minX), y1 = GetRegion(minY);
+    int32 x2 = GetRegion(maxX), y2 = GetRegion(maxY);
+    if (uint32(x2 - x1 + 1) * uint32(y2 - y1 + 1) > MaxQueryRegions)
+        return false;
+
+    stamp = 0;
+    for (int32 x = x1; x <= x2; ++x)
+        for (int32 y = y1; y <= y2; ++y)
+            stamp = std::max(stamp, _regions[GetRegionSlot(x, y)].load(std::memory_order_acquire));
+    return true;
+}
+
+bool MapQueryCache::GetLineOfSight(float x1, float y1, float z1, float x2, float y2, float z2, std::set<uint32> const& phases, bool& result, MapQueryStamp& stamp) const
+{
+    if (!_size)
+        return false;
+
+    Allocate();
+
+    // generation first, an invalidation landing in between only costs a miss
+    stamp.Generation = _generation.load(std::memory_order_acquire);
+    if (!GetRegionStamp(std::min(x1, x2), std::min(y1, y2), std::max(x1, x2), std::max(y1, y2), stamp.Region))
+    {
+        stamp.Generation = 0;
+        _pending.Misses[MAP_QUERY_LINE_OF_SIGHT].fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    int32 key[6] = { Quantize(x1), Quantize(y1), Quantize(z1), Quantize(x2), Quantize(y2), Quantize(z2) };
+    uint32 phaseHash = HashPhases(phases);
+    uint32 slot = HashKey(key, phaseHash) & (_size - 1);
+
+    {
+        std::lock_guard<std::mutex> guard(_locks[slot % ShardCount]);
+        LineOfSightEntry const& entry = _lineOfSight[slot];
+        if (entry.Generation == stamp.Generation && entry.Region == stamp.Region && entry.PhaseHash == phaseHash && !memcmp(entry.Key, key, sizeof(key)))
+        {
+            result = entry.Result;
+            _pending.Hits[MAP_QUERY_LINE_OF_SIGHT].fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+
+    _pending.Misses[MAP_QUERY_LINE_OF_SIGHT].fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+void MapQueryCache::StoreLineOfSight(float x1, float y1, float z1, float x2, float y2, float z2, std::set<uint32> const& phases, bool result, MapQueryStamp const& stamp) const
+{
+    if (!_size || !stamp.Generation)
+        return;
+
+    Allocate();
+
+    int32 key[6] = { Quantize(x1), Quantize(y1), Quantize(z1), Quantize(x2), Quantize(y2), Quantize(z2) };
+    uint32 phaseHash = HashPhases(phases);
+    uint32 slot = HashKey(key, phaseHash) & (_size - 1);
+
+    std::lock_guard<std::mutex> guard(_locks[slot % ShardCount]);
+    LineOfSightEntry& entry = _lineOfSight[slot];
+    memcpy(entry.Key, key, sizeof(key));
+    entry.PhaseHash = phaseHash;
+    entry.Generation = stamp.Generation;
+    entry.Region = stamp.Region;
+    entry.Result = result;
+}
+
+bool MapQueryCache::GetHeight(float x, float y, float z, bool checkVMap, float maxSearchDist, float& result, MapQueryStamp& stamp) const
+{
+    if (!_size)
+        return false;
+
+    Allocate();
+
+    int32 key[4] = { FloatBits(x), FloatBits(y), Quantize(z), Quantize(maxSearchDist) };
+    uint32 slot = HashKey(key, checkVMap ? 1 : 0) & (_size - 1);
+    stamp.Generation = _heightGeneration.load(std::memory_order_acquire);
+
+    {
+        std::lock_guard<std::mutex> guard(_locks[slot % ShardCount]);
+        HeightEntry const& entry = _height[slot];
+        if (entry.Generation == stamp.Generation && entry.CheckVMap == checkVMap && !memcmp(entry.Key, key, sizeof(key)))
+        {
+            result = entry.Result;
+            _pending.Hits[MAP_QUERY_HEIGHT].fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+
+    _pending.Misses[MAP_QUERY_HEIGHT].fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+void MapQueryCache::StoreHeight(float x, float y, float z, bool checkVMap, float maxSearchDist, float result, MapQueryStamp const& stamp) const
+{
+    if (!_size || !stamp.Generation)
+        return;
+
+    Allocate();
+
+    int32 key[4] = { FloatBits(x), FloatBits(y), Quantize(z), Quantize(maxSearchDist) };
+    uint32 slot = HashKey(key, checkVMap ? 1 : 0) & (_size - 1);
+
+    std::lock_guard<std::mutex> guard(_locks[slot % ShardCount]);
+    HeightEntry& entry = _height[slot];
+    memcpy(entry.Key, key, sizeof(key));
+    entry.CheckVMap = checkVMap;
+    entry.Generation = stamp.Generation;
+    entry.Result = result;
+}
+
+void MapQueryCache::InvalidateTerrain() const
+{
+    if (!_size)
+        return;
+
+    NextGeneration(_heightGeneration);
+    NextGeneration(_generation);
+    _pending.Invalidations.fetch_add(1, std::memory_order_relaxed);
+}
+
+void MapQueryCache::Invalidate() const
+{
+    if (!_size)
+        return;
+
+    NextGeneration(_generation);
+    _pending.Invalidations.fetch_add(1, std::memory_order_relaxed);
+}
+
+void MapQueryCache::InvalidateArea(float minX, float minY, float maxX, float maxY) const
+{
+    if (!_size)
+        return;
+
+    int32 x1 = GetRegion(minX), y1 = GetRegion(minY);
+    int32 x2 = GetRegion(maxX), y2 = GetRegion(maxY);
+    if (uint32(x2 - x1 + 1) * uint32(y2 - y1 + 1) > MaxInvalidatedRegions)
+    {
+        Invalidate();
+        return;
+    }
+
+    Allocate();
+
+    // the clock only grows, a slot keeps the newest value written to it
+    uint64 value = _regionClock.fetch_add(1, std::memory_order_acq_rel) + 1;
+    for (int32 x = x1; x <= x2; ++x)
+    {
+        for (int32 y = y1; y <= y2; ++y)
+        {
+            std::atomic<uint64>& region = _regions[GetRegionSlot(x, y)];
+            uint64 current = region.load(std::memory_order_relaxed);
+            while (current < value && !region.compare_exchange_weak(current, value, std::memory_order_acq_rel))
+                ;
+        }
+    }
+
+    _pending.AreaInvalidations.fetch_add(1, std::memory_order_relaxed);
+}
+
+void MapQueryCache::FlushStats()
+{
+    if (!_size)
+        return;
+
+    for (uint8 i = 0; i < MAX_MAP_QUERY_TYPE; ++i)
+    {
+        if (uint64 hits = _pending.Hits[i].exchange(0, std::memory_order_relaxed))
+        {
+            _totals.Hits[i].fetch_add(hits, std::memory_order_relaxed);
+            WorldStats.Hits[i].fetch_add(hits, std::memory_order_relaxed);
+        }
+
+        if (uint64 misses = _pending.Misses[i].exchange(0, std::memory_order_relaxed))
+        {
+            _totals.Misses[i].fetch_add(misses, std::memory_order_relaxed);
+            WorldStats.Misses[i].fetch_add(misses, std::memory_order_relaxed);
+        }
+    }
+
+    if (uint64 invalidations = _pending.Invalidations.exchange(0, std::memory_order_relaxed))
+    {
+        _totals.Invalidations.fetch_add(invalidations, std::memory_order_relaxed);
+        WorldStats.Invalidations.fetch_add(invalidations, std::memory_order_relaxed);
+    }
+
+    if (uint64 invalidations = _pending.AreaInvalidations.exchange(0, std::memory_order_relaxed))
+    {
+        _totals.AreaInvalidations.fetch_add(invalidations, std::memory_order_relaxed);
+        WorldStats.AreaInvalidations.fetch_add(invalidations, std::memory_order_relaxed);
+    }
+}
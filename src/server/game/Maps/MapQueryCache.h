@@ -0,0 +1,150 @@
+/*
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_MAP_QUERY_CACHE_H
+#define TRINITY_MAP_QUERY_CACHE_H
+
+#include "Define.h"
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <set>
+
+enum MapQueryType : uint8
+{
+    MAP_QUERY_LINE_OF_SIGHT = 0,
+    MAP_QUERY_HEIGHT        = 1,
+
+    MAX_MAP_QUERY_TYPE
+};
+
+struct MapQueryCounters
+{
+    MapQueryCounters() : Invalidations(0), AreaInvalidations(0)
+    {
+        for (uint8 i = 0; i < MAX_MAP_QUERY_TYPE; ++i)
+        {
+            Hits[i] = 0;
+            Misses[i] = 0;
+        }
+    }
+
+    std::atomic<uint64> Hits[MAX_MAP_QUERY_TYPE];
+    std::atomic<uint64> Misses[MAX_MAP_QUERY_TYPE];
+    std::atomic<uint64> Invalidations;
+    std::atomic<uint64> AreaInvalidations;
+};
+
+// Taken by a lookup before the result is computed, the result is stored with it
+struct MapQueryStamp
+{
+    MapQueryStamp() : Generation(0), Region(0) { }
+
+    uint32 Generation;                                      // 0 - the query isn't cached
+    uint64 Region;                                          // newest area invalidation under a line of sight query
+};
+
+/*
+ * Bounded result cache of Map::isInLineOfSight and Map::GetHeight (MapQueryCache.Size entries per query type).
+ *
+ * Keys are hashed into a direct mapped table, a colliding key simply replaces the slot. Line of sight end points
+ * are quantized to MapQueryCache.Quantum yards; heights are keyed on the exact x and y so that a slope never
+ * returns the height of a neighbouring point, only the search start z and distance are quantized. Every entry remembers the generation it was computed in:
+ * - InvalidateTerrain() drops everything, the map calls it whenever a grid is loaded or unloaded;
+ * - Invalidate() drops the line of sight results, for gameobject collision changes the map can't locate
+ *   (dynamic tree publish);
+ * - InvalidateArea() only drops the line of sight results whose segment passes over the given rectangle,
+ *   for doors and for models moved in place (transports, lifts). The map is split in RegionSize squares
+ *   hashed into RegionSlots counters, an entry remembers the newest invalidation of the squares under it.
+ * Heights are taken from the grid maps and vmaps only, gameobjects don't change them.
+ * Counters are kept per map and added to the world wide totals once per map tick.
+ */
+class MapQueryCache
+{
+public:
+    MapQueryCache();
+
+    bool IsEnabled() const { return _size != 0; }
+
+    // On a miss stamp is set to the current generation, the result computed afterwards must be stored with it
+    // so that an invalidation during the computation discards it
+    bool GetLineOfSight(float x1, float y1, float z1, float x2, float y2, float z2, std::set<uint32> const& phases, bool& result, MapQueryStamp& stamp) const;
+    void StoreLineOfSight(float x1, float y1, float z1, float x2, float y2, float z2, std::set<uint32> const& phases, bool result, MapQueryStamp const& stamp) const;
+
+    bool GetHeight(float x, float y, float z, bool checkVMap, float maxSearchDist, float& result, MapQueryStamp& stamp) const;
+    void StoreHeight(float x, float y, float z, bool checkVMap, float maxSearchDist, float result, MapQueryStamp const& stamp) const;
+
+    void InvalidateTerrain() const;
+    void Invalidate() const;
+    void InvalidateArea(float minX, float minY, float maxX, float maxY) const;
+
+    // Map thread, once per tick
+    void FlushStats();
+    MapQueryCounters const& GetStats() const { return _totals; }
+
+    static MapQueryCounters WorldStats;
+
+private:
+    static uint32 const ShardCount = 16;
+
+    static constexpr float RegionSize = 64.0f;
+    static uint32 const RegionSlots = 4096;                 // power of two
+    static uint32 const MaxQueryRegions = 16;               // longer segments aren't cached
+    static uint32 const MaxInvalidatedRegions = 64;         // larger areas invalidate every line of sight result
+
+    struct LineOfSightEntry
+    {
+        int32 Key[6];
+        uint32 PhaseHash;
+        uint32 Generation;                                  // 0 - empty
+        uint64 Region;
+        bool Result;
+    };
+
+    struct HeightEntry
+    {
+        int32 Key[4];
+        uint32 Generation;
+        bool CheckVMap;
+        float Result;
+    };
+
+    int32 Quantize(float value) const;
+    void Allocate() const;
+
+    static int32 GetRegion(float value);
+    static uint32 GetRegionSlot(int32 x, int32 y);
+    // newest area invalidation under the rectangle, false if it spans more than MaxQueryRegions squares
+    bool GetRegionStamp(float minX, float minY, float maxX, float maxY, uint64& stamp) const;
+
+    uint32 _size;                                           // power of two
+    float _invQuantum;
+    mutable std::atomic<uint32> _generation;                // line of sight
+    mutable std::atomic<uint32> _heightGeneration;
+    mutable std::atomic<uint64> _regionClock;
+
+    mutable std::once_flag _allocated;
+    mutable std::unique_ptr<LineOfSightEntry[]> _lineOfSight;
+    mutable std::unique_ptr<HeightEntry[]> _height;
+    mutable std::unique_ptr<std::atomic<uint64>[]> _regions;
+    mutable std::array<std::mutex, ShardCount> _locks;
+
+    mutable MapQueryCounters _pending;                      // since the last FlushStats
+    MapQueryCounters _totals;
+};
+
+#endif
@@ -0,0 +1,300 @@
+/*
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MapTickProfiler.h"
+#include "Config.h"
+#include "Log.h"
+#include "Util.h"
+
+#include <algorithm>
+#include <cstdio>
+
+namespace
+{
+    // Marks the buffer orphaned when its thread exits, the drain frees it once empty
+    struct ThreadBufferOwner
+    {
+        ~ThreadBufferOwner()
+        {
+            if (Flag)
+                Flag->store(true, std::memory_order_release);
+        }
+
+        std::atomic<bool>* Flag = nullptr;
+        void* Buffer = nullptr;
+    };
+
+    thread_local ThreadBufferOwner t_buffer;
+}
+
+MapTickProfiler::MapTickProfiler() : _enabled(false), _droppedSamples(0), _dumpInterval(0), _dumpTimer(0), _expireTimer(0)
+{
+}
+
+MapTickProfiler* MapTickProfiler::instance()
+{
+    static MapTickProfiler instance;
+    return &instance;
+}
+
+void MapTickProfiler::LoadConfig()
+{
+    _enabled = sConfigMgr->GetBoolDefault("MapProfiler.Enable", false);
+    _dumpInterval = sConfigMgr->GetIntDefault("MapProfiler.DumpInterval", 60000);
+    _dumpFile = sConfigMgr->GetStringDefault("MapProfiler.DumpFile", "MapProfiler.log");
+    _dumpTimer = 0;
+}
+
+char const* MapTickProfiler::GetPhaseName(MapTickPhase phase)
+{
+    switch (phase)
+    {
+        case MAP_TICK_PHASE_SESSIONS:    return "sessions";
+        case MAP_TICK_PHASE_PLAYERS:     return "players";
+        case MAP_TICK_PHASE_COLLECTED:   return "collected";
+        case MAP_TICK_PHASE_SCRIPTS:     return "scripts";
+        case MAP_TICK_PHASE_MOVE_ALL:    return "moveall";
+        case MAP_TICK_PHASE_UPDATE_DATA: return "updatedata";
+        case MAP_TICK_PHASE_ADD_TO_MAP:  return "addtomap";
+        case MAP_TICK_PHASE_TOTAL:       return "total";
+        case MAP_TICK_PHASE_GRID_LOAD:   return "gridload";
+        default:
+            break;
+    }
+    return "unknown";
+}
+
+MapTickProfiler::ThreadBuffer* MapTickProfiler::GetThreadBuffer()
+{
+    if (t_buffer.Buffer)
+        return static_cast<ThreadBuffer*>(t_buffer.Buffer);
+
+    std::shared_ptr<ThreadBuffer> buffer = std::make_shared<ThreadBuffer>();
+    {
+        std::lock_guard<std::mutex> guard(_buffersLock);
+        _buffers.push_back(buffer);
+    }
+
+    t_buffer.Flag = &buffer->Orphaned;
+    t_buffer.Buffer = buffer.get();
+    return buffer.get();
+}
+
+void MapTickProfiler::Record(uint32 mapId, uint32 instanceId, MapTickPhase phase, uint32 micros)
+{
+    if (!IsEnabled())
+        return;
+
+    ThreadBuffer* buffer = GetThreadBuffer();
+    uint32 head = buffer->Head.load(std::memory_order_relaxed);
+    if (head - buffer->Tail.load(std::memory_order_acquire) >= ThreadBufferSize)
+    {
+        _droppedSamples.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    Sample& sample = buffer->Samples[head % ThreadBufferSize];
+    sample.MapId = mapId;
+    sample.InstanceId = instanceId;
+    sample.Micros = micros;
+    sample.Phase = phase;
+    buffer->Head.store(head + 1, std::memory_order_release);
+}
+
+void MapTickProfiler::Drain()
+{
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+    {
+        std::lock_guard<std::mutex> guard(_buffersLock);
+        buffers = _buffers;
+    }
+
+    bool orphans = false;
+    for (auto const& buffer : buffers)
+    {
+        uint32 tail = buffer->Tail.load(std::memory_order_relaxed);
+        uint32 head = buffer->Head.load(std::memory_order_acquire);
+        for (; tail != head; ++tail)
+        {
+            Sample const& sample = buffer->Samples[tail % ThreadBufferSize];
+            MapWindows& windows = _stats[std::make_pair(sample.MapId, sample.InstanceId)];
+            windows.Sampled = true;
+            Window& window = windows.Phases[sample.Phase];
+            window.Samples[window.Next] = sample.Micros;
+            window.Next = (window.Next + 1) % WindowSize;
+            window.Count = std::min(window.Count + 1, WindowSize);
+            window.Max = std::max(window.Max, sample.Micros);
+            ++window.Total;
+        }
+        buffer->Tail.store(tail, std::memory_order_release);
+
+        if (buffer->Orphaned.load(std::memory_order_acquire))
+            orphans = true;
+    }
+
+    if (orphans)
+    {
+        std::lock_guard<std::mutex> guard(_buffersLock);
+        _buffers.erase(std::remove_if(_buffers.begin(), _buffers.end(), [](std::shared_ptr<ThreadBuffer> const& buffer)
+        {
+            return buffer->Orphaned.load(std::memory_order_acquire) && buffer->Tail.load() == buffer->Head.load();
+        }), _buffers.end());
+    }
+}
+
+void MapTickProfiler::Update(uint32 diff)
+{
+    if (!IsEnabled())
+        return;
+
+    {
+        std::lock_guard<std::mutex> guard(_statsLock);
+        Drain();
+    }
+
+    if (_dumpInterval)
+    {
+        _dumpTimer += diff;
+        if (_dumpTimer >= _dumpInterval)
+        {
+            _dumpTimer = 0;
+            Dump();
+        }
+    }
+
+    // after the dump, which still reports maps unloaded during its interval
+    _expireTimer += diff;
+    if (_expireTimer >= std::max<uint32>(_dumpInterval, IdleExpireInterval))
+    {
+        _expireTimer = 0;
+        ExpireIdle();
+    }
+}
+
+void MapTickProfiler::ExpireIdle()
+{
+    std::lock_guard<std::mutex> guard(_statsLock);
+    for (auto itr = _stats.begin(); itr != _stats.end();)
+    {
+        if (!itr->second.Sampled)
+            itr = _stats.erase(itr);
+        else
+        {
+            itr->second.Sampled = false;
+            ++itr;
+        }
+    }
+}
+
+std::vector<MapTickProfiler::MapStats> MapTickProfiler::GetStats()
+{
+    std::vector<MapStats> result;
+
+    std::lock_guard<std::mutex> guard(_statsLock);
+    Drain();
+
+    result.reserve(_stats.size());
+    std::vector<uint32> sorted;
+    for (auto const& itr : _stats)
+    {
+        MapStats stats;
+        stats.MapId = itr.first.first;
+        stats.InstanceId = itr.first.second;
+        for (uint8 phase = 0; phase < MAX_MAP_TICK_PHASE; ++phase)
+        {
+            Window const& window = itr.second.Phases[phase];
+            PhaseStats& phaseStats = stats.Phases[phase];
+            phaseStats.Count = window.Total;
+            phaseStats.Max = window.Max;
+            phaseStats.P50 = 0;
+            phaseStats.P99 = 0;
+            if (!window.Count)
+                continue;
+
+            sorted.assign(window.Samples.begin(), window.Samples.begin() + window.Count);
+            std::sort(sorted.begin(), sorted.end());
+            phaseStats.P50 = sorted[(sorted.size() - 1) * 50 / 100];
+            phaseStats.P99 = sorted[(sorted.size() - 1) * 99 / 100];
+        }
+        result.push_back(stats);
+    }
+
+    std::sort(result.begin(), result.end(), [](MapStats const& left, MapStats const& right)
+    {
+        return left.Phases[MAP_TICK_PHASE_TOTAL].P99 > right.Phases[MAP_TICK_PHASE_TOTAL].P99;
+    });
+
+    return result;
+}
+
+void MapTickProfiler::Reset()
+{
+    std::lock_guard<std::mutex> guard(_statsLock);
+    Drain();
+    _stats.clear();
+    _droppedSamples = 0;
+}
+
+void MapTickProfiler::Dump()
+{
+    std::string path = sLog->GetLogsDir() + _dumpFile;
+    FILE* file = fopen(path.c_str(), "a");
+    if (!file)
+    {
+        TC_LOG_ERROR("server", "MapTickProfiler: can't open dump file %s", path.c_str());
+        return;
+    }
+
+    std::vector<MapStats> stats = GetStats();
+
+    fprintf(file, "=== %s maps %u dropped samples %u (p50/p99/max us)\n", TimeToTimestampStr(time(nullptr)).c_str(), uint32(stats.size()), GetDroppedSamples());
+    for (MapStats const& map : stats)
+    {
+        fprintf(file, "map %u instance %u ticks %u", map.MapId, map.InstanceId, map.Phases[MAP_TICK_PHASE_TOTAL].Count);
+        for (uint8 phase = 0; phase < MAX_MAP_TICK_PHASE; ++phase)
+        {
+            PhaseStats const& phaseStats = map.Phases[phase];
+            fprintf(file, " %s %u/%u/%u", GetPhaseName(MapTickPhase(phase)), phaseStats.P50, phaseStats.P99, phaseStats.Max);
+        }
+        fprintf(file, "\n");
+    }
+
+    fclose(file);
+}
+
+MapTickPhaseTimer::MapTickPhaseTimer(uint32 mapId, uint32 instanceId) : _enabled(sMapTickProfiler->IsEnabled()), _mapId(mapId), _instanceId(instanceId)
+{
+    if (_enabled)
+        _start = _last = MapTickProfiler::ClockType::now();
+}
+
+void MapTickPhaseTimer::Mark(MapTickPhase phase)
+{
+    if (!_enabled)
+        return;
+
+    MapTickProfiler::ClockType::time_point now = MapTickProfiler::ClockType::now();
+    sMapTickProfiler->Record(_mapId, _instanceId, phase, uint32(std::chrono::duration_cast<std::chrono::microseconds>(now - _last).count()));
+    _last = now;
+}
+
+void MapTickPhaseTimer::Finish()
+{
+    if (!_enabled)
+        return;
+
+    MapTickProfiler::ClockType::time_point now = MapTickProfiler::ClockType::now();
+    sMapTickProfiler->Record(_mapId, _instanceId, MAP_TICK_PHASE_TOTAL, uint32(std::chrono::duration_cast<std::chrono::microseconds>(now - _start).count()));
+}
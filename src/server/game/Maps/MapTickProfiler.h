@@ -0,0 +1,175 @@
+/*
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_MAP_TICK_PROFILER_H
+#define TRINITY_MAP_TICK_PROFILER_H
+
+#include "Define.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+enum MapTickPhase : uint8
+{
+    MAP_TICK_PHASE_SESSIONS     = 0,
+    MAP_TICK_PHASE_PLAYERS      = 1,
+    MAP_TICK_PHASE_COLLECTED    = 2,                        // cell batches of i_objectUpdater
+    MAP_TICK_PHASE_SCRIPTS      = 3,
+    MAP_TICK_PHASE_MOVE_ALL     = 4,                        // MoveAll*InMoveList
+    MAP_TICK_PHASE_UPDATE_DATA  = 5,
+    MAP_TICK_PHASE_ADD_TO_MAP   = 6,
+    MAP_TICK_PHASE_TOTAL        = 7,                        // whole Map::Update
+    MAP_TICK_PHASE_GRID_LOAD    = 8,                        // one Map::EnsureGridLoaded that loaded a grid, not a tick phase
+
+    MAX_MAP_TICK_PHASE
+};
+
+/*
+ * Phase timings of map ticks (MapProfiler.Enable = 1).
+ *
+ * Map threads only push samples into their own single-producer ring, the world thread drains
+ * all rings every update into a window of the last samples per map, instance and phase.
+ * p50/p99/max are reported by ".server mapprofile" and dumped to MapProfiler.DumpFile.
+ */
+class MapTickProfiler
+{
+public:
+    typedef std::chrono::steady_clock ClockType;
+
+    struct PhaseStats
+    {
+        uint32 Count;
+        uint32 P50;                                         // microseconds
+        uint32 P99;
+        uint32 Max;
+    };
+
+    struct MapStats
+    {
+        uint32 MapId;
+        uint32 InstanceId;
+        std::array<PhaseStats, MAX_MAP_TICK_PHASE> Phases;
+    };
+
+    static MapTickProfiler* instance();
+
+    void LoadConfig();
+    bool IsEnabled() const { return _enabled.load(std::memory_order_relaxed); }
+
+    void Record(uint32 mapId, uint32 instanceId, MapTickPhase phase, uint32 micros);
+
+    // World thread
+    void Update(uint32 diff);
+
+    // Sorted by p99 of the whole tick, slowest first
+    std::vector<MapStats> GetStats();
+    void Reset();
+    uint32 GetDroppedSamples() const { return _droppedSamples.load(std::memory_order_relaxed); }
+
+    static char const* GetPhaseName(MapTickPhase phase);
+
+private:
+    static uint32 const ThreadBufferSize = 1024;
+    static uint32 const WindowSize = 512;
+    static uint32 const IdleExpireInterval = 60000;         // minimum, the dump interval if longer
+
+    struct Sample
+    {
+        uint32 MapId;
+        uint32 InstanceId;
+        uint32 Micros;
+        uint8 Phase;
+    };
+
+    // Single producer (owner thread), single consumer (drain under _statsLock)
+    struct ThreadBuffer
+    {
+        ThreadBuffer() : Head(0), Tail(0), Orphaned(false) { }
+
+        std::array<Sample, ThreadBufferSize> Samples;
+        std::atomic<uint32> Head;
+        std::atomic<uint32> Tail;
+        std::atomic<bool> Orphaned;                         // owner thread exited
+    };
+
+    struct Window
+    {
+        Window() : Count(0), Next(0), Max(0), Total(0) { }
+
+        std::array<uint32, WindowSize> Samples;
+        uint32 Count;
+        uint32 Next;
+        uint32 Max;
+        uint32 Total;
+    };
+
+    struct MapWindows
+    {
+        MapWindows() : Sampled(false) { }
+
+        std::array<Window, MAX_MAP_TICK_PHASE> Phases;
+        bool Sampled;                                       // since the last ExpireIdle
+    };
+
+    MapTickProfiler();
+
+    ThreadBuffer* GetThreadBuffer();
+    void Drain();
+    void Dump();
+    // drops maps without samples since the previous call (unloaded instances, garrisons)
+    void ExpireIdle();
+
+    std::atomic<bool> _enabled;
+    std::atomic<uint32> _droppedSamples;
+    uint32 _dumpInterval;
+    uint32 _dumpTimer;
+    uint32 _expireTimer;
+    std::string _dumpFile;
+
+    std::vector<std::shared_ptr<ThreadBuffer>> _buffers;
+    std::mutex _buffersLock;
+
+    std::map<std::pair<uint32, uint32>, MapWindows> _stats;
+    std::mutex _statsLock;
+};
+
+// Measures consecutive phases of one map tick
+class MapTickPhaseTimer
+{
+public:
+    MapTickPhaseTimer(uint32 mapId, uint32 instanceId);
+
+    // records the time since the previous mark
+    void Mark(MapTickPhase phase);
+    // records the time since construction as MAP_TICK_PHASE_TOTAL
+    void Finish();
+
+private:
+    bool _enabled;
+    uint32 _mapId;
+    uint32 _instanceId;
+    MapTickProfiler::ClockType::time_point _start;
+    MapTickProfiler::ClockType::time_point _last;
+};
+
+#define sMapTickProfiler MapTickProfiler::instance()
+
+#endif
@@ -0,0 +1,250 @@
+/*
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MapUpdateScheduler.h"
+#include "Log.h"
+#include "Map.h"
+#include "Timer.h"
+#include "World.h"
+
+#include <algorithm>
+
+#include <cds/init.h>
+#include <cds/gc/hp.h>
+
+namespace
+{
+    // index of the scheduler worker running on this thread, -1 for foreign threads
+    thread_local int32 t_workerIndex = -1;
+}
+
+MapUpdateScheduler::MapUpdateScheduler() : _nextWorker(0), _pendingTasks(0), _sleepingWorkers(0), _stopped(false), _started(false)
+{
+}
+
+MapUpdateScheduler::~MapUpdateScheduler()
+{
+    Stop();
+}
+
+MapUpdateScheduler* MapUpdateScheduler::instance()
+{
+    static MapUpdateScheduler instance;
+    return &instance;
+}
+
+bool MapUpdateScheduler::IsEnabled() const
+{
+    return sWorld->getBoolConfig(CONFIG_MAP_UPDATE_SCHEDULER);
+}
+
+void MapUpdateScheduler::Start()
+{
+    uint32 numThreads = sWorld->getIntConfig(CONFIG_NUMTHREADS);
+    if (!numThreads)
+        numThreads = std::max(std::thread::hardware_concurrency(), 1u);
+
+    _workers.resize(numThreads, nullptr);
+    for (uint32 i = 0; i < numThreads; ++i)
+        _workers[i] = new Worker();
+
+    for (uint32 i = 0; i < numThreads; ++i)
+        _workers[i]->Thread = new std::thread(&MapUpdateScheduler::WorkerThread, this, i);
+
+    _started = true;
+
+    TC_LOG_INFO("server.loading", "Map update scheduler started with %u worker threads", numThreads);
+}
+
+void MapUpdateScheduler::Stop()
+{
+    if (!_started || _stopped.exchange(true))
+        return;
+
+    {
+        std::lock_guard<std::mutex> guard(_mapsLock);
+        _mapsCond.notify_all();
+    }
+
+    for (Worker* worker : _workers)
+    {
+        worker->Thread->join();
+        delete worker->Thread;
+        delete worker;
+    }
+
+    _workers.clear();
+    _maps.clear();
+}
+
+void MapUpdateScheduler::ScheduleMap(Map* map, uint32 mapId)
+{
+    std::call_once(_startFlag, &MapUpdateScheduler::Start, this);
+
+    MapTask task;
+    task.MapPtr = map;
+    task.MapId = mapId;
+    task.PrevTime = getMSTime();
+    task.Deadline = ClockType::now();
+    PushMap(task);
+}
+
+void MapUpdateScheduler::PushMap(MapTask const& task)
+{
+    std::lock_guard<std::mutex> guard(_mapsLock);
+    _maps.push_back(task);
+    std::push_heap(_maps.begin(), _maps.end(), std::greater<MapTask>());
+    _mapsCond.notify_one();
+}
+
+void MapUpdateScheduler::Spawn(TaskGroup& group, TaskType&& task)
+{
+    std::call_once(_startFlag, &MapUpdateScheduler::Start, this);
+
+    group.Pending.fetch_add(1, std::memory_order_relaxed);
+
+    uint32 index = t_workerIndex >= 0 ? uint32(t_workerIndex) : _nextWorker.fetch_add(1, std::memory_order_relaxed) % _workers.size();
+    Worker* worker = _workers[index];
+    {
+        std::lock_guard<std::mutex> guard(worker->Lock);
+        worker->Tasks.push_back({ &group, std::move(task) });
+    }
+
+    _pendingTasks.fetch_add(1);
+
+    // Sleeping workers can help with the new task, don't touch the lock when everyone is busy
+    if (_sleepingWorkers.load())
+    {
+        std::lock_guard<std::mutex> guard(_mapsLock);
+        _mapsCond.notify_one();
+    }
+}
+
+void MapUpdateScheduler::Wait(TaskGroup& group)
+{
+    while (group.Pending.load(std::memory_order_acquire) != 0)
+        if (!RunPendingTask())
+            std::this_thread::yield();
+}
+
+bool MapUpdateScheduler::RunPendingTask()
+{
+    if (!_pendingTasks.load(std::memory_order_relaxed))
+        return false;
+
+    Task task;
+    bool found = false;
+
+    // Own tasks are taken LIFO while their data is still hot in cache
+    if (t_workerIndex >= 0)
+    {
+        Worker* worker = _workers[t_workerIndex];
+        std::lock_guard<std::mutex> guard(worker->Lock);
+        if (!worker->Tasks.empty())
+        {
+            task = std::move(worker->Tasks.back());
+            worker->Tasks.pop_back();
+            found = true;
+        }
+    }
+
+    // Steal the oldest task of another worker
+    if (!found)
+    {
+        uint32 count = uint32(_workers.size());
+        uint32 start = t_workerIndex >= 0 ? uint32(t_workerIndex) + 1 : 0;
+        for (uint32 i = 0; i < count && !found; ++i)
+        {
+            Worker* victim = _workers[(start + i) % count];
+            std::lock_guard<std::mutex> guard(victim->Lock);
+            if (!victim->Tasks.empty())
+            {
+                task = std::move(victim->Tasks.front());
+                victim->Tasks.pop_front();
+                found = true;
+            }
+        }
+    }
+
+    if (!found)
+        return false;
+
+    _pendingTasks.fetch_sub(1);
+
+    task.Func();
+    task.Group->Pending.fetch_sub(1, std::memory_order_release);
+    return true;
+}
+
+bool MapUpdateScheduler::PopDueMap(MapTask& task)
+{
+    std::unique_lock<std::mutex> guard(_mapsLock);
+
+    auto wakeUp = [this] { return _stopped.load() || _pendingTasks.load() != 0; };
+
+    ++_sleepingWorkers;
+    if (_maps.empty())
+        _mapsCond.wait(guard, [this, &wakeUp] { return wakeUp() || !_maps.empty(); });
+    else if (_maps.front().Deadline > ClockType::now())
+    {
+        ClockType::time_point deadline = _maps.front().Deadline;
+        _mapsCond.wait_until(guard, deadline, [this, &wakeUp, deadline] { return wakeUp() || _maps.empty() || _maps.front().Deadline != deadline; });
+    }
+    --_sleepingWorkers;
+
+    if (_stopped || _maps.empty() || _maps.front().Deadline > ClockType::now())
+        return false;
+
+    std::pop_heap(_maps.begin(), _maps.end(), std::greater<MapTask>());
+    task = _maps.back();
+    _maps.pop_back();
+    return true;
+}
+
+void MapUpdateScheduler::RunMapTick(MapTask& task)
+{
+    uint32 now = getMSTime();
+    uint32 delay = task.MapPtr->UpdateTick(task.MapId, getMSTimeDiff(task.PrevTime, now));
+    if (task.MapPtr->IsMapStopped())
+        return;
+
+    // Keep a fixed tick rate, a late map is rescheduled as soon as possible without catching up missed ticks
+    task.PrevTime = now;
+    task.Deadline += std::chrono::milliseconds(delay);
+    ClockType::time_point earliest = ClockType::now();
+    if (task.Deadline < earliest)
+        task.Deadline = earliest;
+
+    PushMap(task);
+}
+
+void MapUpdateScheduler::WorkerThread(uint32 index)
+{
+    t_workerIndex = int32(index);
+    cds::threading::Manager::attachThread();
+
+    while (!_stopped)
+    {
+        // Sub-tasks belong to ticks already in progress, finish them before starting another map
+        if (RunPendingTask())
+            continue;
+
+        MapTask task;
+        if (PopDueMap(task))
+            RunMapTick(task);
+    }
+
+    cds::threading::Manager::detachThread();
+}
@@ -0,0 +1,124 @@
+/*
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_MAP_UPDATE_SCHEDULER_H
+#define TRINITY_MAP_UPDATE_SCHEDULER_H
+
+#include "Define.h"
+#include "InplaceTask.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class Map;
+
+/*
+ * Shared work-stealing scheduler for map updates (MapUpdate.Scheduler = 1).
+ *
+ * Replaces the dedicated Map::UpdateLoop thread of every base/zone map and the
+ * private ThreadPoolMap workers of the parallel maps by a single set of workers:
+ * - map ticks are kept in a heap ordered by their next deadline, the most overdue map is updated first;
+ * - sub-tasks spawned during a tick (cell batches, object update data, instance updates) go to the
+ *   local deque of the spawning worker, idle workers steal them from the front of other deques;
+ * - a worker waiting for its sub-tasks keeps executing pending sub-tasks instead of blocking.
+ */
+class MapUpdateScheduler
+{
+public:
+    typedef Trinity::InplaceTask<48> TaskType;              // 64 bytes with the dispatch pointers
+
+    // Completion counter of the sub-tasks spawned by one ThreadPoolMap
+    struct TaskGroup
+    {
+        TaskGroup() : Pending(0) { }
+
+        std::atomic<uint32> Pending;
+    };
+
+    static MapUpdateScheduler* instance();
+
+    bool IsEnabled() const;
+    bool IsStarted() const { return _started; }
+    uint32 GetWorkerCount() const { return uint32(_workers.size()); }
+
+    void Stop();
+
+    // Map is updated until Map::SetMapStop(), the scheduler must be stopped before deleting it
+    void ScheduleMap(Map* map, uint32 mapId);
+
+    void Spawn(TaskGroup& group, TaskType&& task);
+    void Wait(TaskGroup& group);
+
+private:
+    typedef std::chrono::steady_clock ClockType;
+
+    struct Task
+    {
+        TaskGroup* Group;
+        TaskType Func;
+    };
+
+    struct MapTask
+    {
+        Map* MapPtr;
+        uint32 MapId;
+        uint32 PrevTime;
+        ClockType::time_point Deadline;
+
+        bool operator>(MapTask const& right) const { return Deadline > right.Deadline; }
+    };
+
+    struct Worker
+    {
+        std::mutex Lock;
+        std::deque<Task> Tasks;
+        std::thread* Thread = nullptr;
+    };
+
+    MapUpdateScheduler();
+    ~MapUpdateScheduler();
+
+    MapUpdateScheduler(MapUpdateScheduler const&) = delete;
+    MapUpdateScheduler& operator=(MapUpdateScheduler const&) = delete;
+
+    void Start();
+    void WorkerThread(uint32 index);
+
+    bool RunPendingTask();
+    bool PopDueMap(MapTask& task);
+    void RunMapTick(MapTask& task);
+    void PushMap(MapTask const& task);
+
+    std::vector<Worker*> _workers;
+    std::atomic<uint32> _nextWorker;
+    std::atomic<uint32> _pendingTasks;
+    std::atomic<uint32> _sleepingWorkers;
+    std::atomic<bool> _stopped;
+    bool _started;
+    std::once_flag _startFlag;
+
+    std::vector<MapTask> _maps;                             // min-heap on Deadline
+    std::mutex _mapsLock;
+    std::condition_variable _mapsCond;
+};
+
+#define sMapUpdateScheduler MapUpdateScheduler::instance()
+
+#endif
@@ -8,11 +8,18 @@
 #endif
 
 ThreadPoolMap::ThreadPoolMap()
-    : requestCount_(0)
+    : queue_(QueueSize), pending_(0), queued_(0), sleepers_(0), waiters_(0), stopped_(false), scheduler_(nullptr)
+{ }
+
+ThreadPoolMap::ThreadPoolMap(MapUpdateScheduler* scheduler)
+    : queue_(1), pending_(0), queued_(0), sleepers_(0), waiters_(0), stopped_(false), scheduler_(scheduler)
 { }
 
 void ThreadPoolMap::start(std::size_t numThreads)
 {
+    if (scheduler_)
+        return;
+
     threads_.resize(numThreads, nullptr);
     for (std::size_t i = 0; i < numThreads; ++i)
         threads_[i] = new std::thread(&ThreadPoolMap::threadFunc, this);
@@ -20,8 +27,17 @@ void ThreadPoolMap::start(std::size_t numThreads)
 
 void ThreadPoolMap::stop()
 {
-    if (!queue_.frozen()) {
-        queue_.freeze();
+    if (scheduler_)
+    {
+        scheduler_->Wait(group_);
+        return;
+    }
+
+    if (!stopped_.exchange(true)) {
+        {
+            GuardType g(lock_);
+            idleCond_.notify_all();
+        }
         for (auto* t : threads_)
         {
             t->join();
@@ -32,8 +48,10 @@ void ThreadPoolMap::stop()
 
 void ThreadPoolMap::terminate()
 {
-    if (!queue_.frozen()) {
-        queue_.freeze();
+    if (scheduler_)
+        return;
+
+    if (!stopped_.exchange(true)) {
         for (auto* t : threads_)
         {
             t->detach();
@@ -49,19 +67,58 @@ void ThreadPoolMap::terminate()
 
 void ThreadPoolMap::wait()
 {
-    GuardType guard(lock_);
-    waitCond_.wait(guard, [this] { return requestCount_ == 0; });
+    if (scheduler_)
+    {
+        scheduler_->Wait(group_);
+        return;
+    }
+
+    FunctorType f;
+    while (pending_.load(std::memory_order_acquire) != 0)
+    {
+        // Help the workers while there are queued jobs
+        if (queue_.try_pop(f))
+        {
+            queued_.fetch_sub(1);
+            execute(f);
+            continue;
+        }
+
+        GuardType guard(lock_);
+        ++waiters_;
+        waitCond_.wait(guard, [this] { return pending_.load() == 0; });
+        --waiters_;
+    }
+}
+
+void ThreadPoolMap::execute(FunctorType& task)
+{
+    task();
+    task.reset();
+
+    if (pending_.fetch_sub(1, std::memory_order_acq_rel) == 1 && waiters_.load())
+    {
+        GuardType g(lock_);
+        waitCond_.notify_all();
+    }
 }
 
 void ThreadPoolMap::threadFunc()
 {
     cds::threading::Manager::attachThread();
     FunctorType f;
-    while (queue_.pop(f)) {
-        f();
+    while (!stopped_.load(std::memory_order_acquire)) {
+        if (queue_.try_pop(f))
+        {
+            queued_.fetch_sub(1);
+            execute(f);
+            continue;
+        }
+
         GuardType g(lock_);
-        if (--requestCount_ == 0)
-            waitCond_.notify_all();
+        ++sleepers_;
+        idleCond_.wait(g, [this] { return stopped_.load() || queued_.load() > 0; });
+        --sleepers_;
     }
     cds::threading::Manager::detachThread();
 }
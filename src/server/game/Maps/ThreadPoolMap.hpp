@@ -1,10 +1,11 @@
 #ifndef TRINITY_SHARED_THREAD_POOL_MAP_HPP
 #define TRINITY_SHARED_THREAD_POOL_MAP_HPP
 
-#include "SynchronizedQueue.hpp"
+#include "BoundedMPMCQueue.hpp"
+#include "MapUpdateScheduler.h"
 
+#include <atomic>
 #include <condition_variable>
-#include <functional>
 #include <mutex>
 #include <thread>
 #include <vector>
@@ -14,46 +15,91 @@
 #include <cds/init.h>
 #include <cds/gc/hp.h>
 
+// Jobs are kept in a lock-free ring of inline tasks: schedule and completion don't allocate
+// and don't touch lock_, which is only taken to park idle workers and the waiting thread.
 class ThreadPoolMap final
 {
     typedef std::mutex LockType;
 
     typedef std::unique_lock<LockType> GuardType;
 
-    typedef std::function<void()> FunctorType;
+    typedef MapUpdateScheduler::TaskType FunctorType;
 
-    typedef Trinity::SynchronizedQueue<FunctorType> QueueType;
+    typedef Trinity::BoundedMPMCQueue<FunctorType> QueueType;
+
+    static std::size_t const QueueSize = 4096;
 
 public:
 
     ThreadPoolMap();
+    // Shared mode: no own threads, jobs are spawned on the map update scheduler
+    explicit ThreadPoolMap(MapUpdateScheduler* scheduler);
     void start(std::size_t numThreads);
 
     void stop();
     void terminate();
 
+    bool shared() const { return scheduler_ != nullptr; }
+
     template <typename RequestType>
     void schedule(RequestType request)
     {
-        GuardType g(lock_);
-        if (queue_.push(std::move(request)))
-            ++requestCount_;
+        if (scheduler_)
+        {
+            scheduler_->Spawn(group_, FunctorType(std::move(request)));
+            return;
+        }
+
+        if (stopped_.load(std::memory_order_acquire))
+            return;
+
+        pending_.fetch_add(1, std::memory_order_relaxed);
+
+        FunctorType task(std::move(request));
+        if (!queue_.try_push(task))
+        {
+            // Ring is full, the caller does the job itself
+            execute(task);
+            return;
+        }
+
+        queued_.fetch_add(1);
+        if (sleepers_.load())
+        {
+            GuardType g(lock_);
+            idleCond_.notify_one();
+        }
     }
 
     void wait();
 
 private:
     void threadFunc();
+    void execute(FunctorType& task);
 
     QueueType queue_;
 
     std::vector<std::thread*> threads_;
 
-    int requestCount_;
+    std::atomic<int32_t> pending_;                          // scheduled and not finished jobs
+
+    std::atomic<int32_t> queued_;                           // jobs in queue_, may be briefly negative
+
+    std::atomic<int32_t> sleepers_;
+
+    std::atomic<int32_t> waiters_;
+
+    std::atomic<bool> stopped_;
 
     LockType lock_;
 
+    std::condition_variable idleCond_;
+
     std::condition_variable waitCond_;
+
+    MapUpdateScheduler* scheduler_;
+
+    MapUpdateScheduler::TaskGroup group_;
 };
 
 #endif // TRINITY_SHARED_THREAD_POOL_MGR_HPP
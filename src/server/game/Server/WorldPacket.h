@@ -23,6 +23,8 @@
 #include "Opcodes.h"
 #include "ByteBuffer.h"
 
+#include <memory>
+
 class WorldPacket : public ByteBuffer
 {
     public:
@@ -75,4 +77,13 @@ class WorldPacket : public ByteBuffer
         ConnectionType _connection;
 };
 
+// Immutable packet shared by all recipients of a broadcast, sockets only add their own header, compression and encryption
+typedef std::shared_ptr<WorldPacket const> SharedWorldPacket;
+
+inline SharedWorldPacket MakeSharedWorldPacket(WorldPacket const* packet)
+{
+    const_cast<WorldPacket*>(packet)->FlushBits();
+    return std::make_shared<WorldPacket const>(*packet);
+}
+
 #endif
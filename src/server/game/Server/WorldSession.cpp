@@ -63,6 +63,11 @@
 #include "WorldSocket.h"
 
 #define MAX_PROCESSED_PACKETS_IN_SAME_WORLDSESSION_UPDATE 100
+#define RECV_PACKET_POOL_SIZE 32
+#define RECV_PACKET_POOL_MAX_STORAGE 4096                   // bigger payloads are freed instead of kept in the pool
+
+std::atomic<uint32> WorldSession::RecvPacketCount[OPCODE_COUNT];
+std::atomic<uint32> WorldSession::RecvPacketAllocations[OPCODE_COUNT];
 
 WorldPackets::Null::Null(WorldPacket&& packet): ClientPacket(std::move(packet))
 {
@@ -75,7 +80,7 @@ void WorldPackets::Null::Read()
 
 WorldSession::WorldSession(uint32 id, std::string&& name, const std::shared_ptr<WorldSocket>& sock, AccountTypes sec, uint8 expansion, time_t mute_time, std::string os, LocaleConstant locale, uint32 recruiter, bool isARecruiter, AuthFlags flag, std::unordered_map<uint8, int64>&& accountTokenMap, uint32 referer):
 m_muteTime(mute_time), m_timeOutTime(0), _countPenaltiesHwid(0), _player(nullptr), m_map(nullptr), _security(sec), _accountId(id), m_expansion(expansion), m_accountExpansion(expansion), _logoutTime(0), m_inQueue(false), m_playerLogout(false), m_playerRecentlyLogout(false),
-m_playerSave(false), m_sessionDbLocaleIndex(locale), m_latency(0), _tutorialsChanged(TUTORIALS_FLAG_NONE), recruiterId(recruiter), isRecruiter(isARecruiter), playerLoginCounter(0), forceExit(false), m_sUpdate(false), wardenModuleFailed(false), atAuthFlag(flag), canLogout(false),
+m_playerSave(false), m_sessionDbLocaleIndex(locale), m_latency(0), _tutorialsChanged(TUTORIALS_FLAG_NONE), recruiterId(recruiter), isRecruiter(isARecruiter), _recvPacketPool(RECV_PACKET_POOL_SIZE), playerLoginCounter(0), forceExit(false), m_sUpdate(false), wardenModuleFailed(false), atAuthFlag(flag), canLogout(false),
 tokens(accountTokenMap), _referer(referer)
 {
     _os = std::move(os);
@@ -143,6 +148,9 @@ WorldSession::~WorldSession()
     while (_recvQueue.next(packet))
         delete packet;
 
+    while (_recvPacketPool.try_pop(packet))
+        delete packet;
+
     LoginDatabase.PExecute("UPDATE account SET online = 0 WHERE id = %u;", GetAccountId());     // One-time query
     sWorld->DecreaseSessionCount();
 }
@@ -178,35 +186,35 @@ ObjectGuid::LowType WorldSession::GetGuidLow() const
     return GetPlayer() ? GetPlayer()->GetGUIDLow() : 0;
 }
 
-/// Send a packet to the client
-void WorldSession::SendPacket(WorldPacket const* packet, bool forced /*= false*/)
+/// Validate a packet about to be sent and pick the connection it goes through
+bool WorldSession::CanSendPacket(WorldPacket const* packet, bool forced, ConnectionType& conIdx)
 {
     uint32 opcode = packet->GetOpcode();
     if (opcode == NULL_OPCODE)
     {
         TC_LOG_ERROR("misc", "Prevented sending of NULL_OPCODE to %s", GetPlayerName(false).c_str());
-        return;
+        return false;
     }
     if (opcode == MAX_OPCODE)
     {
         TC_LOG_ERROR("misc", "Prevented sending of wrong opcode to %s", GetPlayerName(false).c_str());
-        return;
+        return false;
     }
 
     ServerOpcodeHandler const* handler = opcodeTable[static_cast<OpcodeServer>(opcode)];
     if (!handler)
     {
         TC_LOG_ERROR("misc", "Prevented sending of opcode %u with non existing handler to %s", opcode, GetPlayerName().c_str());
-        return;
+        return false;
     }
 
-    ConnectionType conIdx = handler->ConnectionIndex;
+    conIdx = handler->ConnectionIndex;
     if (packet->GetConnection() != CONNECTION_TYPE_DEFAULT)
     {
         if (packet->GetConnection() != CONNECTION_TYPE_INSTANCE && IsInstanceOnlyOpcode(opcode))
         {
             TC_LOG_ERROR("misc", "Prevented sending of instance only opcode %u with connection type %u to %s", opcode, packet->GetConnection(), GetPlayerName().c_str());
-            return;
+            return false;
         }
 
         conIdx = packet->GetConnection();
@@ -215,15 +223,26 @@ void WorldSession::SendPacket(WorldPacket const* packet, bool forced /*= false*/
     if (!m_Socket[conIdx])
     {
         TC_LOG_DEBUG("misc", "Prevented sending of %s to non existent socket %u to %s", GetOpcodeNameForLogging(static_cast<OpcodeServer>(opcode)).c_str(), conIdx, GetPlayerName().c_str());
-        return;
+        return false;
     }
 
     if (!forced && handler->Status == STATUS_UNHANDLED)
     {
         TC_LOG_ERROR("misc", "Prevented sending disabled opcode %s to %s", GetOpcodeNameForLogging(static_cast<OpcodeServer>(opcode)).c_str(), GetPlayerName().c_str());
-        return;
+        return false;
     }
 
+    return true;
+}
+
+/// Send a packet to the client
+void WorldSession::SendPacket(WorldPacket const* packet, bool forced /*= false*/)
+{
+    ConnectionType conIdx;
+    if (!CanSendPacket(packet, forced, conIdx))
+        return;
+
+    uint32 opcode = packet->GetOpcode();
     uint32 packetSize = packet->size();
     uint32 start_time = getMSTime();
     const_cast<WorldPacket*>(packet)->FlushBits();
@@ -235,7 +254,53 @@ void WorldSession::SendPacket(WorldPacket const* packet, bool forced /*= false*/
         sLog->outDiff(" >> SendPacket DIFF %u player_guid %u _mapID_ %i AccountId %u opcode %u packetSize %u", getMSTime() - start_time, (_player && !_player->IsDelete()) ? _player->GetGUIDLow() : 0, (_player && !_player->IsDelete()) ? _player->GetMapId() : -1, GetAccountId(), opcode, packetSize);
 }
 
+/// Send a broadcast packet, the payload is shared with the other recipients instead of copied per socket
+void WorldSession::SendPacket(SharedWorldPacket const& packet, bool forced /*= false*/)
+{
+    ConnectionType conIdx;
+    if (!CanSendPacket(packet.get(), forced, conIdx))
+        return;
+
+    if (std::shared_ptr<WorldSocket> socket = m_Socket[conIdx])
+        socket->SendPacket(packet);
+}
+
 /// Add an incoming packet to the queue
+WorldPacket* WorldSession::AcquireRecvPacket(uint16 opcode)
+{
+    WorldPacket* packet = nullptr;
+    if (_recvPacketPool.try_pop(packet))
+        return packet;
+
+    if (opcode < OPCODE_COUNT)
+        RecvPacketAllocations[opcode].fetch_add(1, std::memory_order_relaxed);
+
+    return new WorldPacket();
+}
+
+void WorldSession::ReleaseRecvPacket(WorldPacket* packet)
+{
+    if (packet->capacity() > RECV_PACKET_POOL_MAX_STORAGE)
+    {
+        delete packet;
+        return;
+    }
+
+    packet->clear();
+    if (!_recvPacketPool.try_push(packet))
+        delete packet;
+}
+
+void WorldSession::CountRecvPacket(uint16 opcode, bool allocated)
+{
+    if (opcode >= OPCODE_COUNT)
+        return;
+
+    RecvPacketCount[opcode].fetch_add(1, std::memory_order_relaxed);
+    if (allocated)
+        RecvPacketAllocations[opcode].fetch_add(1, std::memory_order_relaxed);
+}
+
 void WorldSession::QueuePacket(WorldPacket* new_packet)
 {
     _recvQueue.add(new_packet);
@@ -306,7 +371,7 @@ bool WorldSession::Update(uint32 diff, Map* map)
     {
         sLog->outSpamm("WorldSession::Update ddos KickPlayer _mapID_ %i Update time - %ums diff %u _player_guid_ %u _recvQueue %u", _mapID_, _ms, diff, _player_guid_, _recvQueue.size());
         while (_recvQueue.next(packet))
-            delete packet;
+            ReleaseRecvPacket(packet);
         KickPlayer();
     }
 
@@ -392,7 +457,7 @@ bool WorldSession::Update(uint32 diff, Map* map)
         }
 
         if (deletePacket)
-            delete packet;
+            ReleaseRecvPacket(packet);
 
         deletePacket = true;
         processedPackets++;
@@ -24,6 +24,7 @@
 #define __WORLDSESSION_H
 
 #include "AddonMgr.h"
+#include "BoundedMPMCQueue.hpp"
 #include "Common.h"
 #include "Cryptography/BigNumber.h"
 #include "EventProcessor.h"
@@ -1061,6 +1062,7 @@ class WorldSession
         bool IsAddonRegistered(std::string const& prefix);
 
         void SendPacket(WorldPacket const* packet, bool forced = false);
+        void SendPacket(SharedWorldPacket const& packet, bool forced = false);
         void AddInstanceConnection(std::shared_ptr<WorldSocket> sock) { m_Socket[CONNECTION_TYPE_INSTANCE] = sock; }
         void SendNotification(const char *format, ...) ATTR_PRINTF(2, 3);
         void SendNotification(uint32 string_id, ...);
@@ -1134,6 +1136,15 @@ class WorldSession
         void QueuePacket(WorldPacket* new_packet);
         bool Update(uint32 diff, Map* map = nullptr);
 
+        // Received packets come from a per session pool (network thread) and go back to it once handled (session update)
+        WorldPacket* AcquireRecvPacket(uint16 opcode);
+        void ReleaseRecvPacket(WorldPacket* packet);
+
+        // Receive path counters per client opcode, allocations are payload storage growth and packets missing the pool
+        static void CountRecvPacket(uint16 opcode, bool allocated);
+        static std::atomic<uint32> RecvPacketCount[OPCODE_COUNT];
+        static std::atomic<uint32> RecvPacketAllocations[OPCODE_COUNT];
+
         /// Handle the authentication waiting queue (to be completed)
         void SendAuthWaitQue(uint32 position);
 
@@ -2056,6 +2067,8 @@ class WorldSession
     private:
         void ProcessQueryCallbacks();
 
+        bool CanSendPacket(WorldPacket const* packet, bool forced, ConnectionType& conIdx);
+
         QueryResultHolderFuture _realmAccountLoginCallback;
         QueryResultHolderFuture _accountLoginCallback;
         QueryResultHolderFuture _charLoginCallback;
@@ -2121,6 +2134,7 @@ class WorldSession
         uint32 recruiterId;
         bool isRecruiter;
         LockedQueue<WorldPacket*> _recvQueue;
+        Trinity::BoundedMPMCQueue<WorldPacket*> _recvPacketPool;
         uint8 playerLoginCounter;
         uint32 expireTime;
         bool forceExit;
@@ -224,43 +224,28 @@ bool WorldSocket::Update()
 {
     uint32 _s = getMSTime();
     uint32 bufferSize = 0;
-    std::queue<EncryptablePacket> _aBufferQueue;
     if (!_bufferQueue.empty())
     {
         _bufferQueueLock.lock();
         bufferSize = _bufferQueue.size();
-        std::swap(_aBufferQueue, _bufferQueue);
+        std::swap(_flushQueue, _bufferQueue);
         _bufferQueueLock.unlock();
     }
 
-    MessageBuffer buffer;
-    while (!_aBufferQueue.empty())
+    // Every frame of this tick goes into one recycled buffer, the base socket writes the whole write queue with one gather write
+    if (!_flushQueue.empty())
     {
-        auto queued = std::move(_aBufferQueue.front());
-        _aBufferQueue.pop();
+        std::size_t flushSize = 0;
+        for (EncryptablePacket const& queued : _flushQueue)
+            flushSize += GetMaxFrameSize(queued);
 
-        uint32 packetSize = queued.size();
-        if (packetSize > MinSizeForCompression && queued.NeedsEncryption())
-            packetSize = compressBound(packetSize) + sizeof(CompressedWorldPacket);
-
-        if (buffer.GetRemainingSpace() < packetSize + SizeOfHeader)
-        {
-            QueuePacket(std::move(buffer));
-            buffer.Resize(4096);  // NOLINT
-        }
-
-        if (buffer.GetRemainingSpace() >= packetSize + SizeOfHeader)
+        MessageBuffer buffer = AcquireWriteBuffer(flushSize);
+        for (EncryptablePacket const& queued : _flushQueue)
             WritePacketToBuffer(queued, buffer);
-        else    // single packet larger than 4096 bytes
-        {
-            MessageBuffer packetBuffer(packetSize + SizeOfHeader);
-            WritePacketToBuffer(queued, packetBuffer);
-            QueuePacket(std::move(packetBuffer));
-        }
-    }
 
-    if (buffer.GetActiveSize() > 0)
+        _flushQueue.clear();
         QueuePacket(std::move(buffer));
+    }
 
     uint32 _ms = GetMSTimeDiffToNow(_s);
     if (_ms > 200)
@@ -381,6 +366,9 @@ bool WorldSocket::ReadHeaderHandler()
         return false;
     }
 
+    // storage recycled from the session packet pool only grows for payloads bigger than any it held before
+    WorldSession::CountRecvPacket(header->Command, header->Size > _packetBuffer.GetCapacity());
+
     _packetBuffer.Resize(header->Size);
     return true;
 }
@@ -524,8 +512,11 @@ WorldSocket::ReadDataHandlerResult WorldSocket::ReadDataHandler()
             if (opcode != CMSG_UI_TIME_REQUEST)
                 _worldSession->ResetTimeOutTime();
 
-            // Copy the packet to the heap before enqueuing
-            _worldSession->QueuePacket(new WorldPacket(std::move(packet)));
+            // The payload moves into a pooled packet, the storage that packet held before receives the next payload
+            WorldPacket* queued = _worldSession->AcquireRecvPacket(opcode);
+            _packetBuffer = MessageBuffer(queued->Move());
+            *queued = std::move(packet);
+            _worldSession->QueuePacket(queued);
             break;
         }
     }
@@ -546,6 +537,16 @@ void WorldSocket::SendPacket(WorldPacket const& packet)
     if (!IsOpen())
         return;
 
+    SendPacket(std::make_shared<WorldPacket const>(packet));
+}
+
+void WorldSocket::SendPacket(SharedWorldPacket const& sharedPacket)
+{
+    if (!IsOpen())
+        return;
+
+    WorldPacket const& packet = *sharedPacket;
+
     // uint32 opcode = packet.GetOpcode();
     uint32 packetSize = packet.size();
     if (packetSize > 0x7FFFFFF) // If packet size bugget, don`t send it http://pastebin.com/Q0xG8aGp
@@ -557,12 +558,22 @@ void WorldSocket::SendPacket(WorldPacket const& packet)
         TC_LOG_TRACE("network.opcode", "S->C: %s Size %u %s connection %i, connectionType %i", GetOpcodeNameForLogging(static_cast<OpcodeServer>(packet.GetOpcode())).c_str(), packetSize, GetRemoteIpAddress().to_string().c_str(), packet.GetConnection(), GetConnectionType());
 
     _bufferQueueLock.lock();
-    _bufferQueue.emplace(EncryptablePacket(packet, _authCrypt.IsInitialized()));
+    _bufferQueue.emplace_back(sharedPacket, _authCrypt.IsInitialized());
     _bufferQueueLock.unlock();
 }
 
-void WorldSocket::WritePacketToBuffer(EncryptablePacket const& packet, MessageBuffer& buffer)
+std::size_t WorldSocket::GetMaxFrameSize(EncryptablePacket const& queued) const
+{
+    std::size_t packetSize = queued.GetPacket().size();
+    if (packetSize > MinSizeForCompression && queued.NeedsEncryption())
+        packetSize = compressBound(packetSize) + sizeof(CompressedWorldPacket);
+
+    return packetSize + SizeOfHeader;
+}
+
+void WorldSocket::WritePacketToBuffer(EncryptablePacket const& queued, MessageBuffer& buffer)
 {
+    WorldPacket const& packet = queued.GetPacket();
     uint32 opcode = packet.GetOpcode();
     uint32 packetSize = packet.size();
 
@@ -570,7 +581,7 @@ void WorldSocket::WritePacketToBuffer(EncryptablePacket const& packet, MessageBu
     uint8* headerPos = buffer.GetWritePointer();
     buffer.WriteCompleted(SizeOfHeader);
 
-    if (packetSize > MinSizeForCompression && packet.NeedsEncryption())
+    if (packetSize > MinSizeForCompression && queued.NeedsEncryption())
     {
         CompressedWorldPacket cmp;
         cmp.UncompressedSize = packetSize + 2;
@@ -29,14 +29,17 @@
 
 struct z_stream_s;
 
-class EncryptablePacket : public WorldPacket
+// Queued reference to a packet payload, possibly shared with the send queues of other sockets
+class EncryptablePacket
 {
 public:
-    EncryptablePacket(WorldPacket const& packet, bool encrypt) : WorldPacket(packet), _encrypt(encrypt) { }
+    EncryptablePacket(SharedWorldPacket packet, bool encrypt) : _packet(std::move(packet)), _encrypt(encrypt) { }
 
+    WorldPacket const& GetPacket() const { return *_packet; }
     bool NeedsEncryption() const { return _encrypt; }
 
 private:
+    SharedWorldPacket _packet;
     bool _encrypt;
 };
 
@@ -90,6 +93,7 @@ public:
     bool Update() override;
 
     void SendPacket(WorldPacket const& packet);
+    void SendPacket(SharedWorldPacket const& packet);
 
     ConnectionType GetConnectionType() const { return _type; }
 
@@ -114,6 +118,7 @@ private:
     void CheckIpCallback(PreparedQueryResult result);
     void InitializeHandler(boost::system::error_code error, std::size_t transferedBytes);
     void LogOpcodeText(OpcodeClient opcode, std::unique_lock<std::mutex> const& guard) const;
+    std::size_t GetMaxFrameSize(EncryptablePacket const& packet) const;
     void WritePacketToBuffer(EncryptablePacket const& packet, MessageBuffer& buffer);
     uint32 CompressPacket(uint8* buffer, WorldPacket const& packet);
 
@@ -146,8 +151,9 @@ private:
 
     MessageBuffer _headerBuffer;
     MessageBuffer _packetBuffer;
-    std::queue<EncryptablePacket> _bufferQueue;
+    std::vector<EncryptablePacket> _bufferQueue;
     sf::contention_free_shared_mutex< > _bufferQueueLock;
+    std::vector<EncryptablePacket> _flushQueue;             // network thread only, swapped with _bufferQueue
 
     z_stream_s* _compressionStream;
 
@@ -42,6 +42,8 @@ class AuraEffect
         Aura* GetBase() const { return m_base; }
         void GetTargetList(std::list<Unit*> & targetList) const;
         void GetApplicationList(std::list<AuraApplication*> & applicationList) const;
+        // amount changed, cached aura modifiers of the targets are stale
+        void InvalidateTargetsAuraModifierCache() const;
         SpellModifier* GetSpellModifier() const { return m_spellmod; }
 
         SpellInfo const* GetSpellInfo() const { return m_spellInfo; }
@@ -82,6 +84,7 @@ class AuraEffect
             if (m_amount != amount)
             {
                 m_amount = amount;
+                InvalidateTargetsAuraModifierCache();
                 GetBase()->SetNeedClientUpdateForTargets();
                 GetBase()->UpdateConcatenateAura(GetCaster(), m_amount, m_effIndex);
             }
@@ -2055,8 +2055,10 @@ void Spell::SearchAreaTargets(std::list<WorldObject*>& targets, float range, Pos
         return;
     Unit* caster = m_originalCaster ? m_originalCaster : m_caster;
     Trinity::WorldObjectSpellAreaTargetCheck check(range, position, caster, referer, m_spellInfo, selectionType, condList, allowObjectSize);
-    Trinity::WorldObjectListSearcher<Trinity::WorldObjectSpellAreaTargetCheck> searcher(caster, targets, check, containerTypeMask);
-    SearchTargets<Trinity::WorldObjectListSearcher<Trinity::WorldObjectSpellAreaTargetCheck> > (searcher, containerTypeMask, caster, position, range);
+    m_areaTargetCandidates.clear();
+    Trinity::WorldObjectSpellAreaSearcher searcher(m_areaTargetCandidates, check, containerTypeMask);
+    SearchTargets<Trinity::WorldObjectSpellAreaSearcher> (searcher, containerTypeMask, caster, position, range);
+    targets.insert(targets.end(), m_areaTargetCandidates.begin(), m_areaTargetCandidates.end());
 }
 
 void Spell::SearchChainTargets(std::list<WorldObject*>& targets, uint32 chainTargets, WorldObject* target, SpellTargetObjectTypes objectType, SpellTargetCheckTypes selectType, ConditionList* condList, bool isChainHeal)
@@ -6901,7 +6903,7 @@ SpellCastResult Spell::CheckCast(bool strict)
 
     ConditionSourceInfo condInfo = ConditionSourceInfo(m_caster);
     condInfo.mConditionTargets[1] = m_targets.GetObjectTarget();
-    ConditionList conditions = sConditionMgr->GetConditionsForNotGroupedEntry(CONDITION_SOURCE_TYPE_SPELL, m_spellInfo->Id);
+    ConditionList const& conditions = sConditionMgr->GetConditionsForNotGroupedEntry(CONDITION_SOURCE_TYPE_SPELL, m_spellInfo->Id);
     if (!conditions.empty() && !sConditionMgr->IsObjectMeetToConditions(condInfo, conditions))
     {
         // send error msg to player if condition failed and text message available
@@ -10763,6 +10765,11 @@ bool WorldObjectSpellAreaTargetCheck::operator()(WorldObject* target)
     if (!target->IsWithinDist3d(_position, _range, _allowObjectSize))
         return false;
 
+    return CheckInRange(target);
+}
+
+bool WorldObjectSpellAreaTargetCheck::CheckInRange(WorldObject* target)
+{
     // TOS: The Desolate Host
     if (auto _target = target->ToUnit())
         if (!_caster->IsValidDesolateHostTarget(_target, _spellInfo))
@@ -10774,6 +10781,135 @@ bool WorldObjectSpellAreaTargetCheck::operator()(WorldObject* target)
     return WorldObjectSpellTargetCheck::operator ()(target);
 }
 
+namespace
+{
+    // Packed positions of one cell container, reused by every cell and every cast of the thread
+    struct SpellAreaSearchBuffer
+    {
+        std::vector<float> X;
+        std::vector<float> Y;
+        std::vector<float> Z;
+        std::vector<float> ReachSq;
+        std::vector<uint8> InRange;
+
+        void Resize(std::size_t count)
+        {
+            if (X.size() >= count)
+                return;
+
+            X.resize(count);
+            Y.resize(count);
+            Z.resize(count);
+            ReachSq.resize(count);
+            InRange.resize(count);
+        }
+    };
+
+    thread_local SpellAreaSearchBuffer t_areaSearchBuffer;
+}
+
+template <class T>
+void WorldObjectSpellAreaSearcher::VisitInRange(std::vector<T*>& objects)
+{
+    std::size_t count = objects.size();
+    if (!count)
+        return;
+
+    SpellAreaSearchBuffer& buffer = t_areaSearchBuffer;
+    buffer.Resize(count);
+
+    float* x = buffer.X.data();
+    float* y = buffer.Y.data();
+    float* z = buffer.Z.data();
+    float* reachSq = buffer.ReachSq.data();
+    uint8* inRange = buffer.InRange.data();
+
+    // same test as WorldObject::IsWithinDist3d
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        T const* object = objects[i];
+        float reach = i_check._range + (i_check._allowObjectSize ? object->GetObjectSize() : 0.0f);
+        x[i] = object->m_positionX;
+        y[i] = object->m_positionY;
+        z[i] = object->GetPositionZH();
+        reachSq[i] = reach * reach;
+    }
+
+    float const centerX = i_check._position->m_positionX;
+    float const centerY = i_check._position->m_positionY;
+    float const centerZ = i_check._position->GetPositionZH();
+
+    // no calls or branches, left to the compiler to vectorize
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        float dx = x[i] - centerX;
+        float dy = y[i] - centerY;
+        float dz = z[i] - centerZ;
+        inRange[i] = (dx * dx + dy * dy + dz * dz) < reachSq[i];
+    }
+
+    // the buffer is free before the checks run, they may search again
+    std::size_t first = i_objects.size();
+    for (std::size_t i = 0; i < count; ++i)
+        if (inRange[i])
+            i_objects.push_back(objects[i]);
+
+    std::size_t kept = first;
+    for (std::size_t i = first; i < i_objects.size(); ++i)
+        if (i_check.CheckInRange(i_objects[i]))
+            i_objects[kept++] = i_objects[i];
+
+    i_objects.resize(kept);
+}
+
+void WorldObjectSpellAreaSearcher::Visit(PlayerMapType& m)
+{
+    if (i_mapTypeMask & GRID_MAP_TYPE_MASK_PLAYER)
+        VisitInRange(m);
+}
+
+void WorldObjectSpellAreaSearcher::Visit(CreatureMapType& m)
+{
+    if (i_mapTypeMask & GRID_MAP_TYPE_MASK_CREATURE)
+        VisitInRange(m);
+}
+
+void WorldObjectSpellAreaSearcher::Visit(CorpseMapType& m)
+{
+    if (i_mapTypeMask & GRID_MAP_TYPE_MASK_CORPSE)
+        VisitInRange(m);
+}
+
+void WorldObjectSpellAreaSearcher::Visit(GameObjectMapType& m)
+{
+    if (i_mapTypeMask & GRID_MAP_TYPE_MASK_GAMEOBJECT)
+        VisitInRange(m);
+}
+
+void WorldObjectSpellAreaSearcher::Visit(DynamicObjectMapType& m)
+{
+    if (i_mapTypeMask & GRID_MAP_TYPE_MASK_DYNAMICOBJECT)
+        VisitInRange(m);
+}
+
+void WorldObjectSpellAreaSearcher::Visit(AreaTriggerMapType& m)
+{
+    if (i_mapTypeMask & GRID_MAP_TYPE_MASK_AREATRIGGER)
+        VisitInRange(m);
+}
+
+void WorldObjectSpellAreaSearcher::Visit(ConversationMapType& m)
+{
+    if (i_mapTypeMask & GRID_MAP_TYPE_MASK_CONVERSATION)
+        VisitInRange(m);
+}
+
+void WorldObjectSpellAreaSearcher::Visit(EventObjectMapType& m)
+{
+    if (i_mapTypeMask & GRID_MAP_TYPE_MASK_EVENTOBJECT)
+        VisitInRange(m);
+}
+
 WorldObjectSpellBetweenTargetCheck::WorldObjectSpellBetweenTargetCheck(float width, float range, Unit* caster, Position const* position, Unit* referer,
     SpellInfo const* spellInfo, SpellTargetCheckTypes selectionType, ConditionList* condList)
     : WorldObjectSpellAreaTargetCheck(range, caster, caster, referer, spellInfo, selectionType, condList), _width(width), _range(range), _position(position)
@@ -767,6 +767,8 @@ class Spell
         std::vector<SpellLogEffectFeedPetParams> _feedPetTargets[MAX_SPELL_EFFECTS];
 
         uint16 m_currentExecutedEffect;       //pointer for get current executed effect in effect functions
+
+        std::vector<WorldObject*> m_areaTargetCandidates;   // SearchAreaTargets output, kept for the next effects and chain jumps
 };
 
 namespace Trinity
@@ -800,6 +802,35 @@ namespace Trinity
         bool _allowObjectSize;
         WorldObjectSpellAreaTargetCheck(float range, Position const* position, Unit* caster, Unit* referer, SpellInfo const* spellInfo, SpellTargetCheckTypes selectionType, ConditionList* condList, bool allowObjectSize = true);
         bool operator()(WorldObject* target);
+        // everything but the distance
+        bool CheckInRange(WorldObject* target);
+    };
+
+    // Two pass visitor of Spell::SearchAreaTargets: the positions of a cell container are packed and tested against
+    // the area in one branch free loop, the expensive WorldObjectSpellAreaTargetCheck only runs on the objects in range
+    struct WorldObjectSpellAreaSearcher
+    {
+        uint32 i_mapTypeMask;
+        std::vector<WorldObject*>& i_objects;
+        WorldObjectSpellAreaTargetCheck& i_check;
+
+        WorldObjectSpellAreaSearcher(std::vector<WorldObject*>& objects, WorldObjectSpellAreaTargetCheck& check, uint32 mapTypeMask)
+            : i_mapTypeMask(mapTypeMask), i_objects(objects), i_check(check) {}
+
+        void Visit(PlayerMapType& m);
+        void Visit(CreatureMapType& m);
+        void Visit(CorpseMapType& m);
+        void Visit(GameObjectMapType& m);
+        void Visit(DynamicObjectMapType& m);
+        void Visit(AreaTriggerMapType& m);
+        void Visit(ConversationMapType& m);
+        void Visit(EventObjectMapType& m);
+
+        template <typename NotInterested>
+        void Visit(NotInterested&) {}
+
+        template <class T>
+        void VisitInRange(std::vector<T*>& objects);
     };
 
     struct WorldObjectSpellBetweenTargetCheck : WorldObjectSpellAreaTargetCheck
@@ -412,7 +412,7 @@ public:
     uint32    ItemType;
     uint32    TriggerSpell;
     flag128   SpellClassMask;
-    std::list<Condition*>* ImplicitTargetConditions;
+    std::vector<Condition*>* ImplicitTargetConditions;
     float     BonusCoefficientFromAP;
     float PvPMultiplier;
     float SpellEffectGroupSizeCoefficient;
@@ -0,0 +1,124 @@
+/*
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "WordFilterMatcher.h"
+
+#include <algorithm>
+#include <map>
+#include <queue>
+
+WordFilterMatcher::WordFilterMatcher(std::set<std::wstring> const& words)
+{
+    // build the trie, children are kept in maps only while building
+    std::vector<std::map<wchar_t, uint32>> children(1);
+    m_nodes.emplace_back();
+
+    for (std::wstring const& word : words)
+    {
+        // an empty word would match any text
+        if (word.empty())
+            continue;
+
+        uint32 node = 0;
+        for (wchar_t letter : word)
+        {
+            auto itr = children[node].find(letter);
+            if (itr == children[node].end())
+            {
+                uint32 child = uint32(m_nodes.size());
+                m_nodes.emplace_back();
+                children.emplace_back();
+                children[node][letter] = child;
+                node = child;
+            }
+            else
+                node = itr->second;
+        }
+
+        if (m_nodes[node].word == NoWord)
+        {
+            m_nodes[node].word = uint32(m_words.size());
+            m_words.push_back(word);
+        }
+    }
+
+    for (uint32 node = 0; node < m_nodes.size(); ++node)
+    {
+        m_nodes[node].firstEdge = uint32(m_edges.size());
+        m_nodes[node].edgeCount = uint32(children[node].size());
+        m_edges.insert(m_edges.end(), children[node].begin(), children[node].end());
+    }
+
+    // fail links in breadth first order, so the fail node of a node is always complete before it
+    std::queue<uint32> queue;
+    for (auto const& edge : children[0])
+        queue.push(edge.second);
+
+    while (!queue.empty())
+    {
+        uint32 node = queue.front();
+        queue.pop();
+
+        for (auto const& edge : children[node])
+        {
+            uint32 child = edge.second;
+            uint32 fail = m_nodes[node].fail;
+            uint32 next = GetChild(fail, edge.first);
+            while (!next && fail)
+            {
+                fail = m_nodes[fail].fail;
+                next = GetChild(fail, edge.first);
+            }
+
+            m_nodes[child].fail = next;
+            if (m_nodes[child].word == NoWord)
+                m_nodes[child].word = m_nodes[next].word;
+
+            queue.push(child);
+        }
+    }
+}
+
+uint32 WordFilterMatcher::GetChild(uint32 node, wchar_t letter) const
+{
+    Node const& parent = m_nodes[node];
+    auto begin = m_edges.begin() + parent.firstEdge;
+    auto end = begin + parent.edgeCount;
+    auto itr = std::lower_bound(begin, end, letter, [](std::pair<wchar_t, uint32> const& edge, wchar_t value) { return edge.first < value; });
+    if (itr != end && itr->first == letter)
+        return itr->second;
+
+    return 0;
+}
+
+std::wstring const* WordFilterMatcher::Find(std::wstring const& text) const
+{
+    uint32 node = 0;
+    for (wchar_t letter : text)
+    {
+        uint32 next = GetChild(node, letter);
+        while (!next && node)
+        {
+            node = m_nodes[node].fail;
+            next = GetChild(node, letter);
+        }
+
+        node = next;
+        if (m_nodes[node].word != NoWord)
+            return &m_words[m_nodes[node].word];
+    }
+
+    return nullptr;
+}
@@ -0,0 +1,55 @@
+/*
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITYCORE_WORDFILTERMATCHER_H
+#define TRINITYCORE_WORDFILTERMATCHER_H
+
+#include "Define.h"
+
+#include <limits>
+#include <set>
+#include <string>
+#include <vector>
+
+// Aho-Corasick automaton over the filtered bad words, finds any of them in a single pass over the text
+class WordFilterMatcher
+{
+public:
+    explicit WordFilterMatcher(std::set<std::wstring> const& words);
+
+    // first word ending in the text, nullptr if there is none
+    std::wstring const* Find(std::wstring const& text) const;
+
+    bool Empty() const { return m_words.empty(); }
+
+private:
+    static uint32 const NoWord = std::numeric_limits<uint32>::max();
+
+    struct Node
+    {
+        uint32 firstEdge = 0;
+        uint32 edgeCount = 0;
+        uint32 fail = 0;
+        uint32 word = NoWord;                               // own word, or the longest word ending here through the fail links
+    };
+
+    uint32 GetChild(uint32 node, wchar_t letter) const;
+
+    std::vector<std::wstring> m_words;
+    std::vector<Node> m_nodes;                              // 0 is the root
+    std::vector<std::pair<wchar_t, uint32>> m_edges;        // children of each node, sorted by letter
+};
+
+#endif
@@ -23,7 +23,7 @@
 
 #define MAX_SIZE_SENTENCE 27
 
-WordFilterMgr::WordFilterMgr() 
+WordFilterMgr::WordFilterMgr() : m_loadingBadWords(false)
 {
 }
 
@@ -78,10 +78,14 @@ void WordFilterMgr::LoadBadWords()
     QueryResult result = WorldDatabase.Query("SELECT `bad_word`, `convert` FROM bad_word");
     if (!result)
     {
+        RebuildMatchers();
         TC_LOG_INFO("server.loading",">> Loaded 0 bad words. DB table `bad_word` is empty!");
         return;
     }
 
+    // one matcher build for the whole table
+    m_loadingBadWords = true;
+
     uint32 count = 0;
     do
     {
@@ -101,6 +105,8 @@ void WordFilterMgr::LoadBadWords()
     result = WorldDatabase.Query("SELECT bad_word FROM bad_word_mail");
     if (!result)
     {
+        m_loadingBadWords = false;
+        RebuildMatchers();
         TC_LOG_INFO("server.loading",">> Loaded 0 bad words. DB table `bad_word_mail` is empty!");
         return;
     }
@@ -116,6 +122,9 @@ void WordFilterMgr::LoadBadWords()
     }
     while (result->NextRow());
 
+    m_loadingBadWords = false;
+    RebuildMatchers();
+
     TC_LOG_INFO("server.loading",">> Loaded %u bad words in %u ms", count, GetMSTimeDiffToNow(oldMSTime));
 }
 
@@ -207,34 +216,39 @@ void WordFilterMgr::LoadComplaints()
 
 std::string WordFilterMgr::FindBadWord(std::string const& text, bool mail)
 {
+    std::shared_ptr<WordFilterMatcher const> matcher = std::atomic_load(&m_matcher);
+    if (!matcher || matcher->Empty())
+        return "";
+
     std::wstring _text = boost::locale::conv::utf_to_utf<wchar_t>(text);
     
     GeneralFilterWstring(_text);
 
-    if (_text.empty() || m_badWords.empty())
+    if (_text.empty())
         return "";
 
-    for (BadWordMap::const_iterator it = m_badWords.begin(); it != m_badWords.end(); ++it)
-    {
-        if (_text.find(*it) != std::wstring::npos)
-        {
-            // TC_LOG_INFO("server.loading", "Compare text %s _text %s *it %s", text.c_str(), boost::locale::conv::utf_to_utf<char>(_text).c_str(), boost::locale::conv::utf_to_utf<char>(*it).c_str());
-            return boost::locale::conv::utf_to_utf<char>(*it);
-        }
-    }
+    if (std::wstring const* badWord = matcher->Find(_text))
+        return boost::locale::conv::utf_to_utf<char>(*badWord);
 
-    if(mail)
+    if (mail)
     {
-        for (BadWordMapMail::const_iterator it = m_badWordsMail.begin(); it != m_badWordsMail.end(); ++it)
-        {
-        //    TC_LOG_INFO("server.loading", "Compare %s and %s", boost::locale::conv::utf_to_utf<char>(*it).c_str(), boost::locale::conv::utf_to_utf<char>(_text).c_str());
-            if (_text.find(*it) != std::wstring::npos)
-                return boost::locale::conv::utf_to_utf<char>(*it);
-        }
+        std::shared_ptr<WordFilterMatcher const> matcherMail = std::atomic_load(&m_matcherMail);
+        if (matcherMail)
+            if (std::wstring const* badWord = matcherMail->Find(_text))
+                return boost::locale::conv::utf_to_utf<char>(*badWord);
     }
     return "";
 }
 
+void WordFilterMgr::RebuildMatchers()
+{
+    if (m_loadingBadWords)
+        return;
+
+    std::atomic_store(&m_matcher, std::shared_ptr<WordFilterMatcher const>(std::make_shared<WordFilterMatcher>(m_badWords)));
+    std::atomic_store(&m_matcherMail, std::shared_ptr<WordFilterMatcher const>(std::make_shared<WordFilterMatcher>(m_badWordsMail)));
+}
+
 bool WordFilterMgr::AddBadWord(std::string const& badWord, bool toDB)
 {
     std::wstring _badWord = boost::locale::conv::utf_to_utf<wchar_t>(badWord);
@@ -249,6 +263,7 @@ bool WordFilterMgr::AddBadWord(std::string const& badWord, bool toDB)
     }
 
     m_badWords.insert(_badWord);
+    RebuildMatchers();
 
     if (toDB)
         WorldDatabase.PQuery("REPLACE INTO bad_word VALUES ('%s', '%s')", badWord.c_str(), boost::locale::conv::utf_to_utf<char>(_badWord).c_str());
@@ -267,6 +282,7 @@ void WordFilterMgr::AddConvert(std::string const& badWord)
         return;
 
     m_badWords.insert(_badWord);
+    RebuildMatchers();
 }
 
 bool WordFilterMgr::AddBadWordMail(std::string const& badWord, bool toDB)
@@ -279,6 +295,7 @@ bool WordFilterMgr::AddBadWordMail(std::string const& badWord, bool toDB)
         return false;
 
     m_badWordsMail.insert(_badWord);
+    RebuildMatchers();
 
     if (toDB)
         WorldDatabase.PQuery("REPLACE INTO bad_word_mail VALUES ('%s')", badWord.c_str());
@@ -297,6 +314,7 @@ bool WordFilterMgr::RemoveBadWord(std::string const& badWord, bool fromDB)
         return false;
 
     m_badWords.erase(it);
+    RebuildMatchers();
 
     if (fromDB)
         WorldDatabase.PExecute("DELETE FROM bad_word WHERE `bad_word` = '%s'", badWord.c_str());
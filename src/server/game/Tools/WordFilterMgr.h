@@ -18,6 +18,8 @@
 #ifndef TRINITYCORE_WORDFILTERMGR_H
 #define TRINITYCORE_WORDFILTERMGR_H
 
+#include "WordFilterMatcher.h"
+
 // #include <locale>
 // #include <codecvt>
 
@@ -80,6 +82,7 @@ public:
     void LoadComplaints();
 
     std::string FindBadWord(std::string const& text, bool mail = false);
+    void RebuildMatchers();
 
     // manipulations with container 
     bool AddBadWord(std::string const& badWord, bool toDB = false);
@@ -109,6 +112,11 @@ private:
     BadWordMap m_badWords;
     BadWordMapMail m_badWordsMail;
 
+    // rebuilt from the word sets on every change and swapped atomically, chat checks never wait for GM commands
+    std::shared_ptr<WordFilterMatcher const> m_matcher;
+    std::shared_ptr<WordFilterMatcher const> m_matcherMail;
+    bool m_loadingBadWords;
+
     BadSentences m_badSentences{};
     std::map<uint32, size_t> hashById{};
     uint32 lastIdBadSentences{};
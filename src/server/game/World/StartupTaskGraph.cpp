@@ -0,0 +1,152 @@
+/*
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "StartupTaskGraph.h"
+#include "Errors.h"
+#include "Log.h"
+#include "Timer.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <set>
+#include <thread>
+
+StartupTaskGraph::StartupTaskGraph() : _wallTime(0)
+{
+}
+
+void StartupTaskGraph::Add(std::string const& name, std::initializer_list<char const*> dependencies, TaskFunction task)
+{
+    Node node;
+    node.Name = name;
+    node.Function = std::move(task);
+    node.Pending = 0;
+    node.Start = 0;
+    node.End = 0;
+    node.Thread = 0;
+
+    uint32 index = uint32(_nodes.size());
+    for (char const* dependency : dependencies)
+    {
+        auto itr = std::find_if(_nodes.begin(), _nodes.end(), [dependency](Node const& other) { return other.Name == dependency; });
+        ASSERT(itr != _nodes.end(), "Startup task %s depends on unknown task %s", name.c_str(), dependency);
+
+        uint32 dependencyIndex = uint32(itr - _nodes.begin());
+        node.Dependencies.push_back(dependencyIndex);
+        _nodes[dependencyIndex].Dependents.push_back(index);
+        ++node.Pending;
+    }
+
+    _nodes.push_back(std::move(node));
+}
+
+void StartupTaskGraph::Run(uint32 threadCount)
+{
+    std::mutex lock;
+    std::condition_variable changed;
+    std::set<uint32> ready;                                 // by insertion order
+    uint32 remaining = uint32(_nodes.size());
+
+    for (uint32 i = 0; i < _nodes.size(); ++i)
+        if (!_nodes[i].Pending)
+            ready.insert(i);
+
+    uint32 begin = getMSTime();
+
+    auto worker = [&](uint32 thread)
+    {
+        std::unique_lock<std::mutex> guard(lock);
+        for (;;)
+        {
+            changed.wait(guard, [&]() { return !ready.empty() || !remaining; });
+            if (!remaining)
+                return;
+
+            uint32 index = *ready.begin();
+            ready.erase(ready.begin());
+
+            Node& node = _nodes[index];
+            node.Thread = thread;
+            node.Start = GetMSTimeDiffToNow(begin);
+
+            guard.unlock();
+            node.Function();
+            guard.lock();
+
+            node.End = GetMSTimeDiffToNow(begin);
+            --remaining;
+            for (uint32 dependent : node.Dependents)
+                if (!--_nodes[dependent].Pending)
+                    ready.insert(dependent);
+
+            changed.notify_all();
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (uint32 i = 1; i < std::max<uint32>(threadCount, 1); ++i)
+        threads.emplace_back(worker, i);
+
+    worker(0);
+
+    for (std::thread& thread : threads)
+        thread.join();
+
+    _wallTime = GetMSTimeDiffToNow(begin);
+}
+
+void StartupTaskGraph::LogTimeline() const
+{
+    if (_nodes.empty())
+        return;
+
+    uint32 total = 0;
+    for (Node const& node : _nodes)
+        total += node.End - node.Start;
+
+    TC_LOG_INFO("server.loading", "Startup timeline: %u tasks in %u ms (%u ms sequential)", uint32(_nodes.size()), _wallTime, total);
+
+    std::vector<uint32> order(_nodes.size());
+    for (uint32 i = 0; i < order.size(); ++i)
+        order[i] = i;
+
+    std::stable_sort(order.begin(), order.end(), [this](uint32 left, uint32 right) { return _nodes[left].Start < _nodes[right].Start; });
+    for (uint32 index : order)
+    {
+        Node const& node = _nodes[index];
+        TC_LOG_INFO("server.loading", "  %-28s start %6u ms  duration %6u ms  thread %u", node.Name.c_str(), node.Start, node.End - node.Start, node.Thread);
+    }
+
+    // walk back from the last task to finish through the dependency that finished last
+    uint32 current = uint32(std::max_element(_nodes.begin(), _nodes.end(), [](Node const& left, Node const& right) { return left.End < right.End; }) - _nodes.begin());
+    std::vector<uint32> path(1, current);
+    while (!_nodes[current].Dependencies.empty())
+    {
+        std::vector<uint32> const& dependencies = _nodes[current].Dependencies;
+        current = *std::max_element(dependencies.begin(), dependencies.end(), [this](uint32 left, uint32 right) { return _nodes[left].End < _nodes[right].End; });
+        path.push_back(current);
+    }
+
+    std::string chain;
+    for (auto itr = path.rbegin(); itr != path.rend(); ++itr)
+    {
+        if (!chain.empty())
+            chain += " -> ";
+        chain += _nodes[*itr].Name;
+    }
+
+    TC_LOG_INFO("server.loading", "Startup critical path (%u ms): %s", _nodes[path.front()].End, chain.c_str());
+}
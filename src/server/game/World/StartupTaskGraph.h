@@ -0,0 +1,67 @@
+/*
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_STARTUP_TASK_GRAPH_H
+#define TRINITY_STARTUP_TASK_GRAPH_H
+
+#include "Define.h"
+
+#include <functional>
+#include <initializer_list>
+#include <string>
+#include <vector>
+
+/*
+ * Startup loaders with the loaders they depend on.
+ *
+ * A task starts once all of its dependencies finished, independent tasks run at the same time on
+ * Startup.LoaderThreads threads (the calling thread included). Ready tasks are picked in the order
+ * they were added, so with one thread the graph runs exactly like the plain sequence of calls.
+ * Synchronous queries of concurrent loaders use the SynchThreads connections of their database pool.
+ */
+class StartupTaskGraph
+{
+public:
+    typedef std::function<void()> TaskFunction;
+
+    StartupTaskGraph();
+
+    // dependencies are names of tasks added before this one
+    void Add(std::string const& name, std::initializer_list<char const*> dependencies, TaskFunction task);
+
+    // returns when every task finished
+    void Run(uint32 threadCount);
+
+    // start and duration of every task, then the chain of dependencies that bounded the wall time
+    void LogTimeline() const;
+
+private:
+    struct Node
+    {
+        std::string Name;
+        TaskFunction Function;
+        std::vector<uint32> Dependencies;
+        std::vector<uint32> Dependents;
+        uint32 Pending;                                     // unfinished dependencies
+        uint32 Start;                                       // ms since Run
+        uint32 End;
+        uint32 Thread;
+    };
+
+    std::vector<Node> _nodes;
+    uint32 _wallTime;
+};
+
+#endif
@@ -65,6 +65,7 @@
 #include "GlobalFunctional.h"
 #include "GossipData.h"
 #include "GridNotifiersImpl.h"
+#include "GridPreloader.h"
 #include "GroupMgr.h"
 #include "GuildFinderMgr.h"
 #include "GuildMgr.h"
@@ -76,6 +77,7 @@
 #include "Log.h"
 #include "LootMgr.h"
 #include "MapManager.h"
+#include "MapTickProfiler.h"
 #include "MiscPackets.h"
 #include "MMapFactory.h"
 #include "ObjectMgr.h"
@@ -93,6 +95,7 @@
 #include "SkillExtraItems.h"
 #include "SmartAI.h"
 #include "SpellMgr.h"
+#include "StartupTaskGraph.h"
 #include "TaxiPathGraph.h"
 #include "TicketMgr.h"
 #include "TransportMgr.h"
@@ -678,6 +681,7 @@ void World::LoadConfigSettings(bool reload)
     m_int_configs[CONFIG_PRESERVE_CUSTOM_CHANNEL_DURATION] = sConfigMgr->GetIntDefault("PreserveCustomChannelDuration", 14);
     m_bool_configs[CONFIG_GRID_UNLOAD] = sConfigMgr->GetBoolDefault("GridUnload", true);
     m_int_configs[CONFIG_INTERVAL_SAVE] = sConfigMgr->GetIntDefault("PlayerSaveInterval", 15 * MINUTE * IN_MILLISECONDS);
+    m_int_configs[CONFIG_PLAYER_SAVE_COALESCE_WINDOW] = sConfigMgr->GetIntDefault("PlayerSave.CoalesceWindow", 10 * IN_MILLISECONDS);
     m_int_configs[CONFIG_INTERVAL_DISCONNECT_TOLERANCE] = sConfigMgr->GetIntDefault("DisconnectToleranceInterval", 0);
 
     m_int_configs[CONFIG_INTERVAL_GRIDCLEAN] = sConfigMgr->GetIntDefault("GridCleanUpDelay", 5 * MINUTE * IN_MILLISECONDS);
@@ -1263,6 +1267,8 @@ void World::LoadConfigSettings(bool reload)
 
     // MMap related
     m_bool_configs[CONFIG_ENABLE_MMAPS] = sConfigMgr->GetBoolDefault("mmap.enablePathFinding", true);
+    m_bool_configs[CONFIG_MAP_FILES_MEMORY_MAPPED] = sConfigMgr->GetBoolDefault("MapFiles.MemoryMapped", false);
+    MMAP::MMapFactory::createOrGetMMapManager()->SetMemoryMappedTiles(m_bool_configs[CONFIG_MAP_FILES_MEMORY_MAPPED]);
     TC_LOG_INFO("server.loading", "WORLD: MMap data directory is: %smmaps", m_dataPath.c_str());
 
     m_bool_configs[CONFIG_VMAP_INDOOR_CHECK] = sConfigMgr->GetBoolDefault("vmap.enableIndoorCheck", false);
@@ -1297,8 +1303,21 @@ void World::LoadConfigSettings(bool reload)
     m_bool_configs[CONFIG_SHOW_KICK_IN_WORLD] = sConfigMgr->GetBoolDefault("ShowKickInWorld", false);
     m_int_configs[CONFIG_INTERVAL_LOG_UPDATE] = sConfigMgr->GetIntDefault("RecordUpdateTimeDiffInterval", 60000);
     m_int_configs[CONFIG_MIN_LOG_UPDATE] = sConfigMgr->GetIntDefault("MinRecordUpdateTimeDiff", 100);
-    m_int_configs[CONFIG_NUMTHREADS] = sConfigMgr->GetIntDefault("MapUpdate.Threads", 1);
+    if (reload)
+    {
+        bool val = sConfigMgr->GetBoolDefault("MapUpdate.Scheduler", false);
+        if (val != m_bool_configs[CONFIG_MAP_UPDATE_SCHEDULER])
+            TC_LOG_ERROR("server.loading", "MapUpdate.Scheduler option can't be changed at worldserver.conf reload, using current value (%u).", m_bool_configs[CONFIG_MAP_UPDATE_SCHEDULER]);
+    }
+    else
+        m_bool_configs[CONFIG_MAP_UPDATE_SCHEDULER] = sConfigMgr->GetBoolDefault("MapUpdate.Scheduler", false);
+    m_int_configs[CONFIG_NUMTHREADS] = sConfigMgr->GetIntDefault("MapUpdate.Threads", 0);
+    sMapTickProfiler->LoadConfig();
+    sGridPreloader->LoadConfig();
     m_int_configs[CONFIG_MAP_NUMTHREADS] = sConfigMgr->GetIntDefault("MapUpdate.Map.Threads", 1);
+    m_int_configs[CONFIG_STARTUP_LOADER_THREADS] = sConfigMgr->GetIntDefault("Startup.LoaderThreads", 4);
+    m_int_configs[CONFIG_MAP_QUERY_CACHE_SIZE] = sConfigMgr->GetIntDefault("MapQueryCache.Size", 2048);
+    m_float_configs[CONFIG_MAP_QUERY_CACHE_QUANTUM] = sConfigMgr->GetFloatDefault("MapQueryCache.Quantum", 0.25f);
     m_int_configs[CONFIG_MAX_RESULTS_LOOKUP_COMMANDS] = sConfigMgr->GetIntDefault("Command.LookupMaxResults", 0);
 
     // chat logging
@@ -1975,159 +1994,265 @@ void World::SetInitialWorldSettings()
     TC_LOG_INFO("server.loading", "Loading Player level dependent mail rewards...");
     sObjectMgr->LoadMailLevelRewards();
 
-    // Loot tables
-    LoadLootTables();
+    ///- Loaders below only depend on the static data loaded above and on the ones they name,
+    ///- independent ones run at the same time on Startup.LoaderThreads threads
+    StartupTaskGraph loaders;
+
+    loaders.Add("LootTables", {}, []()
+    {
+        LoadLootTables();
+    });
 
-    TC_LOG_INFO("server.loading", "Loading Skill Discovery Table...");
-    LoadSkillDiscoveryTable();
+    loaders.Add("SkillDiscovery", {}, []()
+    {
+        TC_LOG_INFO("server.loading", "Loading Skill Discovery Table...");
+        LoadSkillDiscoveryTable();
 
-    TC_LOG_INFO("server.loading", "Loading Skill Extra Item Table...");
-    LoadSkillExtraItemTable();
+        TC_LOG_INFO("server.loading", "Loading Skill Extra Item Table...");
+        LoadSkillExtraItemTable();
+    });
 
-    TC_LOG_INFO("server.loading", "Loading Skill Fishing base level requirements...");
-    sObjectMgr->LoadFishingBaseSkillLevel();
+    loaders.Add("SkillTiers", { "LootTables" }, []()
+    {
+        TC_LOG_INFO("server.loading", "Loading Skill Fishing base level requirements...");
+        sObjectMgr->LoadFishingBaseSkillLevel();
 
-    TC_LOG_INFO("server.loading", "Loading skill tier info...");
-    sObjectMgr->LoadSkillTiers();
+        TC_LOG_INFO("server.loading", "Loading skill tier info...");
+        sObjectMgr->LoadSkillTiers();
+    });
 
-    TC_LOG_INFO("server.loading", "Loading Achievements...");
-    sAchievementMgr->LoadAchievementReferenceList();
-    TC_LOG_INFO("server.loading", "Loading Criteria Lists...");
-    sAchievementMgr->LoadCriteriaList();
-    TC_LOG_INFO("server.loading", "Loading Achievement Criteria Data...");
-    sAchievementMgr->LoadAchievementCriteriaData();
-    TC_LOG_INFO("server.loading", "Loading Achievement Rewards...");
-    sAchievementMgr->LoadRewards();
-    TC_LOG_INFO("server.loading", "Loading Achievement Reward Locales...");
-    sAchievementMgr->LoadRewardLocales();
-    TC_LOG_INFO("server.loading", "Loading Completed Achievements...");
-    sAchievementMgr->LoadCompletedAchievements();
+    loaders.Add("Achievements", {}, []()
+    {
+        TC_LOG_INFO("server.loading", "Loading Achievements...");
+        sAchievementMgr->LoadAchievementReferenceList();
+        TC_LOG_INFO("server.loading", "Loading Criteria Lists...");
+        sAchievementMgr->LoadCriteriaList();
+        TC_LOG_INFO("server.loading", "Loading Achievement Criteria Data...");
+        sAchievementMgr->LoadAchievementCriteriaData();
+        TC_LOG_INFO("server.loading", "Loading Achievement Rewards...");
+        sAchievementMgr->LoadRewards();
+        TC_LOG_INFO("server.loading", "Loading Achievement Reward Locales...");
+        sAchievementMgr->LoadRewardLocales();
+        TC_LOG_INFO("server.loading", "Loading Completed Achievements...");
+        sAchievementMgr->LoadCompletedAchievements();
+    });
 
     ///- Load dynamic data tables from the database
-    TC_LOG_INFO("server.loading", "Loading Item Auctions...");
-    sAuctionMgr->LoadAuctionItems();
-    TC_LOG_INFO("server.loading", "Loading Auctions...");
-    sAuctionMgr->LoadAuctions();
+    loaders.Add("Auctions", {}, []()
+    {
+        TC_LOG_INFO("server.loading", "Loading Item Auctions...");
+        sAuctionMgr->LoadAuctionItems();
+        TC_LOG_INFO("server.loading", "Loading Auctions...");
+        sAuctionMgr->LoadAuctions();
+    });
 
     if (m_bool_configs[CONFIG_BLACKMARKET_ENABLED])
     {
-        TC_LOG_INFO("server.loading", "Loading Black Market Templates...");
-        sBlackMarketMgr->LoadTemplates();
+        loaders.Add("BlackMarket", { "Auctions" }, []()
+        {
+            TC_LOG_INFO("server.loading", "Loading Black Market Templates...");
+            sBlackMarketMgr->LoadTemplates();
 
-        TC_LOG_INFO("server.loading", "Loading Black Market Auctions...");
-        sBlackMarketMgr->LoadAuctions();
+            TC_LOG_INFO("server.loading", "Loading Black Market Auctions...");
+            sBlackMarketMgr->LoadAuctions();
+        });
     }
 
-    TC_LOG_INFO("server.loading", "Loading Currencys Loot...");
-    sObjectMgr->LoadCurrencysLoot();
+    loaders.Add("CurrencysLoot", { "SkillTiers" }, []()
+    {
+        TC_LOG_INFO("server.loading", "Loading Currencys Loot...");
+        sObjectMgr->LoadCurrencysLoot();
+    });
 
-    TC_LOG_INFO("server.loading", "Loading Guild XP for level...");
-    sGuildMgr->LoadGuildXpForLevel();
+    loaders.Add("Guilds", { "Achievements" }, []()
+    {
+        TC_LOG_INFO("server.loading", "Loading Guild XP for level...");
+        sGuildMgr->LoadGuildXpForLevel();
 
-    TC_LOG_INFO("server.loading", "Loading Guild rewards...");
-    sGuildMgr->LoadGuildRewards();
-    sGuildMgr->LoadGuildChallengeRewardInfo();
+        TC_LOG_INFO("server.loading", "Loading Guild rewards...");
+        sGuildMgr->LoadGuildRewards();
+        sGuildMgr->LoadGuildChallengeRewardInfo();
 
-    sGuildMgr->LoadGuilds();
+        sGuildMgr->LoadGuilds();
+    });
 
-    sGuildFinderMgr->LoadFromDB();
+    loaders.Add("GuildFinder", { "Guilds" }, []()
+    {
+        sGuildFinderMgr->LoadFromDB();
+    });
 
-    sBracketMgr->LoadCharacterBrackets();
+    loaders.Add("Brackets", {}, []()
+    {
+        sBracketMgr->LoadCharacterBrackets();
+    });
 
-    TC_LOG_INFO("server.loading", "Loading Groups...");
-    sGroupMgr->LoadGroups();
+    loaders.Add("Groups", {}, []()
+    {
+        TC_LOG_INFO("server.loading", "Loading Groups...");
+        sGroupMgr->LoadGroups();
+    });
 
-    sCharacterDataStore->LoadReservedPlayersNames();
+    loaders.Add("ReservedNames", { "CurrencysLoot" }, []()
+    {
+        sCharacterDataStore->LoadReservedPlayersNames();
+    });
 
-    sQuestDataStore->LoadGameObjectForQuests();
+    loaders.Add("GameObjectForQuests", { "ReservedNames" }, []()
+    {
+        sQuestDataStore->LoadGameObjectForQuests();
+    });
 
-    TC_LOG_INFO("server.loading", "Loading BattleMasters...");
-    sBattlegroundMgr->LoadBattleMastersEntry();
-    sBattlegroundMgr->LoadPvpRewards();
+    loaders.Add("BattleMasters", {}, []()
+    {
+        TC_LOG_INFO("server.loading", "Loading BattleMasters...");
+        sBattlegroundMgr->LoadBattleMastersEntry();
+        sBattlegroundMgr->LoadPvpRewards();
+    });
 
-    TC_LOG_INFO("server.loading", "Loading GameTeleports...");
-    sObjectMgr->LoadGameTele();
+    loaders.Add("GameTele", { "GameObjectForQuests" }, []()
+    {
+        TC_LOG_INFO("server.loading", "Loading GameTeleports...");
+        sObjectMgr->LoadGameTele();
+    });
 
-    TC_LOG_INFO("server.loading", "Loading Gossip menu...");
-    sGossipDataStore->LoadGossipMenu();
+    loaders.Add("Gossip", { "GameTele" }, []()
+    {
+        TC_LOG_INFO("server.loading", "Loading Gossip menu...");
+        sGossipDataStore->LoadGossipMenu();
 
-    TC_LOG_INFO("server.loading", "Loading Gossip menu options...");
-    sGossipDataStore->LoadGossipMenuItems();
+        TC_LOG_INFO("server.loading", "Loading Gossip menu options...");
+        sGossipDataStore->LoadGossipMenuItems();
+    });
+
+    loaders.Add("Vendors", { "Gossip" }, []()
+    {
+        TC_LOG_INFO("server.loading", "Loading Vendors...");
+        sObjectMgr->LoadVendors();                                   // must be after load CreatureTemplate and ItemTemplate
+
+        TC_LOG_INFO("server.loading", "Loading Donate Vendors...");
+        sObjectMgr->LoadDonateVendors();
+    });
 
-    TC_LOG_INFO("server.loading", "Loading Vendors...");
-    sObjectMgr->LoadVendors();                                   // must be after load CreatureTemplate and ItemTemplate
-    
-    TC_LOG_INFO("server.loading", "Loading Donate Vendors...");
-    sObjectMgr->LoadDonateVendors(); 
-    
     m_timers[WUPDATE_DONATE_AND_SERVICES].SetInterval( 3 * HOUR * IN_MILLISECONDS);
 
-    TC_LOG_INFO("server.loading", "Loading Trainers...");
-    sObjectMgr->LoadTrainerSpell();                              // must be after load CreatureTemplate
+    loaders.Add("Trainers", { "Vendors" }, []()
+    {
+        TC_LOG_INFO("server.loading", "Loading Trainers...");
+        sObjectMgr->LoadTrainerSpell();                              // must be after load CreatureTemplate
+    });
 
-    TC_LOG_INFO("server.loading", "Loading Waypoints...");
-    sWaypointMgr->Load();
+    loaders.Add("Waypoints", {}, []()
+    {
+        TC_LOG_INFO("server.loading", "Loading Waypoints...");
+        sWaypointMgr->Load();
+    });
 
-    TC_LOG_INFO("server.loading", "Loading SmartAI Waypoints...");
-    sSmartWaypointMgr->LoadFromDB();
+    loaders.Add("SmartWaypoints", {}, []()
+    {
+        TC_LOG_INFO("server.loading", "Loading SmartAI Waypoints...");
+        sSmartWaypointMgr->LoadFromDB();
+    });
 
-    TC_LOG_INFO("server.loading", "Loading Creature Formations...");
-    sFormationMgr->LoadCreatureFormations();
+    loaders.Add("Formations", {}, []()
+    {
+        TC_LOG_INFO("server.loading", "Loading Creature Formations...");
+        sFormationMgr->LoadCreatureFormations();
+    });
 
-    TC_LOG_INFO("server.loading", "Loading World States...");              // must be loaded before battleground, outdoor PvP and conditions
-    LoadWorldStates();
+    loaders.Add("WorldStates", { "Trainers" }, [this]()
+    {
+        TC_LOG_INFO("server.loading", "Loading World States...");              // must be loaded before battleground, outdoor PvP and conditions
+        LoadWorldStates();
+    });
 
-    TC_LOG_INFO("server.loading", "Loading Phase definitions...");
-    sObjectMgr->LoadPhaseDefinitions();
+    loaders.Add("PhaseAndScenario", { "WorldStates" }, []()
+    {
+        TC_LOG_INFO("server.loading", "Loading Phase definitions...");
+        sObjectMgr->LoadPhaseDefinitions();
 
-    TC_LOG_INFO("server.loading", "Loading Scenario data...");
-    sObjectMgr->LoadScenarioData();
-    
-    TC_LOG_INFO("server.loading", "Loading Scenario Step Spell data...");
-    sObjectMgr->LoadScenarioSpellData();
+        TC_LOG_INFO("server.loading", "Loading Scenario data...");
+        sObjectMgr->LoadScenarioData();
 
-    TC_LOG_INFO("server.loading", "Loading Conditions...");
-    sConditionMgr->LoadConditions();
+        TC_LOG_INFO("server.loading", "Loading Scenario Step Spell data...");
+        sObjectMgr->LoadScenarioSpellData();
+    });
 
-    sCharacterDataStore->LoadFactionChangeAchievements();
-    sCharacterDataStore->LoadFactionChangeSpells();
-    sCharacterDataStore->LoadFactionChangeItems();
-    sCharacterDataStore->LoadFactionChangeReputations();
-    sCharacterDataStore->LoadFactionChangeTitles();
+    // conditions are attached to loot, gossip and vendor entries
+    loaders.Add("Conditions", { "PhaseAndScenario", "LootTables", "Gossip", "Vendors" }, []()
+    {
+        TC_LOG_INFO("server.loading", "Loading Conditions...");
+        sConditionMgr->LoadConditions();
+    });
 
-    CollectionMgr::LoadMountDefinitions();
+    loaders.Add("FactionChange", {}, []()
+    {
+        sCharacterDataStore->LoadFactionChangeAchievements();
+        sCharacterDataStore->LoadFactionChangeSpells();
+        sCharacterDataStore->LoadFactionChangeItems();
+        sCharacterDataStore->LoadFactionChangeReputations();
+        sCharacterDataStore->LoadFactionChangeTitles();
+    });
 
-    TC_LOG_INFO("server.loading", "Loading GM tickets...");
-    sTicketMgr->LoadTickets();
+    loaders.Add("MountDefinitions", {}, []()
+    {
+        CollectionMgr::LoadMountDefinitions();
+    });
 
-    TC_LOG_INFO("server.loading", "Loading GM surveys...");
-    sTicketMgr->LoadSurveys();
+    loaders.Add("Tickets", {}, []()
+    {
+        TC_LOG_INFO("server.loading", "Loading GM tickets...");
+        sTicketMgr->LoadTickets();
+
+        TC_LOG_INFO("server.loading", "Loading GM surveys...");
+        sTicketMgr->LoadSurveys();
+    });
 
-    TC_LOG_INFO("server.loading", "Loading client addons...");
-    AddonMgr::LoadFromDB();
+    loaders.Add("Addons", {}, []()
+    {
+        TC_LOG_INFO("server.loading", "Loading client addons...");
+        AddonMgr::LoadFromDB();
+    });
 
     ///- Handle outdated emails (delete/return)
-    TC_LOG_INFO("server.loading", "Returning old mails...");
-    sObjectMgr->ReturnOrDeleteOldMails(false);
+    loaders.Add("OldMails", { "Conditions" }, []()
+    {
+        TC_LOG_INFO("server.loading", "Returning old mails...");
+        sObjectMgr->ReturnOrDeleteOldMails(false);
+    });
 
-    TC_LOG_INFO("server.loading", "Loading Autobroadcasts...");
-    LoadAutobroadcasts();
+    loaders.Add("Autobroadcasts", {}, [this]()
+    {
+        TC_LOG_INFO("server.loading", "Loading Autobroadcasts...");
+        LoadAutobroadcasts();
+    });
 
-    TC_LOG_INFO("server.loading", "Loading challenge save...");
-    sChallengeMgr->LoadFromDB();
+    loaders.Add("Challenges", { "Guilds" }, []()
+    {
+        TC_LOG_INFO("server.loading", "Loading challenge save...");
+        sChallengeMgr->LoadFromDB();
+    });
 
     ///- Load and initialize scripts
-    sScriptDataStore->LoadQuestStartScripts();                         // must be after load Creature/Gameobject(Template/Data) and QuestTemplate
-    sScriptDataStore->LoadQuestEndScripts();                           // must be after load Creature/Gameobject(Template/Data) and QuestTemplate
-    sScriptDataStore->LoadSpellScripts();                              // must be after load Creature/Gameobject(Template/Data)
-    sScriptDataStore->LoadGameObjectScripts();                         // must be after load Creature/Gameobject(Template/Data)
-    sScriptDataStore->LoadEventScripts();                              // must be after load Creature/Gameobject(Template/Data)
-    sScriptDataStore->LoadWaypointScripts();
-    sScriptDataStore->LoadDbScriptStrings();                            // must be after Load*Scripts calls
-    sScriptDataStore->LoadSpellScriptNames();
-
-    TC_LOG_INFO("server.loading", "Loading DeathMatch Store Products...");
-    sObjectMgr->LoadDeathMatchStore();
+    loaders.Add("ScriptData", { "OldMails" }, []()
+    {
+        sScriptDataStore->LoadQuestStartScripts();                         // must be after load Creature/Gameobject(Template/Data) and QuestTemplate
+        sScriptDataStore->LoadQuestEndScripts();                           // must be after load Creature/Gameobject(Template/Data) and QuestTemplate
+        sScriptDataStore->LoadSpellScripts();                              // must be after load Creature/Gameobject(Template/Data)
+        sScriptDataStore->LoadGameObjectScripts();                         // must be after load Creature/Gameobject(Template/Data)
+        sScriptDataStore->LoadEventScripts();                              // must be after load Creature/Gameobject(Template/Data)
+        sScriptDataStore->LoadWaypointScripts();
+        sScriptDataStore->LoadDbScriptStrings();                            // must be after Load*Scripts calls
+        sScriptDataStore->LoadSpellScriptNames();
+    });
+
+    loaders.Add("DeathMatchStore", { "ScriptData" }, []()
+    {
+        TC_LOG_INFO("server.loading", "Loading DeathMatch Store Products...");
+        sObjectMgr->LoadDeathMatchStore();
+    });
+
+    loaders.Run(m_int_configs[CONFIG_STARTUP_LOADER_THREADS]);
+    loaders.LogTimeline();
 
     TC_LOG_INFO("server.loading", "Initializing Scripts...");
     sScriptMgr->Initialize();
@@ -2514,6 +2639,7 @@ void World::Update(uint32 diff)
     /// <li> Handle all other objects
     ///- Update objects when the timer has passed (maps, transport, creatures, ...)
     sMapMgr->Update(diff);
+    sMapTickProfiler->Update(diff);
 
     if (sWorld->getBoolConfig(CONFIG_AUTOBROADCAST))
     {
@@ -2642,7 +2768,7 @@ void World::UpdateGlobalMessage()
                 itr->second.get() != message->self &&
                 (message->team == 0 || itr->second->GetPlayer()->GetTeam() == message->team))
             {
-                itr->second->SendPacket(&message->packet);
+                itr->second->SendPacket(message->packet);
             }
         }
         aMessageQueue.pop();
@@ -2780,7 +2906,7 @@ void World::SendGlobalText(const char* text, WorldSession* self)
 /// Send a packet to all players (or players selected team) in the zone (except self if mentioned)
 bool World::SendZoneMessage(uint32 zone, WorldPacket const* packet, WorldSession* self, uint32 team)
 {
-    bool foundPlayerToSend = false;
+    SharedWorldPacket shared;
 
     for (auto itr = m_sessions.cbegin(); itr != m_sessions.cend(); ++itr)
     {
@@ -2791,12 +2917,14 @@ bool World::SendZoneMessage(uint32 zone, WorldPacket const* packet, WorldSession
             itr->second.get() != self &&
             (team == 0 || itr->second->GetPlayer()->GetTeam() == team))
         {
-            itr->second->SendPacket(packet);
-            foundPlayerToSend = true;
+            if (!shared)
+                shared = MakeSharedWorldPacket(packet);
+
+            itr->second->SendPacket(shared);
         }
     }
 
-    return foundPlayerToSend;
+    return shared != nullptr;
 }
 
 /// Send a System Message to all players in the zone (except self if mentioned)
@@ -4682,5 +4810,5 @@ CliCommandHolder::~CliCommandHolder()
     delete[] m_command;
 }
 
-GlobalMessageData::GlobalMessageData(WorldPacket const* _packet, WorldSession* _self, uint32 _team) : packet(*_packet), self(_self), team(_team)
+GlobalMessageData::GlobalMessageData(WorldPacket const* _packet, WorldSession* _self, uint32 _team) : packet(MakeSharedWorldPacket(_packet)), self(_self), team(_team)
 {}
@@ -104,6 +104,8 @@ enum WorldBoolConfigs
     CONFIG_ALLOW_PLAYER_COMMANDS,
     CONFIG_CLEAN_CHARACTER_DB,
     CONFIG_GRID_UNLOAD,
+    CONFIG_MAP_UPDATE_SCHEDULER,
+    CONFIG_MAP_FILES_MEMORY_MAPPED,
     CONFIG_ALLOW_TWO_SIDE_ACCOUNTS,
     CONFIG_ALLOW_TWO_SIDE_INTERACTION_CALENDAR,
     CONFIG_ALLOW_TWO_SIDE_INTERACTION_CHAT,
@@ -252,6 +254,7 @@ enum WorldFloatConfigs
     CONFIG_ARCHAEOLOGY_RARE_MAXLEVEL_CHANCE,
     CONFIG_CAP_KILLPOINTS,
     CONFIG_CAP_KILL_CREATURE_POINTS,
+    CONFIG_MAP_QUERY_CACHE_QUANTUM,
     FLOAT_CONFIG_VALUE_COUNT
 };
 
@@ -259,6 +262,7 @@ enum WorldIntConfigs
 {
     CONFIG_COMPRESSION = 0,
     CONFIG_INTERVAL_SAVE,
+    CONFIG_PLAYER_SAVE_COALESCE_WINDOW,
     CONFIG_INTERVAL_GRIDCLEAN,
     CONFIG_INTERVAL_MAPUPDATE,
     CONFIG_INTERVAL_INSTANCE_UPDATE,
@@ -380,6 +384,8 @@ enum WorldIntConfigs
     CONFIG_PLAYER_ALLOW_COMMANDS,
     CONFIG_NUMTHREADS,
     CONFIG_MAP_NUMTHREADS,
+    CONFIG_STARTUP_LOADER_THREADS,
+    CONFIG_MAP_QUERY_CACHE_SIZE,
     CONFIG_LOGDB_CLEARINTERVAL,
     CONFIG_LOGDB_CLEARTIME,
     CONFIG_CLIENTCACHE_VERSION,
@@ -662,7 +668,7 @@ struct CharacterInfo
 struct GlobalMessageData
 {
     GlobalMessageData(WorldPacket const* _packet, WorldSession* _self, uint32 _team);
-    WorldPacket packet;
+    SharedWorldPacket packet;
     WorldSession* self;
     uint32 team;
 };
@@ -25,11 +25,18 @@ EndScriptData */
 #include "ScriptMgr.h"
 #include "Chat.h"
 #include "Config.h"
+#include "DatabaseEnv.h"
 #include "ObjectAccessor.h"
+#include "GridPreloader.h"
 #include "MapManager.h"
+#include "MapTickProfiler.h"
+#include "WorldSocket.h"
 #include "GitRevision.h"
 #include "Anticheat.h"
 
+#include <iomanip>
+#include <sstream>
+
 class server_commandscript : public CommandScript
 {
 public:
@@ -77,8 +84,14 @@ public:
             { "idlerestart",    SEC_ADMINISTRATOR,  true,  NULL,                                    "", serverIdleRestartCommandTable },
             { "idleshutdown",   SEC_ADMINISTRATOR,  true,  NULL,                                    "", serverIdleShutdownCommandTable },
             { "info",           SEC_PLAYER,         true,  &HandleServerInfoCommand,                ""},
+            { "mapprofile",     SEC_ADMINISTRATOR,  true,  &HandleServerMapProfileCommand,          ""},
             { "motd",           SEC_PLAYER,         true,  &HandleServerMotdCommand,                ""},
+            { "netstats",       SEC_ADMINISTRATOR,  true,  &HandleServerNetStatsCommand,            ""},
             { "plimit",         SEC_ADMINISTRATOR,  true,  &HandleServerPLimitCommand,              ""},
+            { "querycache",     SEC_ADMINISTRATOR,  true,  &HandleServerQueryCacheCommand,          ""},
+            { "recvstats",      SEC_ADMINISTRATOR,  true,  &HandleServerRecvStatsCommand,           ""},
+            { "savestats",      SEC_ADMINISTRATOR,  true,  &HandleServerSaveStatsCommand,           ""},
+            { "dbstats",        SEC_ADMINISTRATOR,  true,  &HandleServerDbStatsCommand,             ""},
             { "restart",        SEC_ADMINISTRATOR,  true,  NULL,                                    "", serverRestartCommandTable },
             { "shutdown",       SEC_ADMINISTRATOR,  true,  NULL,                                    "", serverShutdownCommandTable },
             { "set",            SEC_ADMINISTRATOR,  true,  NULL,                                    "", serverSetCommandTable }
@@ -104,6 +117,182 @@ public:
         return true;
     }
 
+    // Shows p50/p99/max of the map tick phases of the slowest maps: .server mapprofile [count|reset]
+    static bool HandleServerMapProfileCommand(ChatHandler* handler, char const* args)
+    {
+        if (!sMapTickProfiler->IsEnabled())
+        {
+            handler->PSendSysMessage("Map profiler is disabled (MapProfiler.Enable).");
+            return true;
+        }
+
+        if (args && strcmp(args, "reset") == 0)
+        {
+            sMapTickProfiler->Reset();
+            handler->PSendSysMessage("Map profiler statistics cleared.");
+            return true;
+        }
+
+        uint32 count = 10;
+        if (args && *args)
+            count = std::max(atoi(args), 1);
+
+        std::vector<MapTickProfiler::MapStats> stats = sMapTickProfiler->GetStats();
+        handler->PSendSysMessage("Map tick profile, %u maps, %u dropped samples (p50/p99/max ms):", uint32(stats.size()), sMapTickProfiler->GetDroppedSamples());
+
+        if (sGridPreloader->IsEnabled())
+        {
+            GridPreloader::Counters const& preload = sGridPreloader->GetCounters();
+            handler->PSendSysMessage("Grid preload: " UI64FMTD " requested, " UI64FMTD " dropped, " UI64FMTD " used, " UI64FMTD " late, " UI64FMTD " discarded",
+                uint64(preload.Requested.load(std::memory_order_relaxed)), uint64(preload.Dropped.load(std::memory_order_relaxed)), uint64(preload.Used.load(std::memory_order_relaxed)),
+                uint64(preload.Late.load(std::memory_order_relaxed)), uint64(preload.Discarded.load(std::memory_order_relaxed)));
+        }
+
+        for (MapTickProfiler::MapStats const& map : stats)
+        {
+            if (!count--)
+                break;
+
+            std::ostringstream ss;
+            ss << "Map " << map.MapId << " instance " << map.InstanceId << " ticks " << map.Phases[MAP_TICK_PHASE_TOTAL].Count << ":";
+            ss << std::fixed << std::setprecision(1);
+            for (uint8 phase = 0; phase < MAX_MAP_TICK_PHASE; ++phase)
+            {
+                MapTickProfiler::PhaseStats const& phaseStats = map.Phases[phase];
+                ss << " " << MapTickProfiler::GetPhaseName(MapTickPhase(phase)) << " " << phaseStats.P50 / 1000.0f << "/" << phaseStats.P99 / 1000.0f << "/" << phaseStats.Max / 1000.0f;
+            }
+            handler->SendSysMessage(ss.str().c_str());
+        }
+
+        return true;
+    }
+
+    static void SendQueryCacheStats(ChatHandler* handler, char const* scope, MapQueryCounters const& stats)
+    {
+        char const* names[MAX_MAP_QUERY_TYPE] = { "line of sight", "height" };
+        handler->PSendSysMessage("%s: " UI64FMTD " invalidations, " UI64FMTD " area invalidations", scope, uint64(stats.Invalidations.load(std::memory_order_relaxed)),
+            uint64(stats.AreaInvalidations.load(std::memory_order_relaxed)));
+        for (uint8 i = 0; i < MAX_MAP_QUERY_TYPE; ++i)
+        {
+            uint64 hits = stats.Hits[i].load(std::memory_order_relaxed);
+            uint64 misses = stats.Misses[i].load(std::memory_order_relaxed);
+            handler->PSendSysMessage("  %s: " UI64FMTD " hits, " UI64FMTD " misses, %.1f%% hit rate", names[i], hits, misses, hits + misses ? hits * 100.0 / (hits + misses) : 0.0);
+        }
+    }
+
+    // Line of sight and height cache hit rates of all maps and of the current map
+    static bool HandleServerQueryCacheCommand(ChatHandler* handler, char const* /*args*/)
+    {
+        if (!sWorld->getIntConfig(CONFIG_MAP_QUERY_CACHE_SIZE))
+        {
+            handler->PSendSysMessage("Map query cache is disabled (MapQueryCache.Size).");
+            return true;
+        }
+
+        SendQueryCacheStats(handler, "All maps", MapQueryCache::WorldStats);
+
+        if (WorldSession* session = handler->GetSession())
+            if (Player* player = session->GetPlayer())
+                if (player->IsInWorld())
+                {
+                    Map* map = player->GetMap();
+                    std::ostringstream scope;
+                    scope << "Map " << map->GetId() << " instance " << map->GetInstanceId();
+                    SendQueryCacheStats(handler, scope.str().c_str(), map->GetQueryCache().GetStats());
+                }
+
+        return true;
+    }
+
+    // Shows world socket write totals and bytes/syscalls per flush
+    static bool HandleServerNetStatsCommand(ChatHandler* handler, char const* /*args*/)
+    {
+        SocketWriteStats const& stats = Socket<WorldSocket>::WriteStats;
+        uint64 flushes = stats.Flushes.load(std::memory_order_relaxed);
+        uint64 syscalls = stats.Syscalls.load(std::memory_order_relaxed);
+        uint64 bytes = stats.Bytes.load(std::memory_order_relaxed);
+
+        handler->PSendSysMessage("World socket writes: " UI64FMTD " flushes, " UI64FMTD " syscalls, " UI64FMTD " bytes", flushes, syscalls, bytes);
+        if (flushes)
+            handler->PSendSysMessage("Per flush: %.2f syscalls, %.1f bytes", double(syscalls) / flushes, double(bytes) / flushes);
+
+        return true;
+    }
+
+    // Client opcodes causing the most receive path allocations: .server recvstats [count]
+    static bool HandleServerRecvStatsCommand(ChatHandler* handler, char const* args)
+    {
+        uint32 count = 10;
+        if (*args)
+            count = std::max<uint32>(atoi(args), 1);
+
+        std::vector<std::pair<uint32, uint16>> opcodes;
+        uint64 received = 0;
+        uint64 allocations = 0;
+        for (uint32 opcode = 0; opcode < OPCODE_COUNT; ++opcode)
+        {
+            received += WorldSession::RecvPacketCount[opcode].load(std::memory_order_relaxed);
+            if (uint32 allocs = WorldSession::RecvPacketAllocations[opcode].load(std::memory_order_relaxed))
+            {
+                allocations += allocs;
+                opcodes.emplace_back(allocs, uint16(opcode));
+            }
+        }
+
+        std::sort(opcodes.begin(), opcodes.end(), std::greater<std::pair<uint32, uint16>>());
+        if (opcodes.size() > count)
+            opcodes.resize(count);
+
+        handler->PSendSysMessage("Received packets: " UI64FMTD ", allocations: " UI64FMTD, received, allocations);
+        for (auto const& itr : opcodes)
+            handler->PSendSysMessage("%s: %u allocations, %u packets", GetOpcodeNameForLogging(static_cast<OpcodeClient>(itr.second)).c_str(),
+                itr.first, WorldSession::RecvPacketCount[itr.second].load(std::memory_order_relaxed));
+
+        return true;
+    }
+
+    // Rows written by player saves and the sections skipped as unchanged: .server savestats
+    static bool HandleServerSaveStatsCommand(ChatHandler* handler, char const* /*args*/)
+    {
+        static char const* const sectionNames[MAX_PLAYER_SAVE_SECTIONS] = { "visuals", "bg data", "auras", "spell cooldowns", "talents", "glyphs", "chat logos" };
+
+        PlayerSaveStatistics const& stats = Player::SaveStatistics;
+        uint64 saves = stats.Saves.load(std::memory_order_relaxed);
+        uint64 rows = stats.Rows.load(std::memory_order_relaxed);
+
+        handler->PSendSysMessage("Player saves: " UI64FMTD ", coalesced requests: " UI64FMTD, saves, stats.CoalescedSaves.load(std::memory_order_relaxed));
+        handler->PSendSysMessage("Rows written: " UI64FMTD " in " UI64FMTD " statements, " UI64FMTD " per save, %u max", rows,
+            stats.Statements.load(std::memory_order_relaxed), saves ? rows / saves : 0, stats.MaxRows.load(std::memory_order_relaxed));
+
+        for (uint32 i = 0; i < MAX_PLAYER_SAVE_SECTIONS; ++i)
+            handler->PSendSysMessage("%s: " UI64FMTD " rows, " UI64FMTD " saves skipped unchanged", sectionNames[i],
+                stats.SectionRows[i].load(std::memory_order_relaxed), stats.SkippedSections[i].load(std::memory_order_relaxed));
+
+        return true;
+    }
+
+    template<class T>
+    static void SendDatabaseLaneStatistics(ChatHandler* handler, char const* name, DatabaseWorkerPool<T>& database)
+    {
+        static char const* const laneNames[MAX_SQL_LANES] = { "interactive", "write", "bulk" };
+
+        for (uint8 lane = 0; lane < MAX_SQL_LANES; ++lane)
+        {
+            SQLLaneStatistics stats = database.GetLaneStatistics(SQLOperationLane(lane));
+            handler->PSendSysMessage("%s %s: " UI64FMTD " queued, " UI64FMTD " executed, wait " UI64FMTD " us avg " UI64FMTD " us max", name, laneNames[lane],
+                stats.Depth, stats.Executed, stats.Executed ? stats.TotalWaitUs / stats.Executed : 0, stats.MaxWaitUs);
+        }
+    }
+
+    // Async queue depth and wait per lane: .server dbstats
+    static bool HandleServerDbStatsCommand(ChatHandler* handler, char const* /*args*/)
+    {
+        SendDatabaseLaneStatistics(handler, "Characters", CharacterDatabase);
+        SendDatabaseLaneStatistics(handler, "Login", LoginDatabase);
+        SendDatabaseLaneStatistics(handler, "World", WorldDatabase);
+        return true;
+    }
+
     static bool HandleServerInfoCommand(ChatHandler* handler, char const* /*args*/)
     {
         uint32 playersNum           = sWorld->GetPlayerCount();
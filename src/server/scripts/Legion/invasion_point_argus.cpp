@@ -4222,7 +4222,7 @@ public:
         {
             player->ResurrectPlayer(!AccountMgr::IsPlayerAccount(player->GetSession()->GetSecurity()) ? 1.0f : 0.5f);
             player->SpawnCorpseBones();
-            player->SaveToDB();
+            player->RequestSave();
         }
 
         if (questId && player->WorldQuestCompleted(questId) && !player->isGameMaster())
@@ -4792,7 +4792,7 @@ public:
                             {
                                 player->ResurrectPlayer(!AccountMgr::IsPlayerAccount(player->GetSession()->GetSecurity()) ? 1.0f : 0.5f);
                                 player->SpawnCorpseBones();
-                                player->SaveToDB();
+                                player->RequestSave();
                             }
 
                             if (player->IsMounted())
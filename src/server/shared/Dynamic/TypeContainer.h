@@ -27,6 +27,7 @@
 #include "Define.h"
 #include "Dynamic/TypeList.h"
 
+#include <atomic>
 #include <type_traits>
 #include <vector>
 
@@ -95,6 +96,14 @@ mapForType(ContainerMapList<TypeList<Head, Tail>> &m)
     return Trinity::Detail::mapForType<SpecificType>(m.tail);
 }
 
+// Each container starts its membership version in its own 2^32 range, so versions of a
+// destroyed container can't be mistaken for the ones of a container reusing its address
+inline uint64 NextContainerGeneration()
+{
+    static std::atomic<uint64> generation(0);
+    return ++generation << 32;
+}
+
 } // namespace Detail
 
 /*
@@ -111,6 +120,11 @@ public:
     typedef Detail::ContainerMapList<ObjectTypes> ObjectMap;
 
 public:
+    TypeMapContainer() : m_version(Detail::NextContainerGeneration()) { }
+
+    // changes whenever an object is added to or removed from the container
+    uint64 version() const { return m_version; }
+
     template <typename SpecificType>
     std::size_t count() const
     {
@@ -122,7 +136,7 @@ public:
     void insert(SpecificType *obj)
     {
         auto &m = Detail::mapForType<SpecificType>(m_objectMap);
-        obj->AddToGrid(m.elements);
+        obj->AddToGrid(m.elements, m_version);
     }
 
     ObjectMap & objectMap() { return m_objectMap; }
@@ -131,6 +145,7 @@ public:
 
 private:
     ObjectMap m_objectMap;
+    uint64 m_version;
 };
 
 } // namespace Trinity
@@ -50,10 +50,21 @@ void VisitorHelper(Visitor &v, ContainerMapList<TypeList<Head, Tail>> &c)
     VisitorHelper(v, c.tail);
 }
 
+// visitors defining BeginContainer get the whole container before its elements
+template <typename Visitor, typename ObjectTypes>
+auto BeginContainerHelper(Visitor &v, TypeMapContainer<ObjectTypes> &c, int) -> decltype(v.BeginContainer(c), void())
+{
+    v.BeginContainer(c);
+}
+
+template <typename Visitor, typename ObjectTypes>
+void BeginContainerHelper(Visitor &/*v*/, TypeMapContainer<ObjectTypes> &/*c*/, long) { }
+
 // for TypeMapContainer
 template <typename Visitor, typename ObjectTypes>
 void VisitorHelper(Visitor &v, TypeMapContainer<ObjectTypes> &c)
 {
+    BeginContainerHelper(v, c, 0);
     VisitorHelper(v, c.objectMap());
 }
 
@@ -21,8 +21,9 @@
 #include "MessageBuffer.h"
 #include "Log.h"
 #include <atomic>
-#include <queue>
+#include <deque>
 #include <memory>
+#include <vector>
 #include <functional>
 #include <type_traits>
 #include <boost/asio/ip/tcp.hpp>
@@ -30,6 +31,9 @@
 using boost::asio::ip::tcp;
 
 #define READ_BLOCK_SIZE 4096
+#define MAX_GATHER_BUFFERS 64                               // buffers passed to a single gather write
+#define MAX_FREE_WRITE_BUFFERS 4                            // written buffers kept for reuse per socket
+#define MAX_FREE_WRITE_BUFFER_SIZE 65536                    // bigger buffers are freed
 #ifdef BOOST_ASIO_HAS_IOCP
 #define TC_SOCKET_USE_IOCP
 #endif
@@ -61,6 +65,16 @@ using boost::asio::ip::tcp;
 
             tcp::socket::endpoint_type remote_endpoint() const;
 */
+// Write counters of all sockets of one type, a flush is one pass over the write queue
+struct SocketWriteStats
+{
+    SocketWriteStats() : Flushes(0), Syscalls(0), Bytes(0) { }
+
+    std::atomic<uint64> Flushes;
+    std::atomic<uint64> Syscalls;
+    std::atomic<uint64> Bytes;
+};
+
 template<class T, class Stream = tcp::socket>
 class Socket : public std::enable_shared_from_this<T>
 {
@@ -89,6 +103,9 @@ public:
         if (_isWritingAsync || (_writeQueue.empty() && !_closing))
             return true;
 
+        if (!_writeQueue.empty())
+            WriteStats.Flushes.fetch_add(1, std::memory_order_relaxed);
+
         for (; HandleQueue();)
             ;
 #endif
@@ -130,13 +147,33 @@ public:
 
     void QueuePacket(MessageBuffer&& buffer)
     {
-        _writeQueue.push(std::move(buffer));
+        _writeQueue.push_back(std::move(buffer));
 
 #ifdef TC_SOCKET_USE_IOCP
+        WriteStats.Flushes.fetch_add(1, std::memory_order_relaxed);
         AsyncProcessQueue();
 #endif
     }
 
+    /// Empty buffer with at least size bytes, recycled from already written messages when possible
+    MessageBuffer AcquireWriteBuffer(std::size_t size)
+    {
+        MessageBuffer buffer(0);
+        if (!_freeWriteBuffers.empty())
+        {
+            buffer = std::move(_freeWriteBuffers.back());
+            _freeWriteBuffers.pop_back();
+            buffer.Reset();
+        }
+
+        if (buffer.GetBufferSize() < size)
+            buffer.Resize(size);
+
+        return buffer;
+    }
+
+    static SocketWriteStats WriteStats;
+
     bool IsOpen() const { return !_closed && !_closing; }
 
     void CloseSocket()
@@ -159,7 +196,7 @@ public:
     MessageBuffer& GetReadBuffer() { return _readBuffer; }
 
     MessageBuffer _readBuffer;
-    std::queue<MessageBuffer> _writeQueue;
+    std::deque<MessageBuffer> _writeQueue;
 
 protected:
     virtual void OnClose() { }
@@ -174,9 +211,9 @@ protected:
         _isWritingAsync = true;
 
 #ifdef TC_SOCKET_USE_IOCP
-        MessageBuffer& buffer = _writeQueue.front();
-        _socket.async_write_some(boost::asio::buffer(buffer.GetReadPointer(), buffer.GetActiveSize()), std::bind(&Socket<T, Stream>::WriteHandler,
+        _socket.async_write_some(GatherWriteQueue(), std::bind(&Socket<T, Stream>::WriteHandler,
             this->shared_from_this(), std::placeholders::_1, std::placeholders::_2));
+        WriteStats.Syscalls.fetch_add(1, std::memory_order_relaxed);
 #else
         _socket.async_write_some(boost::asio::null_buffers(), std::bind(&Socket<T, Stream>::WriteHandlerWrapper,
             this->shared_from_this(), std::placeholders::_1, std::placeholders::_2));
@@ -197,6 +234,43 @@ protected:
     }
 
 private:
+    /// Buffer sequence of the queued messages, written with one writev/WSASend
+    std::vector<boost::asio::const_buffer> const& GatherWriteQueue()
+    {
+        _gatherBuffers.clear();
+        for (auto itr = _writeQueue.begin(); itr != _writeQueue.end() && _gatherBuffers.size() < MAX_GATHER_BUFFERS; ++itr)
+            _gatherBuffers.emplace_back(itr->GetReadPointer(), itr->GetActiveSize());
+
+        return _gatherBuffers;
+    }
+
+    /// Consumes written bytes from the front of the write queue, finished buffers are kept for AcquireWriteBuffer
+    void WriteCompleted(std::size_t bytes)
+    {
+        WriteStats.Bytes.fetch_add(bytes, std::memory_order_relaxed);
+
+        while (bytes && !_writeQueue.empty())
+        {
+            MessageBuffer& buffer = _writeQueue.front();
+            if (bytes < buffer.GetActiveSize())
+            {
+                buffer.ReadCompleted(bytes);
+                return;
+            }
+
+            bytes -= buffer.GetActiveSize();
+            PopWriteQueue();
+        }
+    }
+
+    void PopWriteQueue()
+    {
+        if (_freeWriteBuffers.size() < MAX_FREE_WRITE_BUFFERS && _writeQueue.front().GetBufferSize() <= MAX_FREE_WRITE_BUFFER_SIZE)
+            _freeWriteBuffers.push_back(std::move(_writeQueue.front()));
+
+        _writeQueue.pop_front();
+    }
+
     void ReadHandlerInternal(boost::system::error_code error, size_t transferredBytes)
     {
         if (error)
@@ -216,9 +290,7 @@ private:
         if (!error)
         {
             _isWritingAsync = false;
-            _writeQueue.front().ReadCompleted(transferedBytes);
-            if (!_writeQueue.front().GetActiveSize())
-                _writeQueue.pop();
+            WriteCompleted(transferedBytes);
 
             if (!_writeQueue.empty())
                 AsyncProcessQueue();
@@ -242,37 +314,36 @@ private:
         if (_writeQueue.empty())
             return false;
 
-        MessageBuffer& queuedMessage = _writeQueue.front();
-
-        std::size_t bytesToSend = queuedMessage.GetActiveSize();
+        std::vector<boost::asio::const_buffer> const& buffers = GatherWriteQueue();
+        std::size_t bytesToSend = boost::asio::buffer_size(buffers);
 
         boost::system::error_code error;
-        std::size_t bytesSent = _socket.write_some(boost::asio::buffer(queuedMessage.GetReadPointer(), bytesToSend), error);
+        std::size_t bytesSent = _socket.write_some(buffers, error);
+        WriteStats.Syscalls.fetch_add(1, std::memory_order_relaxed);
 
         if (error)
         {
             if (error == boost::asio::error::would_block || error == boost::asio::error::try_again)
                 return AsyncProcessQueue();
 
-            _writeQueue.pop();
+            PopWriteQueue();
             if (_closing && _writeQueue.empty())
                 CloseSocket();
             return false;
         }
         else if (bytesSent == 0)
         {
-            _writeQueue.pop();
+            PopWriteQueue();
             if (_closing && _writeQueue.empty())
                 CloseSocket();
             return false;
         }
-        else if (bytesSent < bytesToSend) // now n > 0
-        {
-            queuedMessage.ReadCompleted(bytesSent);
+
+        WriteCompleted(bytesSent);
+
+        if (bytesSent < bytesToSend) // now n > 0
             return AsyncProcessQueue();
-        }
 
-        _writeQueue.pop();
         if (_closing && _writeQueue.empty())
             CloseSocket();
         return !_writeQueue.empty();
@@ -289,6 +360,12 @@ private:
     std::atomic<bool> _closing;
 
     bool _isWritingAsync;
+
+    std::vector<MessageBuffer> _freeWriteBuffers;
+    std::vector<boost::asio::const_buffer> _gatherBuffers;
 };
 
+template<class T, class Stream>
+SocketWriteStats Socket<T, Stream>::WriteStats;
+
 #endif // __SOCKET_H__
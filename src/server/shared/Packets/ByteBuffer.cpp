@@ -517,6 +517,11 @@ void ByteBuffer::reserve(size_t ressize)
         _storage.reserve(ressize);
 }
 
+size_t ByteBuffer::capacity() const
+{
+    return _storage.capacity();
+}
+
 void ByteBuffer::append(const char* src, size_t cnt)
 {
     return append(reinterpret_cast<const uint8 *>(src), cnt);
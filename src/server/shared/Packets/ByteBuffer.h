@@ -150,6 +150,7 @@ public:
     bool empty() const;
     void resize(size_t newsize);
     void reserve(size_t ressize);
+    size_t capacity() const;
 
     void append(const char* src, size_t cnt);
     void append(const uint8 *src, size_t cnt);
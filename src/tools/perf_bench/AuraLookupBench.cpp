@@ -0,0 +1,82 @@
+/*
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "AppliedAuraFilter.h"
+#include "PerfBench.h"
+
+#include <map>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace
+{
+    // stands in for AuraApplication, only the node layout of the multimap matters here
+    struct Application
+    {
+        uint32 SpellId;
+        uint8 EffMask;
+    };
+
+    typedef std::multimap<uint32, std::shared_ptr<Application>> ApplicationMap;
+
+    uint32 CountLookup(ApplicationMap const& applications, uint32 spellId)
+    {
+        uint32 count = 0;
+        for (ApplicationMap::const_iterator itr = applications.lower_bound(spellId); itr != applications.upper_bound(spellId); ++itr)
+            count += itr->second->EffMask;
+        return count;
+    }
+}
+
+// Unit::GetAuraCount and friends on a raid boss or player with 120 auras, 90% of the asked spells are missing
+void RunAuraLookupBench()
+{
+    std::mt19937 rng(10);
+    std::uniform_int_distribution<uint32> spellIds(1, 250000);
+
+    ApplicationMap applications;
+    AppliedAuraFilter filter;
+    std::vector<uint32> applied;
+    for (uint32 i = 0; i < 120; ++i)
+    {
+        uint32 spellId = spellIds(rng);
+        filter.Add(spellId);
+        applications.insert(std::make_pair(spellId, std::make_shared<Application>(Application{ spellId, 1 })));
+        applied.push_back(spellId);
+    }
+
+    std::vector<uint32> lookups(100000);
+    for (std::size_t i = 0; i < lookups.size(); ++i)
+        lookups[i] = i % 10 == 0 ? applied[rng() % applied.size()] : spellIds(rng);
+
+    uint64 found = 0;
+    double ns = PerfBench::Measure(lookups.size(), [&]
+    {
+        found = 0;
+        for (uint32 spellId : lookups)
+            found += CountLookup(applications, spellId);
+    });
+    PerfBench::Report("auralookup", "multimap", ns, found);
+
+    ns = PerfBench::Measure(lookups.size(), [&]
+    {
+        found = 0;
+        for (uint32 spellId : lookups)
+            if (filter.MayContain(spellId))
+                found += CountLookup(applications, spellId);
+    });
+    PerfBench::Report("auralookup", "filter + multimap", ns, found);
+}
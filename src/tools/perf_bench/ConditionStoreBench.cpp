@@ -0,0 +1,186 @@
+/*
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ConditionDefines.h"
+#include "PerfBench.h"
+
+#include <list>
+#include <map>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+    // stands in for Condition, the stores only hold pointers
+    struct Condition
+    {
+        uint32 ElseGroup;
+    };
+
+    // the nested stores ConditionMgr kept before the flat ConditionStore
+    typedef std::list<Condition*> OldConditionList;
+    typedef std::map<uint32, OldConditionList> ConditionTypeContainer;
+
+    struct NestedStores
+    {
+        std::map<ConditionSourceType, ConditionTypeContainer> ConditionStore;
+        std::map<std::pair<int32, uint32>, ConditionTypeContainer> SmartEventConditionStore;
+        std::map<ConditionSourceType, std::map<uint32, ConditionTypeContainer>> PairStores;    // vehicle spell, spell click, vendor, ... one map each
+
+        static bool IsPairStore(ConditionSourceType sourceType)
+        {
+            switch (sourceType)
+            {
+                case CONDITION_SOURCE_TYPE_SPELL_CLICK_EVENT:
+                case CONDITION_SOURCE_TYPE_VEHICLE_SPELL:
+                case CONDITION_SOURCE_TYPE_NPC_VENDOR:
+                case CONDITION_SOURCE_TYPE_PHASE_DEFINITION:
+                case CONDITION_SOURCE_TYPE_AREATRIGGER_ACTION:
+                case CONDITION_SOURCE_TYPE_LOOT_ITEM:
+                    return true;
+                default:
+                    return false;
+            }
+        }
+
+        OldConditionList& Add(ConditionStoreKey const& key)
+        {
+            if (key.SourceType == CONDITION_SOURCE_TYPE_SMART_EVENT)
+                return SmartEventConditionStore[std::make_pair(key.SourceEntry, key.SourceId)][key.SourceGroup];
+            if (IsPairStore(key.SourceType))
+                return PairStores[key.SourceType][key.SourceGroup][uint32(key.SourceEntry)];
+            return ConditionStore[key.SourceType][uint32(key.SourceEntry)];
+        }
+
+        OldConditionList* Find(ConditionStoreKey const& key)
+        {
+            ConditionTypeContainer* entries = nullptr;
+            uint32 entry = uint32(key.SourceEntry);
+            if (key.SourceType == CONDITION_SOURCE_TYPE_SMART_EVENT)
+            {
+                auto itr = SmartEventConditionStore.find(std::make_pair(key.SourceEntry, key.SourceId));
+                if (itr != SmartEventConditionStore.end())
+                    entries = &itr->second;
+                entry = key.SourceGroup;
+            }
+            else if (IsPairStore(key.SourceType))
+            {
+                auto itrStore = PairStores.find(key.SourceType);
+                if (itrStore == PairStores.end())
+                    return nullptr;
+
+                auto itr = itrStore->second.find(key.SourceGroup);
+                if (itr != itrStore->second.end())
+                    entries = &itr->second;
+            }
+            else
+            {
+                auto itr = ConditionStore.find(key.SourceType);
+                if (itr != ConditionStore.end())
+                    entries = &itr->second;
+            }
+
+            if (!entries)
+                return nullptr;
+
+            auto itr = entries->find(entry);
+            return itr != entries->end() ? &itr->second : nullptr;
+        }
+
+        // the old getters returned the list by value
+        OldConditionList Get(ConditionStoreKey const& key)
+        {
+            OldConditionList conditions;
+            if (OldConditionList* found = Find(key))
+                conditions = *found;
+            return conditions;
+        }
+    };
+
+    ConditionStoreKey MakeKey(std::mt19937& rng)
+    {
+        static ConditionSourceType const notGrouped[] = { CONDITION_SOURCE_TYPE_SPELL, CONDITION_SOURCE_TYPE_QUEST_ACCEPT, CONDITION_SOURCE_TYPE_QUEST_SHOW_MARK, CONDITION_SOURCE_TYPE_SPELL_PROC };
+        static ConditionSourceType const pairs[] = { CONDITION_SOURCE_TYPE_SPELL_CLICK_EVENT, CONDITION_SOURCE_TYPE_VEHICLE_SPELL, CONDITION_SOURCE_TYPE_NPC_VENDOR,
+            CONDITION_SOURCE_TYPE_PHASE_DEFINITION, CONDITION_SOURCE_TYPE_AREATRIGGER_ACTION, CONDITION_SOURCE_TYPE_LOOT_ITEM };
+
+        uint32 kind = rng() % 10;
+        if (kind < 5)
+            return ConditionStoreKey(notGrouped[rng() % 4], 0, int32(rng() % 250000));
+        if (kind < 7)
+            return ConditionStoreKey(CONDITION_SOURCE_TYPE_SMART_EVENT, rng() % 20 + 1, int32(rng() % 150000), rng() % 3);
+        return ConditionStoreKey(pairs[rng() % 6], rng() % 150000, int32(rng() % 150000));
+    }
+}
+
+// ConditionMgr::GetConditionsFor* on 20k condition lists, 80% of the looked up keys have no conditions
+void RunConditionStoreBench()
+{
+    std::mt19937 rng(16);
+
+    std::vector<Condition> conditions(40000);
+    NestedStores nested;
+    std::unordered_map<ConditionStoreKey, std::vector<Condition*>, ConditionStoreKeyHash> flat;
+    std::vector<ConditionStoreKey> stored;
+    for (uint32 i = 0; i < 20000; ++i)
+    {
+        ConditionStoreKey key = MakeKey(rng);
+        stored.push_back(key);
+
+        // one or two conditions per list
+        for (uint32 j = 0; j < 1 + i % 2; ++j)
+        {
+            Condition* condition = &conditions[i * 2 + j];
+            flat[key].push_back(condition);
+            nested.Add(key).push_back(condition);
+        }
+    }
+
+    std::vector<ConditionStoreKey> lookups;
+    lookups.reserve(200000);
+    for (uint32 i = 0; i < 200000; ++i)
+        lookups.push_back(i % 5 == 0 ? stored[rng() % stored.size()] : MakeKey(rng));
+
+    std::vector<Condition*> const empty;
+    uint64 found = 0;
+    double ns = PerfBench::Measure(lookups.size(), [&]
+    {
+        found = 0;
+        for (ConditionStoreKey const& key : lookups)
+            found += nested.Get(key).size();
+    });
+    PerfBench::Report("conditions", "nested maps, list copy", ns, found);
+
+    ns = PerfBench::Measure(lookups.size(), [&]
+    {
+        found = 0;
+        for (ConditionStoreKey const& key : lookups)
+            if (OldConditionList const* list = nested.Find(key))
+                found += list->size();
+    });
+    PerfBench::Report("conditions", "nested maps", ns, found);
+
+    ns = PerfBench::Measure(lookups.size(), [&]
+    {
+        found = 0;
+        for (ConditionStoreKey const& key : lookups)
+        {
+            auto itr = flat.find(key);
+            std::vector<Condition*> const& list = itr != flat.end() ? itr->second : empty;
+            found += list.size();
+        }
+    });
+    PerfBench::Report("conditions", "flat ConditionStore", ns, found);
+}
@@ -0,0 +1,220 @@
+/*
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "LFGCombinationKey.h"
+#include "PerfBench.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <map>
+#include <random>
+#include <set>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace lfg;
+
+namespace
+{
+    // stands in for ObjectGuid, printed the same way as its operator<<
+    struct Guid
+    {
+        uint64 High;
+        uint64 Low;
+
+        bool operator<(Guid const& right) const { return High != right.High ? High < right.High : Low < right.Low; }
+    };
+
+    std::ostream& operator<<(std::ostream& stream, Guid const& guid)
+    {
+        std::ostringstream tmp;
+        tmp << std::hex << std::setw(16) << std::setfill('0') << guid.High << std::setw(16) << std::setfill('0') << guid.Low;
+        stream << tmp.str();
+        return stream;
+    }
+
+    typedef std::vector<Guid> Combination;
+
+    // the cache key before the numeric ids, see ConcatenateGuids
+    std::string ConcatenateGuids(Combination const& check)
+    {
+        std::set<Guid> guids(check.begin(), check.end());
+
+        std::ostringstream o;
+        std::set<Guid>::const_iterator it = guids.begin();
+        o << *it;
+        for (++it; it != guids.end(); ++it)
+            o << '|' << *it;
+
+        return o.str();
+    }
+
+    struct Queue
+    {
+        std::vector<Guid> Entries;                          // entry id - 1 -> guid
+        std::map<Guid, uint32> Ids;                         // LFGQueue::QueueDataStore
+        std::vector<Combination> Combinations;              // cached by FindGroups
+    };
+
+    // 10k queued entries spread over 40 dungeons, each cached against 8 earlier entries of its dungeon as pairs and 4 as triples
+    Queue BuildQueue(std::mt19937& rng)
+    {
+        Queue queue;
+        std::vector<std::vector<Guid>> dungeons(40);
+        for (uint32 i = 0; i < 10000; ++i)
+        {
+            Guid guid = { 0x0800000000000000ULL | (uint64(rng()) << 16), 0x0000000100000000ULL | i };
+            queue.Entries.push_back(guid);
+            queue.Ids[guid] = i + 1;
+
+            std::vector<Guid>& dungeon = dungeons[rng() % dungeons.size()];
+            if (dungeon.size() >= 2)
+            {
+                for (uint32 j = 0; j < 8; ++j)
+                    queue.Combinations.push_back({ guid, dungeon[rng() % dungeon.size()] });
+
+                for (uint32 j = 0; j < 4; ++j)
+                {
+                    std::size_t first = rng() % dungeon.size();
+                    std::size_t second = (first + 1 + rng() % (dungeon.size() - 1)) % dungeon.size();
+                    queue.Combinations.push_back({ guid, dungeon[first], dungeon[second] });
+                }
+            }
+            dungeon.push_back(guid);
+        }
+
+        // duplicate pairs would only be cached once
+        std::set<std::string> seen;
+        queue.Combinations.erase(std::remove_if(queue.Combinations.begin(), queue.Combinations.end(), [&](Combination const& combination)
+        {
+            return !seen.insert(ConcatenateGuids(combination)).second;
+        }), queue.Combinations.end());
+        return queue;
+    }
+
+    // LFGQueue::GetCombinationKey
+    LfgCombinationKey GetCombinationKey(Queue const& queue, Combination const& check)
+    {
+        LfgCombinationKey key;
+        for (Guid const& guid : check)
+        {
+            std::map<Guid, uint32>::const_iterator itr = queue.Ids.find(guid);
+            if (itr == queue.Ids.end() || key.Contains(itr->second))
+                return LfgCombinationKey();
+
+            key.Add(itr->second);
+        }
+        return key;
+    }
+}
+
+// LFGQueue compatibility cache of a 10k entry queue: key lookups and entries leaving, string keys against numeric keys
+void RunLfgQueueBench()
+{
+    std::mt19937 rng(17);
+    Queue queue = BuildQueue(rng);
+
+    std::unordered_map<std::string, uint8> stringCache;
+    std::unordered_map<LfgCombinationKey, uint8, LfgCombinationKeyHash> keyCache;
+    std::unordered_map<uint32, std::vector<LfgCombinationKey>> keyIndex;
+    for (Combination const& combination : queue.Combinations)
+    {
+        stringCache[ConcatenateGuids(combination)] = uint8(combination.size());
+
+        LfgCombinationKey key = GetCombinationKey(queue, combination);
+        keyCache[key] = uint8(combination.size());
+        for (uint8 i = 0; i < key.size; ++i)
+            keyIndex[key.ids[i]].push_back(key);
+    }
+
+    std::vector<Combination> lookups(queue.Combinations);
+    std::shuffle(lookups.begin(), lookups.end(), rng);
+
+    uint64 found = 0;
+    double ns = PerfBench::Measure(lookups.size(), [&]
+    {
+        found = 0;
+        for (Combination const& combination : lookups)
+        {
+            auto itr = stringCache.find(ConcatenateGuids(combination));
+            if (itr != stringCache.end())
+                found += itr->second;
+        }
+    });
+    PerfBench::Report("lfgqueue", "lookup, guid string key", ns, found);
+
+    ns = PerfBench::Measure(lookups.size(), [&]
+    {
+        found = 0;
+        for (Combination const& combination : lookups)
+        {
+            auto itr = keyCache.find(GetCombinationKey(queue, combination));
+            if (itr != keyCache.end())
+                found += itr->second;
+        }
+    });
+    PerfBench::Report("lfgqueue", "lookup, numeric key", ns, found);
+
+    // every run drops the combinations of its own 20 leaving entries
+    uint32 const leavesPerRun = 20;
+    std::vector<uint32> leaving(leavesPerRun * PerfBench::Runs);
+    for (std::size_t i = 0; i < leaving.size(); ++i)
+        leaving[i] = uint32(i * (queue.Entries.size() / leaving.size()));
+
+    uint64 removed = 0;
+    uint32 run = 0;
+    ns = PerfBench::Measure(leavesPerRun, [&]
+    {
+        for (uint32 i = 0; i < leavesPerRun; ++i)
+        {
+            std::ostringstream out;
+            out << queue.Entries[leaving[run * leavesPerRun + i]];
+            std::string strGuid = out.str();
+
+            for (auto itr = stringCache.begin(); itr != stringCache.end();)
+            {
+                if (itr->first.find(strGuid) != std::string::npos)
+                {
+                    itr = stringCache.erase(itr);
+                    ++removed;
+                }
+                else
+                    ++itr;
+            }
+        }
+        ++run;
+    });
+    PerfBench::Report("lfgqueue", "leave, substring scan", ns, removed);
+
+    removed = 0;
+    run = 0;
+    ns = PerfBench::Measure(leavesPerRun, [&]
+    {
+        for (uint32 i = 0; i < leavesPerRun; ++i)
+        {
+            auto itIndex = keyIndex.find(leaving[run * leavesPerRun + i] + 1);
+            if (itIndex == keyIndex.end())
+                continue;
+
+            for (LfgCombinationKey const& key : itIndex->second)
+                removed += keyCache.erase(key);
+            keyIndex.erase(itIndex);
+        }
+        ++run;
+    });
+    PerfBench::Report("lfgqueue", "leave, per entry index", ns, removed);
+}
@@ -0,0 +1,75 @@
+/*
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "PerfBench.h"
+
+#include <cstdio>
+#include <cstring>
+
+void PerfBench::Report(char const* bench, char const* variant, double nsPerOp, uint64 checksum)
+{
+    printf("%-12s %-24s %12.1f ns/op  checksum " UI64FMTD "\n", bench, variant, nsPerOp, checksum);
+}
+
+namespace
+{
+    struct BenchDefinition
+    {
+        char const* Name;
+        char const* Description;
+        void(*Run)();
+    };
+
+    BenchDefinition const Benches[] =
+    {
+        { "wordfilter", "WordFilterMatcher against one find per bad word, 2000 words",    &RunWordFilterBench },
+        { "updatemask", "Values update mask of a unit and a player with 8 changed fields", &RunUpdateMaskBench },
+        { "auralookup", "Spell id lookups on 120 applied auras with and without AppliedAuraFilter", &RunAuraLookupBench },
+        { "lfgqueue",   "LFG compatibility cache of a 10k entry queue, string against numeric keys", &RunLfgQueueBench },
+        { "conditions", "ConditionMgr lookups on 20k condition lists, flat store against nested maps", &RunConditionStoreBench },
+    };
+}
+
+int main(int argc, char** argv)
+{
+    if (argc > 1 && !strcmp(argv[1], "--list"))
+    {
+        for (BenchDefinition const& bench : Benches)
+            printf("%-12s %s\n", bench.Name, bench.Description);
+        return 0;
+    }
+
+    int ran = 0;
+    for (BenchDefinition const& bench : Benches)
+    {
+        bool selected = argc <= 1;
+        for (int i = 1; i < argc && !selected; ++i)
+            selected = !strcmp(argv[i], bench.Name);
+
+        if (!selected)
+            continue;
+
+        bench.Run();
+        ++ran;
+    }
+
+    if (!ran)
+    {
+        printf("Usage: %s [--list] [bench...]\n", argv[0]);
+        return 1;
+    }
+
+    return 0;
+}
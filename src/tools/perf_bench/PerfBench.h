@@ -0,0 +1,56 @@
+/*
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PERF_BENCH_H
+#define PERF_BENCH_H
+
+#include "Define.h"
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
+
+namespace PerfBench
+{
+    uint32 const Runs = 5;
+
+    // Best of Runs calls of fn, in nanoseconds per operation
+    template<class Fn>
+    double Measure(uint64 operations, Fn&& fn)
+    {
+        double best = std::numeric_limits<double>::max();
+        for (uint32 i = 0; i < Runs; ++i)
+        {
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            fn();
+            std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+            best = std::min(best, elapsed.count() / operations);
+        }
+
+        return best;
+    }
+
+    // checksum keeps the work alive and lets the variants of a bench be compared
+    void Report(char const* bench, char const* variant, double nsPerOp, uint64 checksum);
+}
+
+// one per benchmarked subsystem, each builds its own synthetic data
+void RunWordFilterBench();
+void RunAuraLookupBench();
+void RunUpdateMaskBench();
+void RunLfgQueueBench();
+void RunConditionStoreBench();
+
+#endif
@@ -0,0 +1,97 @@
+/*
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "PerfBench.h"
+#include "UpdateMask.h"
+
+#include <bit>
+#include <random>
+#include <string>
+
+namespace
+{
+    uint32 const FieldVisibleFlag = 0x01;                   // UF_FLAG_PUBLIC, the mask other players get
+
+    uint64 CountBits(std::vector<uint8> const& mask)
+    {
+        uint64 count = 0;
+        for (uint8 byte : mask)
+            count += std::popcount(byte);
+        return count;
+    }
+
+    void RunFieldCount(char const* name, uint32 fieldCount, std::mt19937& rng)
+    {
+        std::vector<uint32> flags(fieldCount);
+        for (uint32& flag : flags)
+            flag = 1 << (rng() % 4);
+
+        std::vector<uint32> changedFields;
+        for (uint32 i = 0; i < 8; ++i)
+            changedFields.push_back(rng() % fieldCount);
+
+        std::vector<uint8> mask((fieldCount + UpdateMask::BITS_PER_BLOCK - 1) / UpdateMask::BITS_PER_BLOCK * sizeof(UpdateMask::BlockType));
+        uint32 const iterations = 200000;
+        uint64 bits = 0;
+
+        // the per field loop of Object::BuildValuesUpdate before the packed mask
+        std::vector<uint8> changes(fieldCount);
+        double ns = PerfBench::Measure(iterations, [&]
+        {
+            bits = 0;
+            for (uint32 i = 0; i < iterations; ++i)
+            {
+                for (uint32 field : changedFields)
+                    changes[field] = 1;
+
+                memset(mask.data(), 0, mask.size());
+                for (uint32 index = 0; index < fieldCount; ++index)
+                    if (changes[index] && flags[index] & FieldVisibleFlag)
+                        mask[index / 8] |= uint8(1 << (index % 8));
+
+                memset(changes.data(), 0, changes.size());
+                bits += CountBits(mask);
+            }
+        });
+        PerfBench::Report("updatemask", (std::string(name) + " per field").c_str(), ns, bits);
+
+        UpdateMask::ChangesMask changesMask;
+        changesMask.Resize(fieldCount);
+        ns = PerfBench::Measure(iterations, [&]
+        {
+            bits = 0;
+            for (uint32 i = 0; i < iterations; ++i)
+            {
+                for (uint32 field : changedFields)
+                    changesMask.Set(field);
+
+                memset(mask.data(), 0, mask.size());
+                changesMask.BuildFieldMask(flags.data(), fieldCount, FieldVisibleFlag, 0, mask.data());
+
+                changesMask.Reset();
+                bits += CountBits(mask);
+            }
+        });
+        PerfBench::Report("updatemask", (std::string(name) + " packed").c_str(), ns, bits);
+    }
+}
+
+// Field counts of UNIT_END and PLAYER_FIELD_END, random visibility flags
+void RunUpdateMaskBench()
+{
+    std::mt19937 rng(5);
+    RunFieldCount("unit", 0x0D5, rng);
+    RunFieldCount("player", 0x1211, rng);
+}
@@ -0,0 +1,91 @@
+/*
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "PerfBench.h"
+#include "WordFilterMatcher.h"
+
+#include <random>
+
+namespace
+{
+    std::wstring RandomLetters(std::mt19937& rng, uint32 minLength, uint32 maxLength)
+    {
+        std::uniform_int_distribution<uint32> length(minLength, maxLength);
+        std::uniform_int_distribution<int> letter(L'a', L'z');
+
+        std::wstring text(length(rng), L' ');
+        for (wchar_t& c : text)
+            c = wchar_t(letter(rng));
+        return text;
+    }
+}
+
+// Text as GeneralFilterWstring leaves it: lowered letters only. Every 50th line contains a bad word.
+void RunWordFilterBench()
+{
+    std::mt19937 rng(20);
+
+    std::set<std::wstring> words;
+    while (words.size() < 2000)
+        words.insert(RandomLetters(rng, 5, 10));
+
+    std::vector<std::wstring> lines(10000);
+    for (std::size_t i = 0; i < lines.size(); ++i)
+    {
+        lines[i] = RandomLetters(rng, 20, 120);
+        if (i % 50 == 0)
+        {
+            auto word = words.begin();
+            std::advance(word, rng() % words.size());
+            lines[i].insert(rng() % lines[i].size(), *word);
+        }
+    }
+
+    uint64 hits = 0;
+    double ns = PerfBench::Measure(1, [&]
+    {
+        WordFilterMatcher matcher(words);
+        hits = matcher.Empty() ? 0 : 1;
+    });
+    PerfBench::Report("wordfilter", "matcher build", ns, hits);
+
+    WordFilterMatcher matcher(words);
+    ns = PerfBench::Measure(lines.size(), [&]
+    {
+        hits = 0;
+        for (std::wstring const& line : lines)
+            if (matcher.Find(line))
+                ++hits;
+    });
+    PerfBench::Report("wordfilter", "matcher per line", ns, hits);
+
+    // the loop FindBadWord used before the matcher
+    ns = PerfBench::Measure(lines.size(), [&]
+    {
+        hits = 0;
+        for (std::wstring const& line : lines)
+        {
+            for (std::wstring const& word : words)
+            {
+                if (line.find(word) != std::wstring::npos)
+                {
+                    ++hits;
+                    break;
+                }
+            }
+        }
+    });
+    PerfBench::Report("wordfilter", "find per word per line", ns, hits);
+}